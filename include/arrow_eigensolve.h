@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+/**
+   @file arrow_eigensolve.h
+
+   @section Description
+
+   Structured eigensolver for the Hermitian restart matrices that
+   arise in the (block) thick restarted Lanczos methods.  These have
+   the form
+
+       A = [ diag(d)  R^dag ]
+           [ R        T     ]
+
+   where diag(d) holds the n_arrow locked/kept Ritz values, T is a
+   block tridiagonal matrix with block size b, and the arrow R couples
+   diag(d) to the first block row of T only.
+
+   The eigendecomposition is computed by divide and conquer: T is
+   recursively torn into block tridiagonal halves, which are merged
+   through a sequence of rank-one updates of a diagonal matrix, each
+   solved through the secular equation with deflation (Cuppen, Gu and
+   Eisenstat).  The arrow is merged in the same way.  The eigenvector
+   matrix of each rank-one update is never formed explicitly, so the
+   eigenvalues and the trailing rows of the eigenvectors (which give
+   the Ritz residua) cost O(n^2), and only the eigenvectors that are
+   actually requested are assembled, at a cost O(n^2) per vector.
+   The secular solves and vector assembly are distributed over the
+   host thread pool.
+ */
+
+namespace quda
+{
+
+  template <typename T> class ArrowEigensolver
+  {
+    struct node_t;
+    std::unique_ptr<node_t> root;
+
+    int n = 0;
+    int block = 1;
+    std::vector<double> evals;
+    std::vector<T> last_rows;
+
+  public:
+    ArrowEigensolver();
+    ~ArrowEigensolver();
+
+    /**
+       @brief Compute the eigendecomposition of the arrow matrix
+       @param[in] n_arrow The length of the diagonal part d
+       @param[in] block The block size b of the block tridiagonal part T
+       @param[in] d Diagonal part of the arrow (length n_arrow)
+       @param[in] r Arrow coupling R, column major b x n_arrow matrix
+       @param[in] t_diag Diagonal blocks of T, each a column major b x b matrix
+       @param[in] t_sub Sub-diagonal blocks of T, each a column major b x b
+       matrix, where block i couples block row i + 1 to block column i
+    */
+    void compute(int n_arrow, int block, const std::vector<double> &d, const std::vector<T> &r,
+                 const std::vector<T> &t_diag, const std::vector<T> &t_sub);
+
+    /**
+       @return The eigenvalues in ascending order
+    */
+    const std::vector<double> &eigenvalues() const { return evals; }
+
+    /**
+       @brief Return an element from the last b rows of the eigenvector matrix
+       @param[in] row Row index counting from the first of the last b rows
+       @param[in] col Eigenvector index
+       @return Element (n - b + row, col) of the eigenvector matrix
+    */
+    T lastRow(int row, int col) const { return last_rows[col * block + row]; }
+
+    /**
+       @brief Assemble the leading eigenvectors
+       @param[out] q The eigenvectors, stored as a column major n x n_vec matrix
+       @param[in] n_vec The number of eigenvectors to assemble
+    */
+    void eigenvectors(std::vector<T> &q, int n_vec) const;
+  };
+
+} // namespace quda
@@ -49,6 +49,7 @@ namespace quda {
     void axpyBzpcx(double a, ColorSpinorField& x, ColorSpinorField& y, double b, ColorSpinorField& z, double c);
     void axpbypczw(double a, ColorSpinorField &x, double b, ColorSpinorField &y, double c, ColorSpinorField &z,
                    ColorSpinorField &w);
+    void axpbypcz(double a, ColorSpinorField &x, double b, ColorSpinorField &y, double c, ColorSpinorField &z);
 
     void caxpby(const Complex &a, ColorSpinorField &x, const Complex &b, ColorSpinorField &y);
     void caxpy(const Complex &a, ColorSpinorField &x, ColorSpinorField &y);
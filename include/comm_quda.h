@@ -5,6 +5,17 @@
 #include <quda_api.h>
 #include <array.h>
 
+/**
+   With the threaded backend each rank is a thread of the same
+   process, so state that is per-process with the other backends is
+   per-thread instead.
+ */
+#if defined(THREAD_COMMS)
+#define QUDA_COMM_LOCAL thread_local
+#else
+#define QUDA_COMM_LOCAL
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -185,6 +196,26 @@ namespace quda
   */
   int comm_rank_global(void);
 
+#ifdef THREAD_COMMS
+  /**
+     @brief Run a function concurrently on n_rank threads of this
+     process, each of which acts as a distinct rank of the threaded
+     communications backend.  Each thread should initialize and
+     finalize the communicator itself (e.g., with initCommsGridQuda
+     and comm_finalize).  Returns once every rank has returned.
+
+     Only the comms layer is per-rank: the device, tuning and field
+     state are still per-process, so the rank threads may use the
+     comm_* interface (including split communicators) but not
+     initQuda or anything that allocates fields.
+
+     @param[in] n_rank Number of ranks to launch
+     @param[in] fn Function to execute, called as fn(rank, arg)
+     @param[in] arg Opaque argument passed through to fn
+  */
+  void comm_thread_launch(int n_rank, void (*fn)(int rank, void *arg), void *arg);
+#endif
+
   /**
      @return Number of processes
   */
@@ -10,6 +10,7 @@
 #include <csignal>
 
 #include <comm_key.h>
+#include <reproducible_sum.h>
 
 #include <algorithm>
 #include <numeric>
@@ -22,6 +23,25 @@
 #include <qmp.h>
 #endif
 
+#if defined(MPI_COMMS) || defined(QMP_COMMS)
+namespace quda
+{
+  namespace reproducible
+  {
+    /**
+       @brief MPI reduction operator that merges arrays of
+       accumulator_t, used for reproducible global sums
+     */
+    inline void mpi_sum(void *in, void *inout, int *len, MPI_Datatype *)
+    {
+      auto a = static_cast<const accumulator_t *>(in);
+      auto b = static_cast<accumulator_t *>(inout);
+      for (int i = 0; i < *len; i++) b[i].merge(a[i]);
+    }
+  } // namespace reproducible
+} // namespace quda
+#endif
+
 #ifdef QUDA_BACKWARDSCPP
 #include "backward.hpp"
 namespace backward
@@ -142,12 +162,16 @@ namespace quda
     }
   }
 
+#if defined(THREAD_COMMS)
+  struct comm_group_t;
+#endif
+
   struct Communicator {
 
     /**
       The gpuid is static, and it's set when the default communicator is initialized.
     */
-    static int gpuid;
+    static QUDA_COMM_LOCAL int gpuid;
     static int comm_gpuid() { return gpuid; }
 
     /**
@@ -656,6 +680,32 @@ namespace quda
 
 #if defined(QMP_COMMS) || defined(MPI_COMMS)
   MPI_Comm MPI_COMM_HANDLE;
+
+  /**
+     The datatype and operator used for the deterministic reductions,
+     created on first use and freed when the communicator is finalized
+   */
+  MPI_Datatype reproducible_type = MPI_DATATYPE_NULL;
+  MPI_Op reproducible_op = MPI_OP_NULL;
+
+  /**
+     @brief Create the datatype and operator for the deterministic
+     reductions if they do not yet exist
+   */
+  void reproducible_init();
+
+  /**
+     @brief Free the datatype and operator for the deterministic
+     reductions, if they have been created
+   */
+  void reproducible_free();
+#endif
+
+#if defined(THREAD_COMMS)
+  /**
+     The group of rank threads spanned by this communicator
+   */
+  comm_group_t *group = nullptr;
 #endif
 
 #if defined(QMP_COMMS)
@@ -740,12 +790,6 @@ namespace quda
 
   int comm_query(MsgHandle *mh);
 
-  template <typename T> T deterministic_reduce(T *array, int n)
-  {
-    std::sort(array, array + n); // sort reduction into ascending order for deterministic reduction
-    return std::accumulate(array, array + n, 0.0);
-  }
-
   void comm_allreduce_sum_array(double *data, size_t size);
 
   void comm_allreduce_max_array(double *data, size_t size);
@@ -759,6 +803,9 @@ namespace quda
   /**  broadcast from rank 0 */
   void comm_broadcast(void *data, size_t nbytes);
 
+  /**  gather nbytes from each rank onto rank 0, in rank order */
+  void comm_gather(void *recv_buf, const void *send_buf, size_t nbytes);
+
   void comm_barrier(void);
 
   static void comm_abort_(int status);
@@ -773,4 +820,10 @@ void push_communicator(const CommKey &split_key);
 /** @brief These routine broadcast the data according to the default communicator */
 void comm_broadcast_global(void *data, size_t nbytes);
 
+/** @brief These routine gather nbytes from each process onto rank 0 of the default communicator, in rank order */
+void comm_gather_global(void *recv_buf, const void *send_buf, size_t nbytes);
+
+/** @return Number of processes in the default communicator */
+size_t comm_size_global();
+
 } // namespace quda
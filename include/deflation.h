@@ -149,6 +149,23 @@ namespace quda {
      */
     void saveVectors(ColorSpinorField *RV);
 
+    /**
+       @brief Save the full deflation space to vec_outfile: the
+       current vectors, and alongside them in vec_outfile.proj the
+       projection matrix, the inverse Ritz values and the space
+       dimensions, so that a later job can deflate without rebuilding
+       the projection
+     */
+    void saveSpace();
+
+    /**
+       @brief Load a full deflation space saved by saveSpace from
+       vec_infile.  No operator is applied.
+       @return Whether the space was loaded, which requires
+       vec_infile.proj to exist
+     */
+    bool loadSpace();
+
     /**
        @brief Test whether the deflation space is complete
        and therefore cannot be further extended      
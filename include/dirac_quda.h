@@ -8,6 +8,7 @@
 #include <blas_quda.h>
 
 #include <typeinfo>
+#include <memory>
 
 namespace quda {
 
@@ -2594,6 +2595,78 @@ public:
     }
   };
 
+  /**
+     Gloms onto a Hermitian DiracMatrix and applies the scaled
+     Chebyshev polynomial C_n of that matrix, which amplifies the part
+     of the spectrum below a_min and damps the interval [a_min, a_max].
+     It is the polynomial accelerator of the eigensolvers, and can be
+     used wherever a DiracMatrix is expected, e.g., as a polynomial
+     preconditioner.
+
+     Each step of the three-term recurrence is a single operator
+     application followed by one fused update, which accumulates the
+     recurrence in place into the operator output.  The recurrence
+     rotates between the output vector and two temporaries that are
+     kept between applications, and is ordered such that the final
+     term lands in the output vector directly.
+  */
+  class DiracChebyshev : public DiracMatrix
+  {
+
+  protected:
+    const DiracMatrix &mat;
+    int degree;
+    double a_min;
+    double a_max;
+
+    //! Recurrence temporaries, allocated on first use
+    mutable std::unique_ptr<ColorSpinorField> work[2];
+
+    /**
+       @brief Ensure the recurrence temporaries exist and are compatible with the field
+       @param[in] field Field whose geometry the temporaries take on
+       @param[in] n_work The number of temporaries required
+    */
+    void createWork(const ColorSpinorField &field, int n_work) const;
+
+    /**
+       @brief Apply the polynomial
+       @param[out] out The output vector C_n(mat) in
+       @param[in] in The input vector
+       @param[in] matVec Functor that applies mat, with arguments (out, in)
+    */
+    template <typename MatVec> void apply(ColorSpinorField &out, const ColorSpinorField &in, const MatVec &matVec) const;
+
+  public:
+    /**
+       @brief Constructor for the Chebyshev polynomial operator
+       @param[in] mat The Hermitian matrix the polynomial is applied to
+       @param[in] degree The degree n of the polynomial
+       @param[in] a_min Lower end of the interval that is damped
+       @param[in] a_max Upper end of the interval that is damped
+    */
+    DiracChebyshev(const DiracMatrix &mat, int degree, double a_min, double a_max);
+
+    /**
+       @brief Update the degree and interval of the polynomial
+       @param[in] degree The degree n of the polynomial
+       @param[in] a_min Lower end of the interval that is damped
+       @param[in] a_max Upper end of the interval that is damped
+    */
+    void setPolynomial(int degree, double a_min, double a_max);
+
+    void operator()(ColorSpinorField &out, const ColorSpinorField &in) const;
+
+    void operator()(ColorSpinorField &out, const ColorSpinorField &in, ColorSpinorField &tmp) const;
+
+    void operator()(ColorSpinorField &out, const ColorSpinorField &in, ColorSpinorField &Tmp1,
+                    ColorSpinorField &Tmp2) const;
+
+    int getStencilSteps() const { return degree * mat.getStencilSteps(); }
+
+    virtual bool hermitian() const { return mat.hermitian(); }
+  };
+
   /**
    * Create the Dirac operator. By default, we also create operators with possibly different
    * precisions: Sloppy, and Preconditioner.
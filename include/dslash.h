@@ -429,12 +429,24 @@ namespace quda
 
     void augmentAux(KernelType type, const char *extra) { strcat(aux[type], extra); }
 
-    virtual TuneKey tuneKey() const override
+    /**
+       @brief Return the aux string of the kernel type being launched
+     */
+    const char *launchAux() const
     {
-      auto aux_ = (arg.pack_blocks > 0 && (arg.kernel_type == INTERIOR_KERNEL || arg.kernel_type == UBER_KERNEL)) ?
+      return (arg.pack_blocks > 0 && (arg.kernel_type == INTERIOR_KERNEL || arg.kernel_type == UBER_KERNEL)) ?
         aux_pack :
         ((arg.shmem > 0 && arg.kernel_type == EXTERIOR_KERNEL_ALL) ? aux_barrier : aux[arg.kernel_type]);
-      return TuneKey(in.VolString(), typeid(*this).name(), aux_);
+    }
+
+    virtual TuneKey tuneKey() const override { return TuneKey(in.VolString(), typeid(*this).name(), launchAux()); }
+
+    virtual bool tuneKeyParts(const char *&vol_, const char *&name, const char *&aux_) const override
+    {
+      vol_ = in.VolString();
+      name = typeid(*this).name();
+      aux_ = launchAux();
+      return true;
     }
 
     /**
@@ -5,6 +5,7 @@
 #include <timer.h>
 #include <dirac_quda.h>
 #include <color_spinor_field.h>
+#include <arrow_eigensolve.h>
 
 namespace quda
 {
@@ -29,6 +30,7 @@ namespace quda
     int n_ev_deflate; /** Number of converged eigenvalues to use in deflation */
     double tol;       /** Tolerance on eigenvalues */
     bool reverse;     /** True if using polynomial acceleration */
+    bool random_guess; /** True if the initial guess was populated with rands */
     char spectrum[3]; /** Part of the spectrum to be computed */
     bool compute_svd; /** Compute the SVD if requested **/
 
@@ -57,6 +59,9 @@ namespace quda
     ColorSpinorField *tmp1;
     ColorSpinorField *tmp2;
 
+    std::unique_ptr<DiracChebyshev> cheby; /** Chebyshev polynomial operator used for acceleration, rebuilt each solve */
+    const DiracMatrix *cheby_mat;         /** The matrix the Chebyshev operator was created for in this solve */
+
     QudaPrecision save_prec;
 
   public:
@@ -100,11 +105,13 @@ namespace quda
     void prepareInitialGuess(std::vector<ColorSpinorField *> &kSpace);
 
     /**
-       @brief Check for a maximum of the Chebyshev operator
+       @brief Estimate the ends of the Chebyshev interval, a_max and
+       a_min, that have not been set by the user, and discard the
+       Chebyshev operator of any previous solve
        @param[in] mat The problem operator
        @param[in] kSpace The Krylov space vectors
     */
-    void checkChebyOpMax(const DiracMatrix &mat, std::vector<ColorSpinorField *> &kSpace);
+    void checkChebyOpInterval(const DiracMatrix &mat, std::vector<ColorSpinorField *> &kSpace);
 
     /**
        @brief Extend the Krylov space
@@ -157,13 +164,19 @@ namespace quda
     void chebyOp(const DiracMatrix &mat, ColorSpinorField &out, const ColorSpinorField &in);
 
     /**
-       @brief Estimate the spectral radius of the operator for the max value of the
-       Chebyshev polynomial
+       @brief Estimate the spectral interval of the operator for the
+       Chebyshev polynomial from a short Lanczos run.  The upper bound
+       is the largest Ritz value plus its residual norm.  The lower
+       end is placed where the spectral density given by the Lanczos
+       quadrature accounts for n_ev eigenvalues.
        @param[in] mat Matrix operator
-       @param[in] out Output spinor
-       @param[in] in Input spinor
+       @param[in] kSpace The Krylov space vectors, of which kSpace[0]
+       holds the initial guess
+       @param[out] a_min Estimate of the lower end of the interval
+       @param[out] a_max Estimate of the upper bound of the spectrum
     */
-    double estimateChebyOpMax(const DiracMatrix &mat, ColorSpinorField &out, ColorSpinorField &in);
+    void estimateChebyOpInterval(const DiracMatrix &mat, std::vector<ColorSpinorField *> &kSpace, double &a_min,
+                                 double &a_max);
 
     /**
        @brief Orthogonalise input vectors r against
@@ -445,6 +458,9 @@ namespace quda
     // Variable size matrix
     std::vector<double> ritz_mat;
 
+    /** Eigendecomposition of the arrow matrix */
+    ArrowEigensolver<double> arrow_eig;
+
     // Tridiagonal/Arrow matrix, fixed size.
     double *alpha;
     double *beta;
@@ -470,7 +486,9 @@ namespace quda
     void reorder(std::vector<ColorSpinorField *> &kSpace);
 
     /**
-       @brief Get the eigendecomposition from the arrow matrix
+       @brief Get the eigendecomposition from the arrow matrix.  Only
+       the eigenvalues and residua are computed here, the Ritz vectors
+       that are kept are assembled by computeKeptRitz.
     */
     void eigensolveFromArrowMat();
 
@@ -506,6 +524,9 @@ namespace quda
     // Variable size matrix
     std::vector<Complex> block_ritz_mat;
 
+    /** Eigendecomposition of the block arrow matrix */
+    ArrowEigensolver<Complex> block_arrow_eig;
+
     /** Block Tridiagonal/Arrow matrix, fixed size. */
     Complex *block_alpha;
     Complex *block_beta;
@@ -531,7 +552,9 @@ namespace quda
     void blockLanczosStep(std::vector<ColorSpinorField *> v, int j);
 
     /**
-       @brief Get the eigendecomposition from the current block arrow matrix
+       @brief Get the eigendecomposition from the current block arrow
+       matrix.  Only the eigenvalues and residua are computed here, the
+       Ritz vectors that are kept are assembled by computeBlockKeptRitz.
     */
     void eigensolveFromBlockArrowMat();
 
@@ -424,7 +424,7 @@ namespace quda {
     /**
        Compute checksum of this gauge field: this uses a XOR-based checksum method
        @param[in] mini Whether to compute a mini checksum or global checksum.
-       A mini checksum only computes the checksum over a subset of the lattice
+       A mini checksum only computes the checksum over a sample of the lattice
        sites and is to be used for online comparisons, e.g., checking
        a field has changed with a global update algorithm.
        @return checksum value
@@ -829,11 +829,13 @@ namespace quda {
 
   /**
      Compute XOR-based checksum of this gauge field: each gauge field entry is
-     converted to type uint64_t, and compute the cummulative XOR of these values.
+     converted to type uint64_t, and the XOR of these values for each link is
+     mixed with the link's position.  The cummulative XOR of the links is then
+     computed in blocks over the host thread pool.  Only host fields are supported.
      @param[in] mini Whether to compute a mini checksum or global checksum.
-     A mini checksum only computes over a subset of the lattice
-     sites and is to be used for online comparisons, e.g., checking
-     a field has changed with a global update algorithm.
+     A mini checksum only computes over a sample of the lattice
+     sites spread evenly over the volume, and is to be used for online
+     comparisons, e.g., checking a field has changed with a global update algorithm.
      @return checksum value
   */
   uint64_t Checksum(const GaugeField &u, bool mini=false);
@@ -110,6 +110,27 @@ namespace quda
   */
   void WFlowStep(GaugeField &out, GaugeField &temp, GaugeField &in, double epsilon, QudaGaugeSmearType smear_type);
 
+  /**
+     @brief Apply Wilson Flow steps W1, W2, Vt to the gauge field as
+     WFlowStep, and additionally form the embedded second-order
+     solution exp(2 Z1 - Z0) W0 (https://arxiv.org/abs/1301.4388) to
+     estimate the local error of the step.  The same extension and
+     exchange conventions as WFlowStep apply.  Unlike WFlowStep, the
+     input is left intact, so a rejected step can be retried from it.
+     @param[out] out Output smeared field
+     @param[in] temp Temp space
+     @param[out] low Non-extended temp space, holds the difference
+     between the third-order and embedded solutions on exit
+     @param[out] mid Extended temp space for the intermediate stage
+     @param[in] in Input gauge field
+     @param[in] epsilon Step size
+     @param[in] smear_type Wilson (1x1) or Symanzik improved (2x1) staples, else error
+     @return The largest deviation of any link element between the
+     third-order and embedded second-order solutions
+  */
+  double WFlowStepEmbedded(GaugeField &out, GaugeField &temp, GaugeField &low, GaugeField &mid, const GaugeField &in,
+                           double epsilon, QudaGaugeSmearType smear_type);
+
   /**
    * @brief Gauge fixing with overrelaxation with support for single and multi GPU.
    * @param[in,out] data, quda gauge field
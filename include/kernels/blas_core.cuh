@@ -191,6 +191,26 @@ namespace quda
       constexpr int flops() const { return 5; }   //! flops per element
     };
 
+    /**
+       Functor performing the operation: z[i] = a*x[i] + b*y[i] + c*z[i]
+    */
+    template <typename real> struct axpbypcz_ : public BlasFunctor {
+      static constexpr memory_access<1, 1, 1> read{ };
+      static constexpr memory_access<0, 0, 1> write{ };
+      const real a;
+      const real b;
+      const real c;
+      axpbypcz_(const real &a, const real &b, const real &c) : a(a), b(b), c(c) { ; }
+      template <typename T> __device__ __host__ void operator()(T &x, T &y, T &z, T &, T &) const
+      {
+#pragma unroll
+        for (int i = 0; i < x.size(); i++) {
+          z[i] = a * x[i] + b * y[i] + c * z[i];
+        }
+      }
+      constexpr int flops() const { return 5; }   //! flops per element
+    };
+
     /**
        Functor performing the operations: y[i] = a*x[i] + y[i]; x[i] = b*z[i] + c*x[i]
     */
@@ -5,6 +5,7 @@
 #include <shared_memory_cache_helper.h>
 #include <kernel.h>
 #include <warp_collective.h>
+#include <vector>
 
 namespace quda {
 
@@ -52,7 +53,8 @@ namespace quda {
 
     inline DslashCoarseArg(ColorSpinorField &out, const ColorSpinorField &inA, const ColorSpinorField &inB,
                            const GaugeField &Y, const GaugeField &X, real kappa, int parity) :
-      kernel_param(dim3(color_stride * X.VolumeCB(), out.SiteSubset(), 2 * dim_stride * 2 * (nColor / colors_per_thread(nColor, dim_stride)))),
+      kernel_param(dim3(color_stride * X.VolumeCB() * (out.Ndim() == 5 ? out.X(4) : 1), out.SiteSubset(),
+                        2 * dim_stride * 2 * (nColor / colors_per_thread(nColor, dim_stride)))),
       out(const_cast<ColorSpinorField &>(out)),
       inA(const_cast<ColorSpinorField &>(inA)),
       inB(const_cast<ColorSpinorField &>(inB)),
@@ -104,7 +106,7 @@ namespace quda {
      @param out The result vector
      @param thread_dir Direction
      @param x_cb The checkerboarded site index
-     @param src_idx dummy for now
+     @param src_idx The right-hand side (fifth-dimension) index
      @param parity The site parity
      @param s_row Which spin row are acting on
      @param color_block Which color row are we acting on
@@ -130,6 +132,7 @@ namespace quda {
 
 	if ( arg.commDim[d] && (coord[d] + arg.nFace >= arg.dim[d]) ) {
 	  if (doHalo<Arg::type>()) {
+            // the spinor ghost is five dimensional, so includes the right-hand side index
             int ghost_idx = ghostFaceIndex<1, 5>(coord, arg.dim, d, arg.nFace);
 
 #pragma unroll
@@ -143,10 +146,10 @@ namespace quda {
 		  int col = s_col * Arg::nColor + c_col + color_offset;
 		  if (!Arg::dagger)
                     out[color_local] = cmac(arg.Y(d+4, parity, x_cb, row, col),
-                                            arg.inA.Ghost(d, 1, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col+color_offset), out[color_local]);
+                                            arg.inA.Ghost(d, 1, their_spinor_parity, ghost_idx, s_col, c_col+color_offset), out[color_local]);
 		  else
 		    out[color_local] = cmac(arg.Y(d, parity, x_cb, row, col),
-                                            arg.inA.Ghost(d, 1, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col+color_offset), out[color_local]);
+                                            arg.inA.Ghost(d, 1, their_spinor_parity, ghost_idx, s_col, c_col+color_offset), out[color_local]);
 		}
 	      }
 	    }
@@ -185,7 +188,9 @@ namespace quda {
 	const int gauge_idx = back_idx;
 	if ( arg.commDim[d] && (coord[d] - arg.nFace < 0) ) {
 	  if (doHalo<Arg::type>()) {
+            // the spinor ghost is five dimensional, while the link ghost is four dimensional
             const int ghost_idx = ghostFaceIndex<0, 5>(coord, arg.dim, d, arg.nFace);
+            const int gauge_ghost_idx = ghostFaceIndex<0, 4>(coord, arg.dim, d, arg.nFace);
 #pragma unroll
 	    for (int color_local=0; color_local<Mc; color_local++) {
 	      int c_row = color_block + color_local;
@@ -196,11 +201,11 @@ namespace quda {
 		for (int c_col=0; c_col < Arg::nColor; c_col += Arg::color_stride) {
 		  int col = s_col * Arg::nColor + c_col + color_offset;
 		  if (!Arg::dagger)
-		    out[color_local] = cmac(conj(arg.Y.Ghost(d, 1-parity, ghost_idx, col, row)),
-                                            arg.inA.Ghost(d, 0, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col+color_offset), out[color_local]);
+		    out[color_local] = cmac(conj(arg.Y.Ghost(d, 1-parity, gauge_ghost_idx, col, row)),
+                                            arg.inA.Ghost(d, 0, their_spinor_parity, ghost_idx, s_col, c_col+color_offset), out[color_local]);
 		  else
-		    out[color_local] = cmac(conj(arg.Y.Ghost(d+4, 1-parity, ghost_idx, col, row)),
-                                            arg.inA.Ghost(d, 0, their_spinor_parity, ghost_idx + src_idx*arg.volumeCB, s_col, c_col+color_offset), out[color_local]);
+		    out[color_local] = cmac(conj(arg.Y.Ghost(d+4, 1-parity, gauge_ghost_idx, col, row)),
+                                            arg.inA.Ghost(d, 0, their_spinor_parity, ghost_idx, s_col, c_col+color_offset), out[color_local]);
 		}
 	    }
 	  }
@@ -319,6 +324,10 @@ namespace quda {
 
       parity = (arg.nParity == 2) ? parity : arg.parity;
 
+      // the right-hand sides are stacked along the x thread dimension
+      const int src_idx = x_cb / arg.volumeCB;
+      x_cb -= src_idx * arg.volumeCB;
+
       // z thread dimension is (( s*(Nc/Mc) + color_block )*dim_thread_split + dim)*2 + dir
       constexpr int Mc = colors_per_thread(Arg::nColor, Arg::dim_stride);
       int dir = sMd & 1;
@@ -328,7 +337,6 @@ namespace quda {
       int s = sM / (Arg::nColor/Mc);
       int color_block = (sM % (Arg::nColor/Mc)) * Mc;
 
-      constexpr int src_idx = 0;
       array<complex <typename Arg::real>, Mc> out{ };
 
       if (Arg::dslash) {
@@ -361,4 +369,201 @@ namespace quda {
     }
   };
 
+  /**
+     @brief Host implementation of the coarse dslash.  Each call
+     applies the full operator (all spin-color rows, both directions
+     of all dimensions and the clover term) at a single site for all
+     right-hand sides, so each row of a link matrix is loaded once and
+     reused across the right-hand sides.  Site vectors are held as
+     split real and imaginary arrays so that the inner loops over the
+     color columns vectorize.  The backward hops, which apply the
+     hermitian conjugate of the neighboring link, are computed as a
+     sum over the rows of the link rather than its columns, so links
+     are always streamed in memory order.
+   */
+  template <typename Arg> struct CoarseDslashHost {
+    using real = typename Arg::real;
+    static constexpr int N = Arg::nSpin * Arg::nColor; // length of a site vector
+    static constexpr int lanes = 4;                    // number of independent partial sums in the dot products
+    static_assert(N % lanes == 0, "Site vector length must be a multiple of the lane count");
+
+    const Arg &arg;
+    const int nSrc;
+    std::vector<real> in_re, in_im;   // input site vectors [nSrc][N]
+    std::vector<real> out_re, out_im; // accumulated site vectors [nSrc][N]
+    real row_re[N], row_im[N];        // present row of the link matrix
+
+    CoarseDslashHost(const Arg &arg) :
+      arg(arg), nSrc(arg.dim[4]), in_re(nSrc * N), in_im(nSrc * N), out_re(nSrc * N), out_im(nSrc * N)
+    {
+    }
+    static constexpr const char *filename() { return KERNEL_FILE; }
+
+    /**
+       @brief Load the input site vector for all right-hand sides
+       @param[in] in Accessor returning the spinor element for (src, spin, color)
+     */
+    template <typename In> inline void load(In &&in)
+    {
+      for (int src = 0; src < nSrc; src++) {
+        for (int s = 0; s < Arg::nSpin; s++) {
+          for (int c = 0; c < Arg::nColor; c++) {
+            const complex<real> v = in(src, s, c);
+            in_re[src * N + s * Arg::nColor + c] = v.real();
+            in_im[src * N + s * Arg::nColor + c] = v.imag();
+          }
+        }
+      }
+    }
+
+    /**
+       @brief Load a row of a link matrix
+       @param[in] m Accessor returning the matrix element for (row, col)
+       @param[in] row The row to load
+     */
+    template <typename M> inline void load_row(M &&m, int row)
+    {
+      for (int col = 0; col < N; col++) {
+        const complex<real> v = m(row, col);
+        row_re[col] = v.real();
+        row_im[col] = v.imag();
+      }
+    }
+
+    /**
+       @brief Accumulate out += M * in for all right-hand sides
+       @param[in] m Accessor returning the matrix element for (row, col)
+     */
+    template <typename M> inline void mat(M &&m)
+    {
+      for (int row = 0; row < N; row++) {
+        load_row(m, row);
+        for (int src = 0; src < nSrc; src++) {
+          const real *x_re = &in_re[src * N];
+          const real *x_im = &in_im[src * N];
+          real sum_re[lanes] = {}, sum_im[lanes] = {};
+          for (int col = 0; col < N; col += lanes) {
+            for (int l = 0; l < lanes; l++) {
+              sum_re[l] += row_re[col + l] * x_re[col + l] - row_im[col + l] * x_im[col + l];
+              sum_im[l] += row_re[col + l] * x_im[col + l] + row_im[col + l] * x_re[col + l];
+            }
+          }
+          for (int l = 0; l < lanes; l++) {
+            out_re[src * N + row] += sum_re[l];
+            out_im[src * N + row] += sum_im[l];
+          }
+        }
+      }
+    }
+
+    /**
+       @brief Accumulate out += M^\dagger * in for all right-hand
+       sides, as the sum over the rows of M scaled by the
+       corresponding input element
+       @param[in] m Accessor returning the matrix element for (row, col)
+     */
+    template <typename M> inline void mat_dagger(M &&m)
+    {
+      for (int row = 0; row < N; row++) {
+        load_row(m, row);
+        for (int src = 0; src < nSrc; src++) {
+          const real a_re = in_re[src * N + row];
+          const real a_im = in_im[src * N + row];
+          real *y_re = &out_re[src * N];
+          real *y_im = &out_im[src * N];
+          for (int col = 0; col < N; col++) {
+            y_re[col] += row_re[col] * a_re + row_im[col] * a_im;
+            y_im[col] += row_re[col] * a_im - row_im[col] * a_re;
+          }
+        }
+      }
+    }
+
+    void operator()(int x_cb, int parity)
+    {
+      parity = (arg.nParity == 2) ? parity : arg.parity;
+      const int their_spinor_parity = (arg.nParity == 2) ? 1 - parity : 0;
+      const int my_spinor_parity = (arg.nParity == 2) ? parity : 0;
+
+      std::fill(out_re.begin(), out_re.end(), real(0.0));
+      std::fill(out_im.begin(), out_im.end(), real(0.0));
+
+      if (Arg::dslash) {
+        int coord[5];
+        getCoordsCB(coord, x_cb, arg.dim, arg.X0h, parity);
+        coord[4] = 0;
+
+        // as on the device, the spinor ghost is indexed with the five-dimensional face index of each right-hand
+        // side, while the link ghost is indexed with the four-dimensional face index
+        auto spinor_ghost_idx = [&](auto dir, int d, int src) {
+          int coord_src[5] = {coord[0], coord[1], coord[2], coord[3], src};
+          return ghostFaceIndex<decltype(dir)::value, 5>(coord_src, arg.dim, d, arg.nFace);
+        };
+
+        for (int d = 0; d < Arg::nDim; d++) {
+          // forward hop: Y_{-mu}(x) in(x+mu), or Y_{+mu}^\dagger(x) in(x+mu) for the dagger operator
+          const int dim_fwd = Arg::dagger ? d : d + 4;
+          if (arg.commDim[d] && (coord[d] + arg.nFace >= arg.dim[d])) {
+            if (doHalo<Arg::type>()) {
+              load([&](int src, int s, int c) {
+                return arg.inA.Ghost(d, 1, their_spinor_parity, spinor_ghost_idx(std::integral_constant<int, 1>(), d, src),
+                                     s, c);
+              });
+              mat([&](int row, int col) { return arg.Y(dim_fwd, parity, x_cb, row, col); });
+            }
+          } else if (doBulk<Arg::type>()) {
+            const int fwd_idx = linkIndexP1(coord, arg.dim, d);
+            load([&](int src, int s, int c) { return arg.inA(their_spinor_parity, fwd_idx + src * arg.volumeCB, s, c); });
+            mat([&](int row, int col) { return arg.Y(dim_fwd, parity, x_cb, row, col); });
+          }
+
+          // backward hop: Y_{+mu}^\dagger(x-mu) in(x-mu), or Y_{-mu}(x-mu) in(x-mu) for the dagger operator
+          const int dim_back = Arg::dagger ? d + 4 : d;
+          if (arg.commDim[d] && (coord[d] - arg.nFace < 0)) {
+            if (doHalo<Arg::type>()) {
+              load([&](int src, int s, int c) {
+                return arg.inA.Ghost(d, 0, their_spinor_parity, spinor_ghost_idx(std::integral_constant<int, 0>(), d, src),
+                                     s, c);
+              });
+              const int gauge_ghost_idx = ghostFaceIndex<0, 4>(coord, arg.dim, d, arg.nFace);
+              mat_dagger([&](int row, int col) { return arg.Y.Ghost(dim_back, 1 - parity, gauge_ghost_idx, row, col); });
+            }
+          } else if (doBulk<Arg::type>()) {
+            const int back_idx = linkIndexM1(coord, arg.dim, d);
+            load([&](int src, int s, int c) { return arg.inA(their_spinor_parity, back_idx + src * arg.volumeCB, s, c); });
+            mat_dagger([&](int row, int col) { return arg.Y(dim_back, 1 - parity, back_idx, row, col); });
+          }
+        }
+
+        for (int i = 0; i < nSrc * N; i++) {
+          out_re[i] *= -arg.kappa;
+          out_im[i] *= -arg.kappa;
+        }
+      }
+
+      if (doBulk<Arg::type>() && Arg::clover) {
+        const int spinor_parity = (arg.nParity == 2) ? parity : 0;
+        load([&](int src, int s, int c) { return arg.inB(spinor_parity, x_cb + src * arg.volumeCB, s, c); });
+        if (!Arg::dagger)
+          mat([&](int row, int col) { return arg.X(0, parity, x_cb, row, col); });
+        else
+          mat_dagger([&](int row, int col) { return arg.X(0, parity, x_cb, row, col); });
+      }
+
+      for (int src = 0; src < nSrc; src++) {
+        for (int s = 0; s < Arg::nSpin; s++) {
+          for (int c = 0; c < Arg::nColor; c++) {
+            const int i = src * N + s * Arg::nColor + c;
+            const complex<real> v(out_re[i], out_im[i]);
+            // if not halo we just store, else we accumulate
+            if (doBulk<Arg::type>())
+              arg.out(my_spinor_parity, x_cb + src * arg.volumeCB, s, c) = v;
+            else
+              arg.out(my_spinor_parity, x_cb + src * arg.volumeCB, s, c) += v;
+          }
+        }
+      }
+    }
+  };
+
 } // namespace quda
@@ -34,7 +34,7 @@ namespace quda {
   };
 
   template<typename Arg>
-  __device__ inline double plaquette(const Arg &arg, int x[], int parity, int mu, int nu)
+  __device__ __host__ inline double plaquette(const Arg &arg, int x[], int parity, int mu, int nu)
   {
     using Link = Matrix<complex<typename Arg::Float>,3>;
 
@@ -12,6 +12,9 @@ namespace quda
     WFLOW_STEP_W1,
     WFLOW_STEP_W2,
     WFLOW_STEP_VT,
+    WFLOW_STEP_W1_EMBEDDED, // W1 step that also saves W0 for the embedded solution
+    WFLOW_STEP_W2_EMBEDDED, // W2 step that also computes the embedded second-order solution
+    WFLOW_STEP_VT_EMBEDDED, // Vt step that also computes the deviation from the embedded solution
   };
 
   template <typename Float, int nColor_, QudaReconstructType recon_, int wflow_dim_,
@@ -29,6 +32,7 @@ namespace quda
 
     Gauge out;
     Matrix temp;
+    Matrix low; // embedded second-order solution, only used by the embedded steps
     const Gauge in;
 
     int_fastdiv X[4];    // grid dimensions
@@ -38,10 +42,11 @@ namespace quda
     const real coeff1x1;
     const real coeff2x1;
 
-    GaugeWFlowArg(GaugeField &out, GaugeField &temp, const GaugeField &in, const real epsilon) :
+    GaugeWFlowArg(GaugeField &out, GaugeField &temp, GaugeField &low, const GaugeField &in, const real epsilon) :
       kernel_param(dim3(in.LocalVolumeCB(), 2, wflow_dim)),
       out(out),
       temp(temp),
+      low(low),
       in(in),
       epsilon(epsilon),
       coeff1x1(5.0/3.0),
@@ -79,12 +84,25 @@ namespace quda
     return Z;
   }
 
+  /**
+     @brief Compute the anti-Hermitian traceless projection of Z, and
+     return exp(Z) U
+  */
+  template <typename Arg, typename Link> __host__ __device__ inline Link flowLink(Link Z, const Link &U)
+  {
+    using real = typename Arg::real;
+    makeAntiHerm(Z);
+    Z = complex<real>(0.0, -1.0) * Z;
+    return exponentiate_iQ(Z) * U;
+  }
+
   template <typename Link, typename Arg>
   __host__ __device__ inline auto computeW1Step(const Arg &arg, Link &U, const int *x, const int parity, const int x_cb, const int dir)
   {
     // Compute staples and Z0
     Link Z0 = computeStaple(arg, x, parity, dir);
     U = arg.in(dir, linkIndex(x, arg.E), parity);
+    if (arg.step_type == WFLOW_STEP_W1_EMBEDDED) arg.low(dir, x_cb, parity) = U; // W0 for the embedded solution
     Z0 *= conj(U);
     arg.temp(dir, x_cb, parity) = Z0;
     Z0 *= static_cast<typename Arg::real>(1.0 / 4.0) * arg.epsilon;
@@ -101,6 +119,16 @@ namespace quda
 
     // Retrieve Z0, (8/9 Z1 - 17/36 Z0) stored in temp
     Link Z0 = arg.temp(dir, x_cb, parity);
+
+    if (arg.step_type == WFLOW_STEP_W2_EMBEDDED) {
+      // Embedded second-order solution exp(2 Z1 - Z0) W0, https://arxiv.org/abs/1301.4388,
+      // where W0 was saved in low by the W1 step
+      Link W0 = arg.low(dir, x_cb, parity);
+      Link Z = static_cast<typename Arg::real>(9.0 / 4.0) * Z1 - Z0;
+      Z *= arg.epsilon;
+      arg.low(dir, x_cb, parity) = flowLink<Arg>(Z, W0);
+    }
+
     Z0 *= static_cast<typename Arg::real>(17.0 / 36.0);
     Z1 = Z1 - Z0;
     arg.temp(dir, x_cb, parity) = Z1;
@@ -143,9 +171,12 @@ namespace quda
 
       Link U, Z;
       switch (arg.step_type) {
-      case WFLOW_STEP_W1: Z = computeW1Step(arg, U, x, parity, x_cb, dir); break;
-      case WFLOW_STEP_W2: Z = computeW2Step(arg, U, x, parity, x_cb, dir); break;
-      case WFLOW_STEP_VT: Z = computeVtStep(arg, U, x, parity, x_cb, dir); break;
+      case WFLOW_STEP_W1:
+      case WFLOW_STEP_W1_EMBEDDED: Z = computeW1Step(arg, U, x, parity, x_cb, dir); break;
+      case WFLOW_STEP_W2:
+      case WFLOW_STEP_W2_EMBEDDED: Z = computeW2Step(arg, U, x, parity, x_cb, dir); break;
+      case WFLOW_STEP_VT:
+      case WFLOW_STEP_VT_EMBEDDED: Z = computeVtStep(arg, U, x, parity, x_cb, dir); break;
       }
 
       // Compute anti-hermitian projection of Z, exponentiate, update U
@@ -153,6 +184,12 @@ namespace quda
       Z = im * Z;
       U = exponentiate_iQ(Z) * U;
       arg.out(dir, linkIndex(x, arg.E), parity) = U;
+
+      // Deviation of the third-order from the embedded second-order solution
+      if (arg.step_type == WFLOW_STEP_VT_EMBEDDED) {
+        Link V = arg.low(dir, x_cb, parity);
+        arg.low(dir, x_cb, parity) = U - V;
+      }
     }
   };
 
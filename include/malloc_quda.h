@@ -161,6 +161,12 @@ namespace quda {
     */
     void flush_pinned();
 
+    /**
+       @brief Print the live, cached and wasted bytes of the device
+       and pinned memory pools.
+    */
+    void print_stats();
+
   } // namespace pool
 
 }
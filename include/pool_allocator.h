@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+/**
+   @file pool_allocator.h
+
+   @section Description
+
+   Backend-agnostic caching allocator used to implement the device
+   and pinned memory pools.  Requests are rounded up to a size class:
+   small requests are served from per-class free lists, while large
+   requests are carved from arenas obtained from the backend, with
+   best-fit placement, splitting of oversized blocks and coalescing
+   of neighboring free blocks on release.  Cached memory is released
+   back to the backend whenever the memory held by the pool exceeds
+   the high-water mark.  The backend is any pair of malloc / free
+   functions with the signature of quda::device_malloc_ and
+   quda::device_free_, so the pool can be exercised against plain
+   host memory.
+ */
+
+namespace quda
+{
+
+  class PoolAllocator
+  {
+
+  public:
+    using backend_malloc_t = void *(*)(const char *func, const char *file, int line, size_t bytes);
+    using backend_free_t = void (*)(const char *func, const char *file, int line, void *ptr);
+
+    /**
+       @brief Memory statistics of the pool
+     */
+    struct stats_t {
+      size_t live = 0;          // bytes requested by outstanding allocations
+      size_t wasted = 0;        // bytes handed out in excess of the requested size (rounding and unsplit remainders)
+      size_t cached = 0;        // bytes held by the pool that are not allocated
+      size_t reserved = 0;      // bytes obtained from the backend (live + wasted + cached)
+      size_t peak_live = 0;     // peak value of live
+      size_t peak_reserved = 0; // peak value of reserved
+      size_t backend_allocs = 0; // number of backend allocations made
+      size_t backend_frees = 0;  // number of backend frees made
+    };
+
+    static constexpr size_t alignment = 256;             // alignment and granularity of all blocks
+    static constexpr size_t small_limit = 1 << 20;       // requests below this are served from size-class free lists
+    static constexpr size_t arena_granularity = 2 << 20; // arena sizes are rounded up to a multiple of this
+    static constexpr size_t no_limit = SIZE_MAX;
+
+  private:
+    struct block_t {
+      char *arena;  // base address of the arena this block belongs to
+      size_t size;  // size of the block
+      bool free;    // whether the block is presently free
+    };
+
+    struct allocation_t {
+      size_t size;      // size of the block handed out
+      size_t requested; // size that was requested
+    };
+
+    backend_malloc_t backend_malloc;
+    backend_free_t backend_free;
+    size_t high_water;
+
+    std::map<size_t, std::vector<void *>> small_free;    // free small blocks, indexed by size class
+    std::map<char *, size_t> arenas;                     // large arenas and their sizes
+    std::map<char *, block_t> blocks;                    // all blocks carved from the arenas, ordered by address
+    std::multimap<size_t, char *> large_free;            // free blocks in the arenas, ordered by size
+    std::unordered_map<void *, allocation_t> allocations; // outstanding allocations
+
+    stats_t stats_;
+
+    void insert_free(char *ptr, size_t size);
+    void erase_free(char *ptr, size_t size);
+    void *allocate_large(const char *func, const char *file, int line, size_t size);
+    void deallocate_large(char *ptr);
+    void release_arena(char *arena);
+    void update_peak();
+
+  public:
+    /**
+       @brief Create a pool on top of the given backend
+       @param[in] backend_malloc Function used to allocate memory for the pool
+       @param[in] backend_free Function used to free memory allocated by backend_malloc
+       @param[in] high_water Maximum number of bytes held by the pool before cached memory is released
+     */
+    PoolAllocator(backend_malloc_t backend_malloc, backend_free_t backend_free, size_t high_water = no_limit);
+
+    PoolAllocator(const PoolAllocator &) = delete;
+    PoolAllocator &operator=(const PoolAllocator &) = delete;
+
+    /**
+       @brief Release all cached memory.  Outstanding allocations are
+       not freed.
+     */
+    ~PoolAllocator();
+
+    /**
+       @brief Return the size class that a request of a given size is rounded up to
+       @param[in] bytes Size of request
+       @return Size of block that will be handed out
+     */
+    static size_t size_class(size_t bytes);
+
+    /**
+       @brief Allocate memory from the pool
+       @param[in] bytes Size of allocation
+       @return Pointer to allocated memory
+     */
+    void *allocate(const char *func, const char *file, int line, size_t bytes);
+
+    /**
+       @brief Return an allocation to the pool
+       @param[in] ptr Pointer to be freed
+     */
+    void deallocate(const char *func, const char *file, int line, void *ptr);
+
+    /**
+       @brief Release cached memory back to the backend until the
+       memory held by the pool is no greater than the given limit, or
+       there is no further cached memory that can be released.
+       Partially occupied arenas are never released.
+       @param[in] limit Target for the number of bytes held by the pool
+     */
+    void trim(size_t limit);
+
+    /**
+       @brief Release all cached memory back to the backend
+     */
+    void flush() { trim(0); }
+
+    /**
+       @brief Set the high-water mark, trimming the pool if needed
+       @param[in] high_water Maximum number of bytes held by the pool before cached memory is released
+     */
+    void set_high_water(size_t high_water);
+
+    /**
+       @return Memory statistics of the pool
+     */
+    const stats_t &stats() const { return stats_; }
+
+    /**
+       @brief Print the memory statistics of the pool
+       @param[in] name Name of the pool
+     */
+    void print_stats(const char *name) const;
+  };
+
+} // namespace quda
@@ -426,7 +426,13 @@ extern "C" {
     /** Whether the solution should replace the last entry in the chronology */
     int chrono_replace_last;
 
-    /** Whether to use the resident chronological basis */
+    /** Whether to use the resident chronological basis.  The
+        operator products of the basis are kept resident and reused
+        while the operator is unchanged, which only saves work when
+        successive solves share an operator (not in HMC, where the
+        gauge field changes between solves).  They are recomputed
+        every QUDA_CHRONO_REFRESH (default 4) forecasts to bound
+        accumulated round-off. */
     int chrono_use_resident;
 
     /** The maximum length of the chronological history to store */
@@ -468,7 +474,10 @@ extern "C" {
     /** Degree of the Chebysev polynomial **/
     int poly_deg;
 
-    /** Range used in polynomial acceleration **/
+    /** Range used in polynomial acceleration.  If a_max (a_min) is
+        not positive, it is estimated from a short Lanczos run: a_max
+        as an upper bound of the spectrum, and a_min as the point below
+        which n_ev eigenvalues are expected to lie **/
     double a_min;
     double a_max;
 
@@ -835,6 +844,12 @@ extern "C" {
     double rho; /**< Serves as one of the coefficients used in Over Improved Stout smearing, or as the single coefficient used in Stout */
     unsigned int meas_interval;    /**< Perform the requested measurements on the gauge field at this interval */
     QudaGaugeSmearType smear_type; /**< The smearing type to perform */
+    double adaptive_tol; /**< If positive, integrate Wilson/Symanzik flow with an adaptive step size, keeping the local
+                            error estimate of each step below this tolerance.  epsilon is then the initial step size,
+                            and the flow time and measurement times are those of the fixed step integration, on
+                            which the steps are made to end */
+    unsigned int adaptive_n_steps; /**< Output: the number of steps taken by the adaptive flow, including rejected
+                                      steps */
   } QudaGaugeSmearParam;
 
   typedef struct QudaBLASParam_s {
@@ -1699,6 +1714,31 @@ extern "C" {
    */
   void flushChronoQuda(int index);
 
+  /**
+   * @brief Save the chronological history for the given index to a
+   * file, so that it can be restored by a later job with
+   * loadChronoQuda.  The basis is written in QUDA's native vector
+   * format, and so must be loaded with the same process grid.
+   * @param[in] filename File to save the history to
+   * @param[in] index Index of the history to save
+   */
+  void saveChronoQuda(const char *filename, int index);
+
+  /**
+   * @brief Restore the chronological history for the given index from
+   * a file written by saveChronoQuda, replacing any existing history
+   * for that index.  The basis is loaded directly into device fields
+   * at chrono_precision, ready for use by the next solve with
+   * chrono_use_resident set.  If the file holds more than
+   * chrono_max_dim vectors, only the most recent are loaded.
+   * @param[in] filename File to load the history from
+   * @param[in] index Index of the history to restore
+   * @param[in] param Invert parameters of the solves that will use
+   * the history, which define the solution field layout and the
+   * chrono_max_dim and chrono_precision of the history
+   */
+  void loadChronoQuda(const char *filename, int index, QudaInvertParam *param);
+
 
   /**
   * Create deflation solver resources.
@@ -1708,7 +1748,11 @@ extern "C" {
   void* newDeflationQuda(QudaEigParam *param);
 
   /**
-   * Free resources allocated by the deflated solver
+   * Free resources allocated by the deflated solver.  If vec_outfile
+   * is set, the deflation space is first saved to it together with
+   * its projection matrix and Ritz values, from which a deflated
+   * solver created with import_vectors set can resume without
+   * rebuilding the projection.
    */
   void destroyDeflationQuda(void *df_instance);
 
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/**
+   @file reproducible_sum.h
+
+   @section Description
+
+   Binned accumulator used for reproducible global sums.  A double is
+   decomposed into 32-bit integer digits on a fixed grid of bins at
+   absolute binary exponents, and only the n_bin most significant bins
+   below the largest contribution seen so far are retained.  Since
+   every bin holds an exact integer sum of digits, and the window of
+   retained bins only ever moves upward, merging two accumulators is
+   exactly associative and commutative.  The resulting sum is
+   therefore bitwise independent of the order and grouping in which
+   contributions are merged, which allows it to be used as the
+   operator in a tree reduction.
+ */
+
+namespace quda
+{
+
+  namespace reproducible
+  {
+
+    struct accumulator_t {
+      static constexpr int n_bin = 4;         // number of 32-bit bins retained (128 bits)
+      static constexpr int bin_width = 32;    // bits per bin
+      static constexpr int bias = 1088;       // exponent bias such that all finite doubles map to non-negative bins
+      static constexpr int64_t empty = -1;    // bin index of an empty accumulator
+
+      int64_t top = empty;    // absolute index of the most significant retained bin
+      int64_t bin[n_bin] = {}; // integer digit sums, most significant first
+      double special = 0.0;   // sum of any non-finite contributions
+
+      accumulator_t() = default;
+
+      accumulator_t(double x) { add(x); }
+
+      /**
+         @brief Move the window of retained bins up such that the most
+         significant bin is top_.  Bins that fall off the bottom of the
+         window are discarded.
+         @param[in] top_ New index of the most significant bin
+       */
+      void shift(int64_t top_)
+      {
+        if (top != empty) {
+          const int64_t k = top_ - top;
+          for (int b = n_bin - 1; b >= 0; b--) bin[b] = b - k >= 0 ? bin[b - k] : 0;
+        }
+        top = top_;
+      }
+
+      /**
+         @brief Add a value to the accumulator.  Each bin receives at
+         most one digit, with magnitude less than 2^32, so up to 2^31
+         values can be accumulated without overflow.
+         @param[in] x The value to add
+       */
+      void add(double x)
+      {
+        if (!std::isfinite(x)) {
+          special += x;
+          return;
+        }
+        if (x == 0.0) return;
+
+        int e;
+        std::frexp(x, &e); // |x| < 2^e
+        const int64_t j = (e + bias) / bin_width;
+        if (j > top) shift(j);
+
+        // scale such that |y| < 1 with the binary point at the top of the window: this and the digit
+        // extraction below are exact, unless y underflows in which case x is below the window
+        double y = std::ldexp(x, -static_cast<int>(bin_width * (top + 1) - bias));
+        for (int b = 0; b < n_bin; b++) {
+          y = std::ldexp(y, bin_width);
+          const int64_t d = static_cast<int64_t>(y);
+          bin[b] += d;
+          y -= d;
+        }
+      }
+
+      /**
+         @brief Merge another accumulator into this one
+         @param[in] a The accumulator to merge
+       */
+      void merge(const accumulator_t &a)
+      {
+        special += a.special;
+        if (a.top == empty) return;
+        if (a.top > top) shift(a.top);
+        const int64_t offset = top - a.top;
+        for (int b = 0; b + offset < n_bin; b++) bin[b + offset] += a.bin[b];
+      }
+
+      /**
+         @brief Return the accumulated sum correctly rounded to a
+         double.  The digits are first normalized, so the result
+         depends only on the value held by the accumulator.
+       */
+      double value() const
+      {
+        if (special != 0.0) return special;
+        if (top == empty) return 0.0;
+
+        // normalize such that all but the most significant digit lie in [0, 2^32), and take the
+        // magnitude, so that rounding is not spoiled by cancellation between digits of opposite sign
+        int64_t digit[n_bin];
+        for (int b = 0; b < n_bin; b++) digit[b] = bin[b];
+        auto carry = [&digit]() {
+          for (int b = n_bin - 1; b > 0; b--) {
+            const int64_t c = digit[b] >> bin_width; // floor division, leaving a digit in [0, 2^32)
+            digit[b] -= c * (int64_t(1) << bin_width);
+            digit[b - 1] += c;
+          }
+        };
+        carry();
+        const bool negative = digit[0] < 0;
+        if (negative) {
+          for (int b = 0; b < n_bin; b++) digit[b] = -digit[b];
+          carry();
+        }
+
+        // the magnitude as n_bin + 1 unsigned digits, the first holding the overflow of the top bin
+        constexpr uint64_t mask = (uint64_t(1) << bin_width) - 1;
+        uint64_t u[n_bin + 1];
+        u[0] = static_cast<uint64_t>(digit[0]) >> bin_width;
+        u[1] = static_cast<uint64_t>(digit[0]) & mask;
+        for (int b = 1; b < n_bin; b++) u[b + 1] = static_cast<uint64_t>(digit[b]);
+
+        int i = 0;
+        while (i <= n_bin && u[i] == 0) i++;
+        if (i > n_bin) return 0.0;
+
+        // gather the leading (up to) 64 bits into m, folding any bits below into a sticky bit so
+        // that the conversion to double rounds correctly (round to odd)
+        uint64_t m = u[i++];
+        while (i <= n_bin && m <= mask) m = (m << bin_width) | u[i++];
+        int lsb = bin_width * (n_bin - i + 1); // exponent of the least significant bit of m
+        if (i <= n_bin) {
+          int z = 0;
+          while (!(m >> (63 - z))) z++;
+          if (z > 0) {
+            m = (m << z) | (u[i] >> (bin_width - z));
+            lsb -= z;
+            if (u[i] & ((uint64_t(1) << (bin_width - z)) - 1)) m |= 1;
+            i++;
+          }
+          for (; i <= n_bin; i++)
+            if (u[i]) m |= 1;
+        }
+
+        const int scale = static_cast<int>(bin_width * (top - n_bin + 1) - bias);
+        const double sum = std::ldexp(static_cast<double>(m), lsb + scale);
+        return negative ? -sum : sum;
+      }
+    };
+
+  } // namespace reproducible
+
+} // namespace quda
@@ -36,11 +36,27 @@ static inline __device__ double atomicAdd(double *address, double val)
 namespace quda
 {
 
+  /**
+     @brief Host implementation of an atomic update using a
+     compare-and-swap loop.  This is used rather than an OpenMP atomic
+     since the host kernels are executed on the host thread pool
+     regardless of whether OpenMP is enabled.
+     @param[in,out] addr The memory address of the variable we are
+     updating atomically
+     @param[in] op Binary operation that returns the updated value
+  */
+  template <typename T, typename Op> inline void atomic_update_host(T *addr, Op op)
+  {
+    T old;
+    __atomic_load(addr, &old, __ATOMIC_RELAXED);
+    T value = op(old);
+    while (!__atomic_compare_exchange(addr, &old, &value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) value = op(old);
+  }
+
   template <bool is_device> struct atomic_fetch_add_impl {
     template <typename T> inline void operator()(T *addr, T val)
     {
-#pragma omp atomic update
-      *addr += val;
+      atomic_update_host(addr, [=](const T &old) { return old + val; });
     }
   };
 
@@ -73,8 +89,7 @@ namespace quda
   template <bool is_device> struct atomic_fetch_abs_max_impl {
     template <typename T> inline void operator()(T *addr, T val)
     {
-#pragma omp atomic update
-      *addr = std::max(*addr, val);
+      atomic_update_host(addr, [=](const T &old) { return std::max(old, val); });
     }
   };
 
@@ -78,6 +78,11 @@ namespace quda
       return location == QUDA_CPU_FIELD_LOCATION ? false : Tunable::advanceTuneParam(param);
     }
 
+    QudaFieldLocation tuneLocation() const
+    {
+      return location == QUDA_CPU_FIELD_LOCATION ? QUDA_CPU_FIELD_LOCATION : QUDA_CUDA_FIELD_LOCATION;
+    }
+
     TuneKey tuneKey() const { return TuneKey(vol, typeid(*this).name(), aux); }
   };
 
@@ -1,13 +1,19 @@
+#include <kernel_host.h>
+
 namespace quda
 {
 
-  template <template <typename> class Functor, typename Arg> void BlockKernel2D_host(const Arg &arg)
+  template <template <typename> class Functor, typename Arg>
+  void BlockKernel2D_host(const Arg &arg, const host::launch_param_t &param = host::launch_param_t())
   {
-    Functor<Arg> t(arg);
-    dim3 block(0, 0, 0);
-    for (block.y = 0; block.y < arg.grid_dim.y; block.y++) {
-      for (block.x = 0; block.x < arg.grid_dim.x; block.x++) { t(block, dim3(0, 0, 0)); }
-    }
+    const int64_t nx = arg.grid_dim.x;
+    host::parallel_for(nx * arg.grid_dim.y, param, [&](int64_t begin, int64_t end) {
+      Functor<Arg> t(arg);
+      for (int64_t idx = begin; idx < end; idx++) {
+        dim3 block(idx % nx, idx / nx, 0);
+        t(block, dim3(0, 0, 0));
+      }
+    });
   }
 
 } // namespace quda
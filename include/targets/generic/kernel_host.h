@@ -1,30 +1,78 @@
 #pragma once
 
+#include <tune_quda.h>
+#include <thread_pool.h>
+
 namespace quda
 {
 
-  template <template <typename> class Functor, typename Arg> void Kernel1D_host(const Arg &arg)
+  /**
+     @brief Return the host launch parameters encoded in a TuneParam.
+     The host field of the TuneParam encodes the thread count, the
+     number of chunks per thread, the schedule and the loop nest.  The
+     loop nest selects the site blocking of multi-dimensional kernels:
+     0 runs the y and z indices fastest for each x index, 1 and 2
+     process blocks of 16 and 128 x indices for each y/z index, while
+     3 runs x fastest over the entire x extent.
+     @param[in] tp The launch parameters
+     @return The host launch parameters
+  */
+  inline host::launch_param_t host_launch_param(const TuneParam &tp)
   {
-    Functor<Arg> f(const_cast<Arg &>(arg));
-    for (int i = 0; i < static_cast<int>(arg.threads.x); i++) { f(i); }
+    constexpr int64_t site_block[] = {1, 16, 128, INT64_MAX};
+    host::launch_param_t param;
+    param.n_threads = tp.host.x;
+    param.chunks_per_thread = tp.host.y;
+    param.schedule = static_cast<host::schedule_t>(tp.host.z);
+    param.site_block = site_block[std::min(std::max(tp.host.w, 0), 3)];
+    return param;
   }
 
-  template <template <typename> class Functor, typename Arg> void Kernel2D_host(const Arg &arg)
+  template <template <typename> class Functor, typename Arg>
+  void Kernel1D_host(const Arg &arg, const host::launch_param_t &param = host::launch_param_t())
   {
-    Functor<Arg> f(const_cast<Arg &>(arg));
-    for (int i = 0; i < static_cast<int>(arg.threads.x); i++) {
-      for (int j = 0; j < static_cast<int>(arg.threads.y); j++) { f(i, j); }
-    }
+    host::parallel_for(arg.threads.x, param, [&](int64_t begin, int64_t end) {
+      Functor<Arg> f(const_cast<Arg &>(arg));
+      for (int i = begin; i < end; i++) { f(i); }
+    });
+  }
+
+  template <template <typename> class Functor, typename Arg>
+  void Kernel2D_host(const Arg &arg, const host::launch_param_t &param = host::launch_param_t())
+  {
+    // collapse the loop nest over blocks of x indices, with the y index running fastest
+    const int64_t nx = arg.threads.x;
+    const int64_t ny = arg.threads.y;
+    const int64_t bx = std::min(std::max(param.site_block, int64_t(1)), nx);
+    const int64_t n_block = (nx + bx - 1) / bx;
+    host::parallel_for(n_block * ny, param, [&](int64_t begin, int64_t end) {
+      Functor<Arg> f(const_cast<Arg &>(arg));
+      for (int64_t idx = begin; idx < end; idx++) {
+        const int j = idx % ny;
+        const int64_t x_end = std::min((idx / ny + 1) * bx, nx);
+        for (int64_t i = (idx / ny) * bx; i < x_end; i++) { f(i, j); }
+      }
+    });
   }
 
-  template <template <typename> class Functor, typename Arg> void Kernel3D_host(const Arg &arg)
+  template <template <typename> class Functor, typename Arg>
+  void Kernel3D_host(const Arg &arg, const host::launch_param_t &param = host::launch_param_t())
   {
-    Functor<Arg> f(const_cast<Arg &>(arg));
-    for (int i = 0; i < static_cast<int>(arg.threads.x); i++) {
-      for (int j = 0; j < static_cast<int>(arg.threads.y); j++) {
-        for (int k = 0; k < static_cast<int>(arg.threads.z); k++) { f(i, j, k); }
+    // collapse the loop nest over blocks of x indices, with the z index running fastest
+    const int64_t nx = arg.threads.x;
+    const int64_t ny = arg.threads.y;
+    const int64_t nz = arg.threads.z;
+    const int64_t bx = std::min(std::max(param.site_block, int64_t(1)), nx);
+    const int64_t n_block = (nx + bx - 1) / bx;
+    host::parallel_for(n_block * ny * nz, param, [&](int64_t begin, int64_t end) {
+      Functor<Arg> f(const_cast<Arg &>(arg));
+      for (int64_t idx = begin; idx < end; idx++) {
+        const int j = (idx / nz) % ny;
+        const int k = idx % nz;
+        const int64_t x_end = std::min((idx / (ny * nz) + 1) * bx, nx);
+        for (int64_t i = (idx / (ny * nz)) * bx; i < x_end; i++) { f(i, j, k); }
       }
-    }
+    });
   }
 
 } // namespace quda
@@ -1,39 +1,70 @@
 #pragma once
 
 #include <vector>
+#include <kernel_host.h>
 
 namespace quda
 {
 
-  template <template <typename> class Functor, typename Arg> auto Reduction2D_host(const Arg &arg)
+  /**
+     @brief Host reduction kernel.  The x and y dimensions are
+     collapsed and reduced over, using a fixed partition such that the
+     result is independent of the thread count and schedule.
+   */
+  template <template <typename> class Functor, typename Arg>
+  auto Reduction2D_host(const Arg &arg, const host::launch_param_t &param = host::launch_param_t())
   {
     using reduce_t = typename Functor<Arg>::reduce_t;
     Functor<Arg> t(arg);
 
-    reduce_t value = t.init();
+    const int64_t nx = arg.threads.x;
+    auto reduce = [&](reduce_t value, int64_t begin, int64_t end) {
+      Functor<Arg> t(arg);
+      for (int64_t idx = begin; idx < end; idx++) { value = t(value, idx % nx, idx / nx); }
+      return value;
+    };
 
-    for (int j = 0; j < static_cast<int>(arg.threads.y); j++) {
-      for (int i = 0; i < static_cast<int>(arg.threads.x); i++) { value = t(value, i, j); }
-    }
-
-    return value;
+    return host::parallel_reduce(nx * arg.threads.y, param, t.init(), reduce,
+                                 [&](const reduce_t &a, const reduce_t &b) { return t(a, b); });
   }
 
-  template <template <typename> class Functor, typename Arg> auto MultiReduction_host(const Arg &arg)
+  /**
+     @brief Host multi-reduction kernel.  For each z index, the x and
+     y dimensions are collapsed and reduced over.  The z indices are
+     processed together over blocks of site_block sites (see
+     host_launch_param), so that data shared across the batch is
+     reused from cache, while each z index is still accumulated over
+     the sites in order, such that the result does not depend on the
+     blocking.
+   */
+  template <template <typename> class Functor, typename Arg>
+  auto MultiReduction_host(const Arg &arg, const host::launch_param_t &param = host::launch_param_t())
   {
     using reduce_t = typename Functor<Arg>::reduce_t;
     Functor<Arg> t(arg);
 
-    std::vector<reduce_t> value(arg.threads.z);
-    for (int k = 0; k < static_cast<int>(arg.threads.z); k++) {
-      value[k] = t.init();
-
-      for (int j = 0; j < static_cast<int>(arg.threads.y); j++) {
-        for (int i = 0; i < static_cast<int>(arg.threads.x); i++) { value[j] = t(value[j], i, j, k); }
+    const int64_t nx = arg.threads.x;
+    const int nz = arg.threads.z;
+    auto reduce = [&](std::vector<reduce_t> value, int64_t begin, int64_t end) {
+      Functor<Arg> t(arg);
+      const int64_t bx = std::max(param.site_block, int64_t(1));
+      for (int64_t block = begin; block < end;) {
+        const int64_t block_end = block + std::min(bx, end - block);
+        for (int k = 0; k < nz; k++) {
+          for (int64_t idx = block; idx < block_end; idx++) { value[k] = t(value[k], idx % nx, idx / nx, k); }
+        }
+        block = block_end;
       }
-    }
+      return value;
+    };
+
+    auto combine = [&](const std::vector<reduce_t> &a, const std::vector<reduce_t> &b) {
+      std::vector<reduce_t> value(a.size());
+      for (auto k = 0u; k < a.size(); k++) value[k] = t(a[k], b[k]);
+      return value;
+    };
 
-    return value;
+    return host::parallel_reduce(nx * arg.threads.y, param, std::vector<reduce_t>(nz, t.init()), reduce, combine);
   }
 
 } // namespace quda
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+   @file thread_pool.h
+
+   @section Description
+
+   The host execution engine that sits behind the generic host kernel
+   launchers (Kernel1D_host, Reduction2D_host, etc.).  Work is
+   distributed over a persistent pool of worker threads, with the
+   calling thread partaking as worker 0.  The pool size is set from
+   the QUDA_HOST_THREADS environment variable, falling back to
+   OMP_NUM_THREADS, and defaults to a single thread if neither is set.
+ */
+
+namespace quda
+{
+
+  namespace host
+  {
+
+    /**
+       @brief Work-sharing schedule used when distributing the
+       iteration space over the pool
+     */
+    enum class schedule_t {
+      static_chunk, // chunks are assigned round-robin to threads ahead of time
+      dynamic_chunk // chunks are taken from a shared counter as threads become free
+    };
+
+    /**
+       @brief Launch parameters for host kernels.  A value of zero for
+       n_threads indicates that all threads in the pool are used.  A
+       value of zero for chunk indicates that the iteration space is
+       split evenly into chunks_per_thread chunks per thread.
+     */
+    struct launch_param_t {
+      int n_threads = 0;
+      int64_t chunk = 0;
+      int chunks_per_thread = 1;
+      schedule_t schedule = schedule_t::static_chunk;
+      int64_t site_block = 1; // number of consecutive x indices processed per y/z index in multi-dimensional kernels
+    };
+
+    /**
+       @brief Return the number of threads in the pool (including the
+       calling thread)
+     */
+    int max_threads();
+
+    /**
+       @brief Return whether we are presently executing inside a
+       parallel region.  Nested parallel regions are executed
+       serially by the calling thread.
+     */
+    bool in_parallel();
+
+    /**
+       @brief Join the worker threads and free the pool.  The pool
+       will be recreated on demand if needed again.  Called by
+       endQuda.
+     */
+    void destroy();
+
+    /**
+       @brief Execute a function concurrently on n_threads threads.
+       The calling thread executes as thread 0 and this function
+       returns once all threads have completed.
+       @param[in] n_threads Number of threads to use (clamped to max_threads())
+       @param[in] fn Function to execute, called as fn(thread_id, n_threads, ctx)
+       @param[in] ctx Opaque context pointer passed through to fn
+     */
+    void parallel_region(int n_threads, void (*fn)(int, int, void *), void *ctx);
+
+    /**
+       @brief Return the number of threads that will be used for a
+       given iteration space length and launch parameters.  We ensure
+       that no thread is left without work.
+     */
+    inline int get_n_threads(int64_t n_items, const launch_param_t &param)
+    {
+      int n_threads = param.n_threads > 0 ? std::min(param.n_threads, max_threads()) : max_threads();
+      if (in_parallel()) n_threads = 1;
+      return static_cast<int>(std::max(std::min(static_cast<int64_t>(n_threads), n_items), int64_t(1)));
+    }
+
+    /**
+       @brief Distribute the iteration space [0, n_items) over the
+       thread pool, calling f(begin, end) on each chunk.
+       @param[in] n_items Length of iteration space
+       @param[in] param Launch parameters
+       @param[in] f Body to execute for each chunk
+     */
+    template <typename F> void parallel_for(int64_t n_items, const launch_param_t &param, F &&f)
+    {
+      if (n_items <= 0) return;
+      const int n_threads = get_n_threads(n_items, param);
+      const int64_t n_chunk = static_cast<int64_t>(n_threads) * std::max(param.chunks_per_thread, 1);
+      const int64_t chunk = param.chunk > 0 ? param.chunk : std::max((n_items + n_chunk - 1) / n_chunk, int64_t(1));
+
+      if (n_threads == 1) {
+        for (int64_t begin = 0; begin < n_items; begin += chunk) f(begin, std::min(begin + chunk, n_items));
+        return;
+      }
+
+      struct context_t {
+        F &f;
+        int64_t n_items;
+        int64_t chunk;
+        schedule_t schedule;
+        std::atomic<int64_t> next;
+      } ctx {f, n_items, chunk, param.schedule, {0}};
+
+      auto body = [](int tid, int n_threads, void *ctx_) {
+        auto &ctx = *static_cast<context_t *>(ctx_);
+        if (ctx.schedule == schedule_t::static_chunk) {
+          for (int64_t begin = tid * ctx.chunk; begin < ctx.n_items; begin += n_threads * ctx.chunk)
+            ctx.f(begin, std::min(begin + ctx.chunk, ctx.n_items));
+        } else {
+          for (int64_t begin = ctx.next.fetch_add(ctx.chunk); begin < ctx.n_items;
+               begin = ctx.next.fetch_add(ctx.chunk))
+            ctx.f(begin, std::min(begin + ctx.chunk, ctx.n_items));
+        }
+      };
+
+      parallel_region(n_threads, body, &ctx);
+    }
+
+    /**
+       @brief Return the length of the fixed partition used for host
+       reductions.  This depends only on the length of the iteration
+       space, and not on the launch parameters, ensuring that the
+       result is reproducible regardless of the thread count or
+       schedule.
+     */
+    inline int64_t reduction_block_size(int64_t n_items)
+    {
+      constexpr int64_t max_blocks = 1024;
+      constexpr int64_t min_block_size = 256;
+      return std::max((n_items + max_blocks - 1) / max_blocks, min_block_size);
+    }
+
+    /**
+       @brief Reduce over the iteration space [0, n_items).  Partial
+       reductions are computed over a fixed partition of the
+       iteration space, and are then combined in order on the calling
+       thread, so the result is bitwise reproducible independent of
+       the number of threads and schedule.
+       @param[in] n_items Length of iteration space
+       @param[in] param Launch parameters
+       @param[in] init Initial value for each partial reduction
+       @param[in] f Body that reduces a chunk, called as value = f(value, begin, end)
+       @param[in] combine Binary function that combines two partial reductions
+       @return The reduced value
+     */
+    template <typename T, typename F, typename R>
+    T parallel_reduce(int64_t n_items, const launch_param_t &param, const T &init, F &&f, R &&combine)
+    {
+      const int64_t block_size = reduction_block_size(n_items);
+      const int64_t n_block = (n_items + block_size - 1) / block_size;
+      std::vector<T> partial(n_block, init);
+
+      launch_param_t block_param = param;
+      block_param.chunk = param.chunk > 0 ? std::max(param.chunk / block_size, int64_t(1)) : 0;
+
+      parallel_for(n_block, block_param, [&](int64_t block_begin, int64_t block_end) {
+        for (auto b = block_begin; b < block_end; b++)
+          partial[b] = f(partial[b], b * block_size, std::min((b + 1) * block_size, n_items));
+      });
+
+      T value = init;
+      for (auto &p : partial) value = combine(value, p);
+      return value;
+    }
+
+  } // namespace host
+
+} // namespace quda
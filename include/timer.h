@@ -1,6 +1,8 @@
 #pragma once
 
 #include <sys/time.h>
+#include <chrono>
+#include <string>
 
 #ifdef INTERFACE_NVTX
 #if QUDA_NVTX_VERSION == 3
@@ -32,10 +34,10 @@ namespace quda {
     double last_interval;
 
     /**< Used to store when the timer was last started */
-    timeval host_start;
+    std::chrono::steady_clock::time_point host_start;
 
     /**< Used to store when the timer was last stopped */
-    timeval host_stop;
+    std::chrono::steady_clock::time_point host_stop;
 
     /**< Used to store when the timer was last started */
     qudaEvent_t device_start;
@@ -77,7 +79,7 @@ namespace quda {
         errorQuda("Aborting");
       }
       if (!device) {
-        gettimeofday(&host_start, NULL);
+        host_start = std::chrono::steady_clock::now();
       } else {
         qudaEventRecord(device_start, stream);
       }
@@ -91,10 +93,8 @@ namespace quda {
         errorQuda("Aborting");
       }
       if (!device) {
-        gettimeofday(&host_stop, NULL);
-        long ds = host_stop.tv_sec - host_start.tv_sec;
-        long dus = host_stop.tv_usec - host_start.tv_usec;
-        last_interval = ds + 0.000001 * dus;
+        host_stop = std::chrono::steady_clock::now();
+        last_interval = std::chrono::duration<double>(host_stop - host_start).count();
       } else {
         qudaEventRecord(device_stop, stream);
         qudaEventSynchronize(device_stop);
@@ -175,6 +175,94 @@ namespace quda {
     QUDA_PROFILE_COUNT  /**< The total number of timers we have.  Must be last enum type. */
   };
 
+  /**
+     Hierarchical trace of where time is spent, enabled by setting
+     QUDA_PROFILE_TRACE to "json" (per-scope summary), "chrome"
+     (Chrome trace-event format, viewable with chrome://tracing or
+     Perfetto) or "all".  Each TimeProfile timer opens a scope while
+     it is running (the total timer is named after the profile, and
+     the others after their category), as does each trace_scope_t,
+     nested within the scopes open at the time it is started, e.g.,
+     invertQuda > compute > dslash.  For every distinct scope path
+     the call count, total, minimum and maximum time and a latency
+     histogram are kept.  The trace is written, and then reset, at
+     endQuda, one file per rank, to QUDA_PROFILE_TRACE_PATH if set,
+     else to QUDA_RESOURCE_PATH, else to the working directory.
+   */
+  namespace trace
+  {
+
+    /**
+       @brief Return whether tracing is enabled
+     */
+    bool enabled();
+
+    /**
+       @brief Open a scope nested within the innermost open scope
+       @param[in] key Unique identifier of the scope, used to close it
+       @param[in] name Name of the scope
+     */
+    void push(const void *key, const std::string &name);
+
+    /**
+       @brief Close a scope.  Scopes are usually closed in the reverse
+       order they were opened, but this is not required.
+       @param[in] key Identifier the scope was opened with
+     */
+    void pop(const void *key);
+
+    /**
+       @brief Write the trace of this rank to disk, if tracing is
+       enabled, and then reset it
+     */
+    void save();
+
+    /**
+       @brief Discard the trace of this rank, releasing its storage.
+       Scopes that are open at the time are not recorded when closed.
+     */
+    void reset();
+
+  } // namespace trace
+
+  /**
+     @brief Helper that traces the enclosing C++ scope under a given
+     name.  When the scope issues asynchronous device work, the stream
+     it completes on should be given, which is then synchronized
+     before the scope is closed so that the recorded time includes the
+     execution and not only the launch.  This serializes the traced
+     work, so the overlap of communication and computation is lost
+     while tracing.
+   */
+  class trace_scope_t
+  {
+    bool active;
+    bool sync;
+    qudaStream_t stream;
+
+  public:
+    trace_scope_t(const char *name) : active(trace::enabled()), sync(false), stream {}
+    {
+      if (active) trace::push(this, name);
+    }
+
+    trace_scope_t(const char *name, const qudaStream_t &stream) : active(trace::enabled()), sync(true), stream(stream)
+    {
+      if (active) trace::push(this, name);
+    }
+
+    ~trace_scope_t()
+    {
+      if (active) {
+        if (sync) qudaStreamSynchronize(stream);
+        trace::pop(this);
+      }
+    }
+
+    trace_scope_t(const trace_scope_t &) = delete;
+    trace_scope_t &operator=(const trace_scope_t &) = delete;
+  };
+
 #ifdef INTERFACE_NVTX
 
 #define PUSH_RANGE(name,cid) { \
@@ -251,21 +339,25 @@ namespace quda {
       // if total timer isn't running, then start it running
       if (!profile[QUDA_PROFILE_TOTAL].running && idx != QUDA_PROFILE_TOTAL) {
         profile[QUDA_PROFILE_TOTAL].start(func, file, line);
+        if (trace::enabled()) trace::push(&profile[QUDA_PROFILE_TOTAL], fname);
         switchOff = true;
       }
 
       profile[idx].start(func, file, line);
+      if (trace::enabled()) trace::push(&profile[idx], idx == QUDA_PROFILE_TOTAL ? fname : pname[idx]);
       PUSH_RANGE(fname.c_str(),idx)
 	if (use_global) StartGlobal(func,file,line,idx);
     }
 
     void Stop_(const char *func, const char *file, int line, QudaProfileType idx) {
       profile[idx].stop(func, file, line);
+      if (trace::enabled()) trace::pop(&profile[idx]);
       POP_RANGE
 
       // switch off total timer if we need to
       if (switchOff && idx != QUDA_PROFILE_TOTAL) {
         profile[QUDA_PROFILE_TOTAL].stop(func, file, line);
+        if (trace::enabled()) trace::pop(&profile[QUDA_PROFILE_TOTAL]);
         switchOff = false;
       }
       if (use_global) StopGlobal(func,file,line,idx);
@@ -92,7 +92,7 @@ namespace quda
       if (tp.block.x == Block::block[idx]) {
         const_cast<Arg &>(arg).grid_dim = tp.grid;
         const_cast<Arg &>(arg).block_dim = tp.block;
-        BlockKernel2D_host<Functor>(BlockKernelArg<Block::block[idx], Arg>(arg));
+        BlockKernel2D_host<Functor>(BlockKernelArg<Block::block[idx], Arg>(arg), host_launch_param(tp));
       } else if constexpr (idx < Block::block.size() - 1) {
         launch_host<Functor, Block, idx + 1>(tp, stream, arg);
       } else {
@@ -122,7 +122,7 @@ namespace quda
       if (location == QUDA_CUDA_FIELD_LOCATION) {
         launch_device<Functor, Block>(tp, stream, arg);
       } else if constexpr (enable_host) {
-        launch_host<Functor, Block>(tp, arg);
+        launch_host<Functor, Block>(tp, stream, arg);
       } else {
         errorQuda("CPU not supported yet");
       }
@@ -47,9 +47,9 @@ namespace quda
        @param[in] arg Kernel argument struct
      */
     template <template <typename> class Functor, typename Arg>
-    void launch_host(const TuneParam &, const qudaStream_t &, const Arg &arg)
+    void launch_host(const TuneParam &tp, const qudaStream_t &, const Arg &arg)
     {
-      Kernel1D_host<Functor, Arg>(arg);
+      Kernel1D_host<Functor, Arg>(arg, host_launch_param(tp));
     }
 
     /**
@@ -180,6 +180,12 @@ namespace quda
     mutable unsigned int step_y;
     bool tune_block_x;
 
+    /**
+       @brief The loop nest is only tuned on the host if there is
+       more than one index in the y dimension
+    */
+    bool tuneHostNest() const { return vector_length_y > 1; }
+
     /**
        @brief Launch kernel on the device performing the operation
        defined in the functor.
@@ -204,10 +210,10 @@ namespace quda
        @param[in] arg Kernel argument struct
      */
     template <template <typename> class Functor, typename Arg>
-    void launch_host(const TuneParam &, const qudaStream_t &, const Arg &arg)
+    void launch_host(const TuneParam &tp, const qudaStream_t &, const Arg &arg)
     {
       const_cast<Arg &>(arg).threads.y = vector_length_y;
-      Kernel2D_host<Functor, Arg>(arg);
+      Kernel2D_host<Functor, Arg>(arg, host_launch_param(tp));
     }
 
     /**
@@ -450,11 +456,11 @@ namespace quda
        @param[in] arg Kernel argument struct
      */
     template <template <typename> class Functor, typename Arg>
-    void launch_host(const TuneParam &, const qudaStream_t &, const Arg &arg)
+    void launch_host(const TuneParam &tp, const qudaStream_t &, const Arg &arg)
     {
       const_cast<Arg &>(arg).threads.y = vector_length_y;
       const_cast<Arg &>(arg).threads.z = vector_length_z;
-      Kernel3D_host<Functor, Arg>(arg);
+      Kernel3D_host<Functor, Arg>(arg, host_launch_param(tp));
     }
 
     /**
@@ -96,12 +96,12 @@ namespace quda
        @param[in] arg Kernel argument struct
      */
     template <template <typename> class Functor, typename T, typename Arg>
-    void launch_host(T &result, const TuneParam &, const qudaStream_t &, Arg &arg)
+    void launch_host(T &result, const TuneParam &tp, const qudaStream_t &, Arg &arg)
     {
       if (arg.threads.y != block_size_y)
         errorQuda("Unexected y threads: received %d, expected %d", arg.threads.y, block_size_y);
       std::vector<T> result_(1);
-      result_[0] = Reduction2D_host<Functor, Arg>(arg);
+      result_[0] = Reduction2D_host<Functor, Arg>(arg, host_launch_param(tp));
       if (!activeTuning() && commGlobalReduction()) Functor<Arg>::comm_reduce(result_);
       result = result_[0];
     }
@@ -211,6 +211,12 @@ namespace quda
      */
     unsigned int maxBlockSize(const TuneParam &) const { return device::max_block_size(); }
 
+    /**
+       @brief The loop nest is only tuned on the host if there is
+       more than one reduction in the batch
+    */
+    bool tuneHostNest() const { return n_batch > 1; }
+
     /**
        @brief Launch multi-reduction kernel on the device performing
        the reduction defined in the functor.  After the local
@@ -249,13 +255,19 @@ namespace quda
        @param[in] arg Kernel argument struct
      */
     template <template <typename> class Functor, typename T, typename Arg>
-    void launch_host(std::vector<T> &result, const TuneParam &, const qudaStream_t &, Arg &arg)
+    void launch_host(std::vector<T> &result, const TuneParam &tp, const qudaStream_t &, Arg &arg)
     {
       if (n_batch_block_max > Arg::max_n_batch_block)
         errorQuda("n_batch_block_max = %u greater than maximum supported %u", n_batch_block_max, Arg::max_n_batch_block);
 
-      auto value = MultiReduction_host<Functor, Arg>(arg);
-      for (int j = 0; j < (int)arg.threads.z; j++) result[j] = value[j];
+      auto value = MultiReduction_host<Functor, Arg>(arg, host_launch_param(tp));
+
+      // copy back result element by element, as for the device, since each batch element may be an array
+      using reduce_t = typename Functor<Arg>::reduce_t;
+      const int n_element = arg.threads.z * sizeof(reduce_t) / sizeof(T);
+      if (result.size() != (unsigned)n_element)
+        errorQuda("result vector length %lu does not match n_reduce %d", result.size(), n_element);
+      for (int i = 0; i < n_element; i++) result[i] = reinterpret_cast<const T *>(value.data())[i];
       if (!activeTuning() && commGlobalReduction()) Functor<Arg>::comm_reduce(result);
     }
 
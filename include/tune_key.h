@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 
@@ -41,6 +42,32 @@ namespace quda {
       return false;
     }
 
+    bool operator==(const TuneKey &other) const
+    {
+      return std::strcmp(volume, other.volume) == 0 && std::strcmp(name, other.name) == 0
+        && std::strcmp(aux, other.aux) == 0;
+    }
+
+    bool operator!=(const TuneKey &other) const { return !(*this == other); }
+
+    /**
+       @brief Return a 64-bit FNV-1a hash of the key, computed over
+       the volume, name and aux strings up to their terminators.
+       Used to index the tunecache.
+     */
+    uint64_t hash() const
+    {
+      uint64_t h = 0xcbf29ce484222325ull;
+      auto accumulate = [&h](const char *s) {
+        for (; *s; s++) h = (h ^ static_cast<unsigned char>(*s)) * 0x100000001b3ull;
+        h = (h ^ 0xff) * 0x100000001b3ull; // separator so that field boundaries are significant
+      };
+      accumulate(volume);
+      accumulate(name);
+      accumulate(aux);
+      return h;
+    }
+
     friend std::ostream &operator<<(std::ostream &output, const TuneKey &key)
     {
       output << "volume = " << key.volume << ", ";
@@ -25,10 +25,13 @@ namespace quda {
     unsigned int shared_bytes;
     bool set_max_shared_bytes; // whether to opt in to max shared bytes per thread block
     int4 aux; // free parameter that can be used as an arbitrary autotuning dimension outside of launch parameters
+    int4 host; // host launch parameters: (thread count, chunks per thread, schedule, loop nest), see host_launch_param
 
     std::string comment;
     float time;
     long long n_calls;
+    long long flops; // floating-point operations per call, recorded for the profile
+    long long bytes; // bytes moved per call, recorded for the profile
 
     TuneParam();
     TuneParam(const TuneParam &) = default;
@@ -41,6 +44,8 @@ namespace quda {
       output << "grid=(" << param.grid.x << "," << param.grid.y << "," << param.grid.z << "), ";
       output << "shared_bytes=" << param.shared_bytes;
       output << ", aux=(" << param.aux.x << "," << param.aux.y << "," << param.aux.z << "," << param.aux.w << ")";
+      if (param.host.x > 0)
+        output << ", host=(" << param.host.x << "," << param.host.y << "," << param.host.z << "," << param.host.w << ")";
       return output;
     }
   };
@@ -213,6 +218,13 @@ namespace quda {
 
     virtual bool advanceAux(TuneParam &) const { return false; }
 
+    /**
+       @brief Whether to tune the loop nest order and site blocking
+       when executing on the host.  This is only meaningful for
+       kernels with a multi-dimensional iteration space.
+    */
+    virtual bool tuneHostNest() const { return false; }
+
     char vol[TuneKey::volume_n];
     char aux[TuneKey::aux_n];
 
@@ -221,6 +233,8 @@ namespace quda {
         configuration */
     qudaError_t launch_error;
 
+    friend TuneParam tuneLaunch(Tunable &tunable, QudaTune enabled, QudaVerbosity verbosity);
+
     /**
        @brief Whether the present instance has already been tuned or not
        @return True if tuned, false if not
@@ -230,16 +244,43 @@ namespace quda {
       // not tuning is equivalent to already tuned
       if (!getTuning()) return true;
 
-      TuneKey key = tuneKey();
-      if (use_managed_memory()) strcat(key.aux, ",managed");
+      TuneKey key = launchKey();
       // if key is present in cache then already tuned
       return getTuneCache().find(key) != getTuneCache().end();
     }
 
+    /**
+       @brief Return the strings that tuneKey() is built from, without
+       copying them into a key.  Tunables that override this let
+       tuneLaunch find their tunecache entry through the launch memo,
+       which is keyed by the name pointer, and so skip building and
+       hashing the key on every launch.  The name must have static
+       storage duration (e.g., a typeid name).
+       @param[out] vol_ The volume string
+       @param[out] name The name string
+       @param[out] aux_ The aux string
+       @return Whether the parts are available
+    */
+    virtual bool tuneKeyParts(const char *&, const char *&, const char *&) const { return false; }
+
   public:
     Tunable() : launch_error(QUDA_SUCCESS) { aux[0] = '\0'; }
     virtual ~Tunable() { }
     virtual TuneKey tuneKey() const = 0;
+
+    /**
+       @brief Return the location where this instance executes.  Host
+       instances are tuned over the host launch parameters.
+    */
+    virtual QudaFieldLocation tuneLocation() const { return QUDA_CUDA_FIELD_LOCATION; }
+
+    /**
+       @brief Return the key used to index the tunecache.  This is the
+       tuneKey() qualified by the memory model and, for host
+       instances, the execution location and size of the host thread
+       pool, such that device and host entries never collide.
+    */
+    TuneKey launchKey() const;
     virtual void apply(const qudaStream_t &stream) = 0;
     virtual void preTune() { }
     virtual void postTune() { }
@@ -327,6 +368,23 @@ namespace quda {
       return advanceSharedBytes(param) || advanceBlockDim(param) || advanceGridDim(param) || advanceAux(param);
     }
 
+    /**
+       @brief Initialize the host launch parameters: all threads in
+       the host thread pool with one chunk per thread, static
+       scheduling and the default loop nest.
+       @param[in,out] param TuneParam object passed during autotuning
+    */
+    virtual void initHostParam(TuneParam &param) const;
+
+    /**
+       @brief Advance the host launch parameters.  The loop nest is
+       the fastest running parameter, followed by the chunking and
+       schedule, and finally the thread count.
+       @param[in,out] param TuneParam object passed during autotuning
+       @return Whether a new set of parameters has been generated
+    */
+    virtual bool advanceHostParam(TuneParam &param) const;
+
     /**
      * Check the launch parameters of the kernel to ensure that they are
      * valid for the current device.
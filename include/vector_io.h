@@ -7,22 +7,86 @@ namespace quda
 
   /**
      @brief VectorIO is a simple wrapper class for loading and saving
-     sets of vector fields using QIO.
+     sets of vector fields.  Vectors are stored either using QIO, or
+     in QUDA's native format, where each rank reads and writes its
+     own region of the file directly with pread / pwrite.  The format
+     of a file is detected when loading.  When saving, the native
+     format is used if QIO was not built, if it is requested at
+     construction, or if the QUDA_VECTOR_IO_NATIVE environment
+     variable is set to 1.  The
+     native format stores the rank-local fields as they are, so files
+     can only be read back with the same process grid, and
+     parity_inflate has no effect on it.  Native I/O is streamed one
+     vector at a time, with the disk transfers running concurrently
+     with the host-device transfers of neighboring vectors (see
+     QUDA_VECTOR_IO_DEPTH).  Vectors are stored at the precision of
+     the fields, or at the lower precision requested with
+     QUDA_VECTOR_IO_PRECISION (single, half or quarter).  Half and
+     quarter precision vectors are stored in the native device
+     encoding with their per-site norms, so they are loaded into
+     device fields of the same precision without conversion, and the
+     relative error introduced when saving at a reduced precision is
+     reported.
    */
   class VectorIO
   {
     const std::string filename;
+    const bool native;
 #ifdef HAVE_QIO
     bool parity_inflate;
 #endif
+
+    /**
+       @brief Return whether filename is a file in the native format
+    */
+    bool isNativeFile() const;
+
+    /**
+       @brief Return whether vectors are saved in the native format
+    */
+    bool useNativeSave() const;
+
+    /**
+       @brief Load vectors from filename in the native format
+       @param[in] vecs The set of vectors to load
+    */
+    void loadNative(std::vector<ColorSpinorField *> &vecs);
+
+    /**
+       @brief Save vectors to filename in the native format
+       @param[in] vecs The set of vectors to save
+    */
+    void saveNative(const std::vector<ColorSpinorField *> &vecs);
+
+#ifdef HAVE_QIO
+    /**
+       @brief Load vectors from filename using QIO
+       @param[in] vecs The set of vectors to load
+    */
+    void loadQIO(std::vector<ColorSpinorField *> &vecs);
+
+    /**
+       @brief Save vectors to filename using QIO
+       @param[in] vecs The set of vectors to save
+    */
+    void saveQIO(const std::vector<ColorSpinorField *> &vecs);
+#endif
+
   public:
     /**
        Constructor for VectorIO class
        @param[in] filename The filename associated with this IO object
        @param[in] parity_inflate Whether to inflate single_parity
        field to dual parity fields for I/O
+       @param[in] native Whether to always save in the native format
+    */
+    VectorIO(const std::string &filename, bool parity_inflate = false, bool native = false);
+
+    /**
+       @brief Return the number of vectors stored in filename, which
+       must be in the native format
     */
-    VectorIO(const std::string &filename, bool parity_inflate = false);
+    int numVectors() const;
 
     /**
        @brief Load vectors from filename
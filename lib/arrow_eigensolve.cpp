@@ -0,0 +1,650 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include <quda_internal.h>
+#include <arrow_eigensolve.h>
+#include <thread_pool.h>
+#include <eigen_helper.h>
+
+namespace quda
+{
+
+  namespace
+  {
+
+    // block tridiagonal sub-problems up to this size are solved densely
+    constexpr int leaf_size = 64;
+
+    // rows of the secular eigenvector matrix assembled at a time when applying it
+    constexpr int64_t panel_size = 128;
+
+    // iteration limits for the secular equation: after bisect_iter we
+    // only bisect, which always converges within max_iter
+    constexpr int bisect_iter = 40;
+    constexpr int max_iter = bisect_iter + 64;
+
+    constexpr double epsilon = std::numeric_limits<double>::epsilon();
+
+    template <typename T> using mat_t = Matrix<T, Dynamic, Dynamic>;
+    template <typename T> using vec_t = Matrix<T, Dynamic, 1>;
+
+    inline double conj_(double x) { return x; }
+    inline Complex conj_(const Complex &x) { return std::conj(x); }
+
+    // the secular eigenvector matrix is real, so complex matrices are
+    // multiplied by it as a real matrix holding the real and imaginary
+    // parts side by side
+    inline mat_t<double> splitComplex(const mat_t<double> &x) { return x; }
+    inline mat_t<double> splitComplex(const mat_t<Complex> &x)
+    {
+      mat_t<double> y(x.rows(), 2 * x.cols());
+      y.leftCols(x.cols()) = x.real();
+      y.rightCols(x.cols()) = x.imag();
+      return y;
+    }
+
+    inline void joinComplex(mat_t<double> &y, int i, const mat_t<double> &x, int j) { y.row(i) = x.row(j); }
+    inline void joinComplex(mat_t<Complex> &y, int i, const mat_t<double> &x, int j)
+    {
+      for (int c = 0; c < y.cols(); c++) y(i, c) = Complex(x(j, c), x(j, y.cols() + c));
+    }
+
+    // unit modulus phase of z given its modulus a, where the phase of zero is one
+    inline double phase(double z, double) { return z < 0.0 ? -1.0 : 1.0; }
+    inline Complex phase(const Complex &z, double a) { return a > 0.0 ? z / a : Complex(1.0); }
+
+    struct rotation_t {
+      int i;
+      int j;
+      double c;
+      double s;
+    };
+
+    /**
+       @brief Eigendecomposition of diag(d) + rho w w^dag.  The
+       eigenvector matrix is held in the factorized form U = Phi P G V,
+       where Phi is the diagonal matrix of phases of w, P the
+       permutation that sorts d, G the Givens rotations used for
+       deflation, and V the real eigenvector matrix of the deflated
+       problem, whose elements are evaluated on demand from the
+       solution of the secular equation.  The updating vector is
+       recomputed from the eigenvalues (Gu and Eisenstat), so the
+       eigenvectors are numerically orthogonal even for clustered
+       eigenvalues.
+    */
+    template <typename T> struct rank_one_t {
+      int n = 0;
+      std::vector<int> perm;       // index of the element at each sorted position
+      std::vector<T> phi;          // phase of the updating vector at each sorted position
+      std::vector<rotation_t> rot; // deflating rotations, in the order they were applied
+      std::vector<int> nd;         // sorted positions of the non-deflated elements
+      std::vector<double> dnd;     // diagonal of the non-deflated elements
+      std::vector<double> zhat;    // updating vector recomputed from the roots
+      std::vector<int> origin;     // root q lies at dnd[origin[q]] + tau[q]
+      std::vector<double> tau;
+      std::vector<double> scale;   // normalization of the eigenvector of each root
+      std::vector<int> pos;        // sorted position of each deflated eigenvector, else -1
+      std::vector<int> root;       // root of each non-deflated eigenvector, else -1
+      std::vector<double> eval;    // eigenvalues in ascending order
+
+      /**
+         @brief Element (j, q) of the secular eigenvector matrix, where j
+         indexes the non-deflated elements and q the roots
+      */
+      double core(int j, int q) const { return zhat[j] / ((dnd[j] - dnd[origin[q]]) - tau[q]) * scale[q]; }
+
+      /**
+         @brief Find root q of the secular equation
+         1 + r sum_j z_j^2 / (dnd_j - lambda) = 0, which lies in
+         (dnd_q, dnd_{q+1}), or above dnd_q for the last root.  The
+         root is found relative to the nearer pole, using the
+         rational model through the two enclosing poles that matches
+         the remaining terms in value and slope, safeguarded by
+         bisection.
+      */
+      void solveRoot(int q, double r, const std::vector<double> &z)
+      {
+        const int k = dnd.size();
+        const bool upper = q < k - 1;
+
+        int o = q;
+        double lo = 0.0, hi = 0.0;
+        if (upper) {
+          const double half = 0.5 * (dnd[q + 1] - dnd[q]);
+          double f = 1.0;
+          for (int j = 0; j < k; j++) f += r * z[j] * z[j] / ((dnd[j] - dnd[q]) - half);
+          if (f >= 0.0) {
+            hi = half;
+          } else {
+            o = q + 1;
+            lo = -half;
+          }
+        } else {
+          for (int j = 0; j < k; j++) hi += z[j] * z[j];
+          hi *= r;
+        }
+
+        const double d_lo = dnd[q] - dnd[o];
+        const double d_hi = upper ? dnd[q + 1] - dnd[o] : 0.0;
+
+        double x = 0.5 * (lo + hi);
+        for (int iter = 0; iter < max_iter; iter++) {
+          double psi = 0.0, dpsi = 0.0, phi_ = 0.0, dphi = 0.0;
+          for (int j = 0; j < q; j++) {
+            const double t = z[j] / ((dnd[j] - dnd[o]) - x);
+            psi += r * z[j] * t;
+            dpsi += r * t * t;
+          }
+          for (int j = q + 2; j < k; j++) {
+            const double t = z[j] / ((dnd[j] - dnd[o]) - x);
+            phi_ += r * z[j] * t;
+            dphi += r * t * t;
+          }
+          const double w_lo = r * z[q] * z[q] / (d_lo - x);
+          const double w_hi = upper ? r * z[q + 1] * z[q + 1] / (d_hi - x) : 0.0;
+
+          const double f = 1.0 + psi + phi_ + w_lo + w_hi;
+          const double err = 1.0 + std::abs(psi) + std::abs(phi_) + std::abs(w_lo) + std::abs(w_hi);
+          if (f < 0.0)
+            lo = x;
+          else
+            hi = x;
+          if (std::abs(f) <= 8.0 * epsilon * err) break;
+          if (hi - lo <= 2.0 * epsilon * std::max(std::abs(lo), std::abs(hi))) break;
+
+          // model f(y) = C + S_lo / (d_lo - y) + S_hi / (d_hi - y)
+          const double b_lo = dpsi * (d_lo - x) * (d_lo - x);
+          double C = 1.0 + psi - b_lo / (d_lo - x);
+          const double S_lo = r * z[q] * z[q] + b_lo;
+          double y = 0.5 * (lo + hi);
+          if (upper) {
+            const double b_hi = dphi * (d_hi - x) * (d_hi - x);
+            C += phi_ - b_hi / (d_hi - x);
+            const double S_hi = r * z[q + 1] * z[q + 1] + b_hi;
+            const double a = C;
+            const double b = -(C * (d_lo + d_hi) + S_lo + S_hi);
+            const double c = C * d_lo * d_hi + S_lo * d_hi + S_hi * d_lo;
+            if (a != 0.0) {
+              const double s = -0.5 * (b + std::copysign(std::sqrt(std::max(b * b - 4.0 * a * c, 0.0)), b));
+              const double y1 = s / a;
+              const double y2 = s != 0.0 ? c / s : y1;
+              y = (y1 > lo && y1 < hi) ? y1 : y2;
+            } else if (b != 0.0) {
+              y = -c / b;
+            }
+          } else if (C > 0.0) {
+            y = d_lo + S_lo / C;
+          }
+
+          if (iter >= bisect_iter || !(y > lo && y < hi)) y = 0.5 * (lo + hi);
+          if (y <= lo || y >= hi) break;
+          x = y;
+        }
+
+        origin[q] = o;
+        tau[q] = x;
+      }
+
+      /**
+         @brief Compute the eigendecomposition of diag(d) + rho w w^dag
+         @param[in] d The diagonal
+         @param[in] rho The weight of the update
+         @param[in] w The updating vector
+      */
+      void compute(const std::vector<double> &d, double rho, const std::vector<T> &w)
+      {
+        n = d.size();
+
+        // for negative rho we solve for the negated matrix
+        const double sign = rho < 0.0 ? -1.0 : 1.0;
+        double w_norm2 = 0.0;
+        for (auto &wi : w) w_norm2 += std::norm(wi);
+        const double w_norm = std::sqrt(w_norm2);
+        const double r = std::abs(rho) * w_norm2;
+
+        perm.resize(n);
+        std::iota(perm.begin(), perm.end(), 0);
+        std::stable_sort(perm.begin(), perm.end(), [&](int a, int b) { return sign * d[a] < sign * d[b]; });
+
+        std::vector<double> ds(n), zs(n);
+        phi.resize(n);
+        double d_max = 0.0;
+        for (int s = 0; s < n; s++) {
+          const double a = std::abs(w[perm[s]]);
+          ds[s] = sign * d[perm[s]];
+          zs[s] = w_norm > 0.0 ? a / w_norm : 0.0;
+          phi[s] = phase(w[perm[s]], a);
+          d_max = std::max(d_max, std::abs(ds[s]));
+        }
+        const double tol = 8.0 * epsilon * std::max(d_max, r);
+
+        // deflate negligible components of z, and rotate away one of
+        // each pair of close diagonal elements
+        std::vector<bool> deflated(n, false);
+        rot.clear();
+        int prev = -1;
+        for (int s = 0; s < n; s++) {
+          if (r * zs[s] <= tol) {
+            deflated[s] = true;
+            continue;
+          }
+          if (prev >= 0) {
+            const double h = std::hypot(zs[prev], zs[s]);
+            const double c = zs[s] / h;
+            const double sn = -zs[prev] / h;
+            if (std::abs((ds[s] - ds[prev]) * c * sn) <= tol) {
+              const double d_prev = ds[prev] * c * c + ds[s] * sn * sn;
+              ds[s] = ds[prev] * sn * sn + ds[s] * c * c;
+              ds[prev] = d_prev;
+              zs[s] = h;
+              zs[prev] = 0.0;
+              deflated[prev] = true;
+              rot.push_back({prev, s, c, sn});
+            }
+          }
+          prev = s;
+        }
+
+        nd.clear();
+        dnd.clear();
+        std::vector<double> z;
+        for (int s = 0; s < n; s++) {
+          if (deflated[s]) continue;
+          nd.push_back(s);
+          dnd.push_back(ds[s]);
+          z.push_back(zs[s]);
+        }
+        const int k = nd.size();
+
+        origin.resize(k);
+        tau.resize(k);
+        zhat.resize(k);
+        scale.resize(k);
+
+        host::launch_param_t param;
+        param.schedule = host::schedule_t::dynamic_chunk;
+        param.chunks_per_thread = 4;
+
+        host::parallel_for(k, param, [&](int64_t begin, int64_t end) {
+          for (auto q = begin; q < end; q++) solveRoot(q, r, z);
+        });
+
+        // z_j^2 = prod_l (lambda_l - d_j) / (r prod_{l != j} (d_l - d_j))
+        host::parallel_for(k, param, [&](int64_t begin, int64_t end) {
+          for (auto j = begin; j < end; j++) {
+            double p = ((dnd[origin[j]] - dnd[j]) + tau[j]) / r;
+            for (int l = 0; l < k; l++)
+              if (l != j) p *= ((dnd[origin[l]] - dnd[j]) + tau[l]) / (dnd[l] - dnd[j]);
+            zhat[j] = std::sqrt(std::abs(p));
+          }
+        });
+
+        host::parallel_for(k, param, [&](int64_t begin, int64_t end) {
+          for (auto q = begin; q < end; q++) {
+            double norm2 = 0.0;
+            for (int j = 0; j < k; j++) {
+              const double v = zhat[j] / ((dnd[j] - dnd[origin[q]]) - tau[q]);
+              norm2 += v * v;
+            }
+            scale[q] = 1.0 / std::sqrt(norm2);
+          }
+        });
+
+        struct entry_t {
+          double lambda;
+          int pos;
+          int root;
+        };
+        std::vector<entry_t> entry;
+        entry.reserve(n);
+        for (int s = 0; s < n; s++)
+          if (deflated[s]) entry.push_back({ds[s], s, -1});
+        for (int q = 0; q < k; q++) entry.push_back({dnd[origin[q]] + tau[q], -1, q});
+        std::stable_sort(entry.begin(), entry.end(),
+                         [](const entry_t &a, const entry_t &b) { return a.lambda < b.lambda; });
+        if (sign < 0.0) std::reverse(entry.begin(), entry.end());
+
+        pos.resize(n);
+        root.resize(n);
+        eval.resize(n);
+        for (int l = 0; l < n; l++) {
+          pos[l] = entry[l].pos;
+          root[l] = entry[l].root;
+          eval[l] = sign * entry[l].lambda;
+        }
+      }
+
+      /**
+         @brief Apply the eigenvector matrix, x <- U x
+         @param[in,out] x The n x m matrix to transform
+      */
+      void apply(mat_t<T> &x) const
+      {
+        const int k = nd.size();
+        mat_t<T> y(n, x.cols());
+        mat_t<T> xs(k, x.cols());
+        for (int l = 0; l < n; l++) {
+          if (root[l] < 0)
+            y.row(pos[l]) = x.row(l);
+          else
+            xs.row(root[l]) = x.row(l);
+        }
+
+        const mat_t<double> xs_split = splitComplex(xs);
+        host::launch_param_t param;
+        param.chunk = panel_size;
+        host::parallel_for(k, param, [&](int64_t begin, int64_t end) {
+          mat_t<double> v(end - begin, k);
+          for (auto j = begin; j < end; j++)
+            for (int q = 0; q < k; q++) v(j - begin, q) = core(j, q);
+          mat_t<double> yj = v * xs_split;
+          for (auto j = begin; j < end; j++) joinComplex(y, nd[j], yj, j - begin);
+        });
+
+        for (auto g = rot.rbegin(); g != rot.rend(); g++) {
+          vec_t<T> yi = y.row(g->i).transpose();
+          vec_t<T> yj = y.row(g->j).transpose();
+          y.row(g->i) = (T(g->c) * yi - T(g->s) * yj).transpose();
+          y.row(g->j) = (T(g->s) * yi + T(g->c) * yj).transpose();
+        }
+
+        for (int s = 0; s < n; s++) x.row(perm[s]) = phi[s] * y.row(s);
+      }
+
+      /**
+         @brief Apply the transpose, or the adjoint, of the eigenvector
+         matrix to a vector
+         @param[in] x The vector to transform
+         @param[in] adjoint Whether to apply U^dag rather than U^T
+         @return U^T x or U^dag x
+      */
+      std::vector<T> applyTranspose(const std::vector<T> &x, bool adjoint) const
+      {
+        std::vector<T> y(n);
+        for (int s = 0; s < n; s++) y[s] = (adjoint ? conj_(phi[s]) : phi[s]) * x[perm[s]];
+        for (auto &g : rot) {
+          const T yi = y[g.i], yj = y[g.j];
+          y[g.i] = g.c * yi + g.s * yj;
+          y[g.j] = -g.s * yi + g.c * yj;
+        }
+
+        const int k = nd.size();
+        std::vector<T> out(n);
+        host::launch_param_t param;
+        param.chunk = panel_size;
+        host::parallel_for(n, param, [&](int64_t begin, int64_t end) {
+          for (auto l = begin; l < end; l++) {
+            if (root[l] < 0) {
+              out[l] = y[pos[l]];
+            } else {
+              T sum = 0.0;
+              for (int j = 0; j < k; j++) sum += core(j, root[l]) * y[nd[j]];
+              out[l] = sum;
+            }
+          }
+        });
+        return out;
+      }
+    };
+
+    /**
+       @brief Right multiply each of a set of rows by the eigenvector
+       matrix of a rank-one update, rows <- rows U
+    */
+    template <typename T> void updateRows(mat_t<T> &rows, const rank_one_t<T> &u)
+    {
+      for (int i = 0; i < rows.rows(); i++) {
+        std::vector<T> x(rows.cols());
+        for (int j = 0; j < rows.cols(); j++) x[j] = rows(i, j);
+        auto y = u.applyTranspose(x, false);
+        for (int j = 0; j < rows.cols(); j++) rows(i, j) = y[j];
+      }
+    }
+
+  } // namespace
+
+  /**
+     A node of the divide and conquer tree.  A leaf holds a dense
+     eigendecomposition.  The eigenvector matrix of a merged node is
+     diag(Q_left, Q_right) U_0 U_1 ..., where U_i are the rank-one
+     updates, and a null left child stands for the identity.  When
+     no update is applied it is diag(Q_left, Q_right) P instead, with
+     P the permutation that sorts the children's eigenvalues.
+  */
+  template <typename T> struct ArrowEigensolver<T>::node_t {
+    int n = 0;
+    bool leaf = false;
+    std::vector<double> evals;
+    mat_t<T> q;
+    std::unique_ptr<node_t> left;
+    std::unique_ptr<node_t> right;
+    int n_left = 0;
+    std::vector<rank_one_t<T>> update;
+    std::vector<int> perm; // sorting permutation of the children's eigenvalues when no update is applied
+    mat_t<T> top;    // leading block rows of the eigenvector matrix
+    mat_t<T> bottom; // trailing block rows of the eigenvector matrix
+
+    /**
+       @brief Apply the eigenvector matrix, x <- Q x
+    */
+    void apply(mat_t<T> &x) const
+    {
+      if (leaf) {
+        x = q * x;
+        return;
+      }
+      if (!perm.empty()) {
+        mat_t<T> y(x.rows(), x.cols());
+        for (int l = 0; l < n; l++) y.row(perm[l]) = x.row(l);
+        x = y;
+      }
+      for (auto u = update.rbegin(); u != update.rend(); u++) u->apply(x);
+      if (left) {
+        mat_t<T> x_left = x.topRows(n_left);
+        left->apply(x_left);
+        x.topRows(n_left) = x_left;
+      }
+      if (right) {
+        mat_t<T> x_right = x.bottomRows(n - n_left);
+        right->apply(x_right);
+        x.bottomRows(n - n_left) = x_right;
+      }
+    }
+
+    /**
+       @brief Merge the children through a sequence of rank-one updates
+       @param[in] d The concatenated eigenvalues of the children
+       @param[in] rho The weights of the updates
+       @param[in] w The updating vectors in the basis of the children's eigenvectors
+    */
+    void merge(std::vector<double> d, const std::vector<double> &rho, std::vector<std::vector<T>> w)
+    {
+      for (auto j = 0u; j < rho.size(); j++) {
+        if (rho[j] == 0.0) continue;
+        update.emplace_back();
+        auto &u = update.back();
+        u.compute(d, rho[j], w[j]);
+        d = u.eval;
+        for (auto i = j + 1; i < rho.size(); i++) w[i] = u.applyTranspose(w[i], true);
+        updateRows(top, u);
+        updateRows(bottom, u);
+      }
+
+      // without any coupling the children's eigenvalues are only concatenated, so sort them
+      if (update.empty()) {
+        perm.resize(d.size());
+        std::iota(perm.begin(), perm.end(), 0);
+        std::stable_sort(perm.begin(), perm.end(), [&](int a, int b) { return d[a] < d[b]; });
+        std::vector<double> d_sorted(d.size());
+        mat_t<T> top_sorted(top.rows(), top.cols());
+        mat_t<T> bottom_sorted(bottom.rows(), bottom.cols());
+        for (auto l = 0u; l < d.size(); l++) {
+          d_sorted[l] = d[perm[l]];
+          if (top.size()) top_sorted.col(l) = top.col(perm[l]);
+          if (bottom.size()) bottom_sorted.col(l) = bottom.col(perm[l]);
+        }
+        d = d_sorted;
+        top = top_sorted;
+        bottom = bottom_sorted;
+      }
+      evals = d;
+    }
+
+    /**
+       @brief Compute the eigendecomposition of block rows [i0, i1) of
+       a block tridiagonal matrix.  The matrix is torn at the middle
+       block boundary, writing the coupling block as a sum of rank-one
+       terms through its SVD B = U S V^dag.
+       @param[in] b The block size
+       @param[in,out] diag The diagonal blocks, which are modified by the tearing
+       @param[in] sub The sub-diagonal blocks
+       @param[in] i0 The first block row
+       @param[in] i1 One past the last block row
+    */
+    void tridiag(int b, std::vector<mat_t<T>> &diag, const std::vector<mat_t<T>> &sub, int i0, int i1)
+    {
+      const int n_block = i1 - i0;
+      n = n_block * b;
+
+      if (n <= leaf_size || n_block < 2) {
+        leaf = true;
+        mat_t<T> h = mat_t<T>::Zero(n, n);
+        for (int i = 0; i < n_block; i++) {
+          h.block(i * b, i * b, b, b) = diag[i0 + i];
+          if (i < n_block - 1) {
+            h.block((i + 1) * b, i * b, b, b) = sub[i0 + i];
+            h.block(i * b, (i + 1) * b, b, b) = sub[i0 + i].adjoint();
+          }
+        }
+        SelfAdjointEigenSolver<mat_t<T>> eigensolver(h);
+        evals.resize(n);
+        for (int i = 0; i < n; i++) evals[i] = eigensolver.eigenvalues()[i];
+        q = eigensolver.eigenvectors();
+        top = q.topRows(b);
+        bottom = q.bottomRows(b);
+        return;
+      }
+
+      const int k = i0 + n_block / 2;
+      JacobiSVD<mat_t<T>> svd(sub[k - 1], ComputeFullU | ComputeFullV);
+      const auto &U = svd.matrixU();
+      const auto &V = svd.matrixV();
+      for (int j = 0; j < b; j++) {
+        const double sigma = svd.singularValues()[j];
+        diag[k - 1] -= T(sigma) * V.col(j) * V.col(j).adjoint();
+        diag[k] -= T(sigma) * U.col(j) * U.col(j).adjoint();
+      }
+
+      left.reset(new node_t);
+      left->tridiag(b, diag, sub, i0, k);
+      right.reset(new node_t);
+      right->tridiag(b, diag, sub, k, i1);
+      n_left = left->n;
+
+      std::vector<double> d(left->evals);
+      d.insert(d.end(), right->evals.begin(), right->evals.end());
+
+      std::vector<double> rho(b);
+      std::vector<std::vector<T>> w(b, std::vector<T>(n));
+      for (int j = 0; j < b; j++) {
+        rho[j] = svd.singularValues()[j];
+        vec_t<T> w_left = left->bottom.adjoint() * V.col(j);
+        vec_t<T> w_right = right->top.adjoint() * U.col(j);
+        for (int i = 0; i < n_left; i++) w[j][i] = w_left[i];
+        for (int i = 0; i < n - n_left; i++) w[j][n_left + i] = w_right[i];
+      }
+
+      top = mat_t<T>::Zero(b, n);
+      top.leftCols(n_left) = left->top;
+      bottom = mat_t<T>::Zero(b, n);
+      bottom.rightCols(n - n_left) = right->bottom;
+
+      merge(d, rho, w);
+    }
+  };
+
+  template <typename T> ArrowEigensolver<T>::ArrowEigensolver() = default;
+
+  template <typename T> ArrowEigensolver<T>::~ArrowEigensolver() = default;
+
+  template <typename T>
+  void ArrowEigensolver<T>::compute(int n_arrow, int block, const std::vector<double> &d, const std::vector<T> &r,
+                                    const std::vector<T> &t_diag, const std::vector<T> &t_sub)
+  {
+    const int block_length = block * block;
+    const int n_block = t_diag.size() / block_length;
+    if (block < 1 || n_block < 1) errorQuda("Invalid block size %d or number of blocks %d", block, n_block);
+    if (static_cast<int>(d.size()) != n_arrow || static_cast<int>(r.size()) != block * n_arrow
+        || static_cast<int>(t_sub.size()) != (n_block - 1) * block_length)
+      errorQuda("Inconsistent arrow matrix dimensions");
+
+    this->block = block;
+    n = n_arrow + n_block * block;
+    const int m = n_block * block;
+
+    std::vector<mat_t<T>> diag(n_block);
+    std::vector<mat_t<T>> sub(n_block - 1);
+    for (int i = 0; i < n_block; i++) diag[i] = Map<const mat_t<T>>(t_diag.data() + i * block_length, block, block);
+    for (int i = 0; i < n_block - 1; i++) sub[i] = Map<const mat_t<T>>(t_sub.data() + i * block_length, block, block);
+
+    std::unique_ptr<node_t> tail(new node_t);
+    tail->tridiag(block, diag, sub, 0, n_block);
+
+    if (n_arrow == 0) {
+      root = std::move(tail);
+    } else {
+      // In the basis diag(1, Q_T) the arrow becomes F^dag R, where F
+      // holds the leading rows of Q_T.  With R = U S V^dag the columns
+      // of F^dag U are orthonormal, and each rank-two term
+      // sigma (x y^dag + y x^dag) is split into the rank-one terms
+      // sigma / 2 ((x + y)(x + y)^dag - (x - y)(x - y)^dag).
+      JacobiSVD<mat_t<T>> svd(Map<const mat_t<T>>(r.data(), block, n_arrow), ComputeThinU | ComputeThinV);
+      mat_t<T> p = tail->top.adjoint() * svd.matrixU();
+
+      std::vector<double> d0(d);
+      d0.insert(d0.end(), tail->evals.begin(), tail->evals.end());
+
+      std::vector<double> rho;
+      std::vector<std::vector<T>> w;
+      for (int j = 0; j < svd.singularValues().size(); j++) {
+        for (auto sign : {1.0, -1.0}) {
+          std::vector<T> wj(n);
+          for (int i = 0; i < n_arrow; i++) wj[i] = svd.matrixV()(i, j);
+          for (int i = 0; i < m; i++) wj[n_arrow + i] = sign * p(i, j);
+          rho.push_back(0.5 * sign * svd.singularValues()[j]);
+          w.push_back(wj);
+        }
+      }
+
+      root.reset(new node_t);
+      root->n = n;
+      root->n_left = n_arrow;
+      root->bottom = mat_t<T>::Zero(block, n);
+      root->bottom.rightCols(m) = tail->bottom;
+      root->right = std::move(tail);
+      root->merge(d0, rho, w);
+    }
+
+    evals = root->evals;
+    last_rows.resize(block * n);
+    for (int l = 0; l < n; l++)
+      for (int i = 0; i < block; i++) last_rows[l * block + i] = root->bottom(i, l);
+  }
+
+  template <typename T> void ArrowEigensolver<T>::eigenvectors(std::vector<T> &q, int n_vec) const
+  {
+    if (!root) errorQuda("Eigendecomposition has not been computed");
+    if (n_vec < 0 || n_vec > n) errorQuda("Requested %d eigenvectors of a %d dimensional matrix", n_vec, n);
+
+    mat_t<T> x = mat_t<T>::Identity(n, n_vec);
+    root->apply(x);
+    q.resize(n * n_vec);
+    Map<mat_t<T>>(q.data(), n, n_vec) = x;
+  }
+
+  template class ArrowEigensolver<double>;
+  template class ArrowEigensolver<Complex>;
+
+} // namespace quda
@@ -63,6 +63,14 @@ namespace quda {
 
       TuneKey tuneKey() const { return TuneKey(vol, typeid(f).name(), aux); }
 
+      bool tuneKeyParts(const char *&vol_, const char *&name, const char *&aux_) const
+      {
+        vol_ = vol;
+        name = typeid(f).name();
+        aux_ = aux;
+        return true;
+      }
+
       void apply(const qudaStream_t &stream)
       {
         constexpr bool site_unroll_check = !std::is_same<store_t, y_store_t>::value || isFixed<store_t>::value;
@@ -171,6 +179,11 @@ namespace quda {
       instantiate<axpbypczw_, Blas, false>(a, b, c, x, y, z, w, y);
     }
 
+    void axpbypcz(double a, ColorSpinorField &x, double b, ColorSpinorField &y, double c, ColorSpinorField &z)
+    {
+      instantiate<axpbypcz_, Blas, false>(a, b, c, x, y, z, z, y);
+    }
+
     void cxpaypbz(ColorSpinorField &x, const Complex &a, ColorSpinorField &y, const Complex &b, ColorSpinorField &z)
     {
       instantiate<cxpaypbz_, Blas, false>(a, b, Complex(0.0), x, y, z, x, y);
@@ -1087,12 +1087,20 @@ void printQudaGaugeSmearParam(QudaGaugeSmearParam *param)
   P(alpha, 0.0);
   P(rho, 0.0);
   P(epsilon, 0.0);
+  P(adaptive_tol, 0.0);
 #else
   P(n_steps, (unsigned int)INVALID_INT);
   P(meas_interval, (unsigned int)INVALID_INT);
   P(alpha, INVALID_DOUBLE);
   P(rho, INVALID_DOUBLE);
   P(epsilon, INVALID_DOUBLE);
+  P(adaptive_tol, INVALID_DOUBLE);
+#endif
+
+#ifdef INIT_PARAM
+  P(adaptive_n_steps, 0);
+#elif defined(PRINT_PARAM)
+  P(adaptive_n_steps, (unsigned int)INVALID_INT);
 #endif
 
 #ifdef INIT_PARAM
@@ -1,7 +1,13 @@
 #include <gauge_field_order.h>
+#include <thread_pool.h>
 
 namespace quda {
 
+  /**
+     Number of sites per parity sampled by the mini checksum
+   */
+  constexpr int mini_sites = 4096;
+
   template <typename T, QudaGaugeFieldOrder order, int Nc>
   struct ChecksumArg {
     static constexpr int nColor = Nc;
@@ -9,24 +15,50 @@ namespace quda {
     typedef typename gauge_order_mapper<T,order,Nc>::type G;
     const G U;
     const int volumeCB;
-    ChecksumArg(const GaugeField &U, bool mini) : U(U), volumeCB(mini ? 1 : U.VolumeCB()) { }
+    const int n_site; // number of sites per parity included in the checksum
+    ChecksumArg(const GaugeField &U, bool mini) :
+      U(U), volumeCB(U.VolumeCB()), n_site(mini ? std::min(static_cast<int>(U.VolumeCB()), mini_sites) : U.VolumeCB()) { }
   };
 
+  /**
+     @brief Mixing function (the splitmix64 finalizer) used to
+     decorrelate the contributions of the individual links
+   */
+  __device__ __host__ inline uint64_t mix(uint64_t x)
+  {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+  }
+
   template <typename Arg>
   __device__ __host__ inline uint64_t siteChecksum(const Arg &arg, int d, int parity, int x_cb) {
     const Matrix<complex<typename Arg::real>,Arg::nColor> u = arg.U(d, x_cb, parity);
-    return u.checksum(); 
+    // mix in the position of the link, so that exchanged or duplicated links do not cancel
+    const uint64_t index = (static_cast<uint64_t>(parity) * arg.volumeCB + x_cb) * arg.U.geometry + d;
+    return mix(u.checksum() ^ mix(index));
   }
 
+  /**
+     @brief Compute the checksum on the host.  The sites are split
+     into blocks that are checksummed concurrently over the host
+     thread pool, with the per-block values then combined.  For the
+     mini checksum the sites are sampled evenly over the local volume.
+   */
   template <typename Arg>
   uint64_t ChecksumCPU(const Arg &arg)
   {
-    uint64_t checksum_ = 0;
-    for (int parity=0; parity<2; parity++)
-      for (int x_cb=0; x_cb<arg.volumeCB; x_cb++)
-	for (int d=0; d<arg.U.geometry; d++)
-	  checksum_ ^= siteChecksum(arg, d, parity, x_cb);
-    return checksum_;
+    const int64_t n_items = 2 * static_cast<int64_t>(arg.n_site);
+    auto block = [&](uint64_t checksum_, int64_t begin, int64_t end) {
+      for (auto i = begin; i < end; i++) {
+        const int parity = i / arg.n_site;
+        const int x_cb = (i % arg.n_site) * arg.volumeCB / arg.n_site;
+        for (int d = 0; d < arg.U.geometry; d++) checksum_ ^= siteChecksum(arg, d, parity, x_cb);
+      }
+      return checksum_;
+    };
+    return host::parallel_reduce(n_items, host::launch_param_t(), uint64_t(0), block,
+                                 [](uint64_t a, uint64_t b) { return a ^ b; });
   }
 
   template <typename T, int Nc>
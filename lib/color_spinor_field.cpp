@@ -4,6 +4,7 @@
 
 #include <color_spinor_field.h>
 #include <dslash_quda.h>
+#include <timer.h>
 
 static bool zeroCopy = false;
 
@@ -1077,6 +1078,7 @@ namespace quda
                               bool spin_project, double a, double b, double c, int shmem)
   {
     if (Location() == QUDA_CPU_FIELD_LOCATION) errorQuda("Host field not supported");
+    trace_scope_t scope("halo_pack", stream);
     createComms(nFace, spin_project); // must call this first
 
     packGhost(nFace, (QudaParity)parity, dagger, stream, location, location_label, spin_project, a, b, c, shmem);
@@ -1110,6 +1112,7 @@ namespace quda
   void ColorSpinorField::gather(int dir, const qudaStream_t &stream)
   {
     if (Location() == QUDA_CPU_FIELD_LOCATION) errorQuda("Host field not supported");
+    trace_scope_t scope("halo_gather", stream);
     int dim = dir / 2;
 
     if (dir % 2 == 0) {
@@ -1265,6 +1268,7 @@ namespace quda
   void ColorSpinorField::scatter(int dim_dir, const qudaStream_t &stream)
   {
     if (Location() == QUDA_CPU_FIELD_LOCATION) errorQuda("Host field not supported");
+    trace_scope_t scope("halo_scatter", stream);
     // note this is scatter centric, so input expects dir=0 (1) is send backwards
     // (forwards) and receive from forwards (backwards), so here we need flip to receive centric
 
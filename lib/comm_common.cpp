@@ -11,8 +11,8 @@ namespace quda
 
   char *comm_hostname(void)
   {
-    static bool cached = false;
-    static char hostname[128];
+    static QUDA_COMM_LOCAL bool cached = false;
+    static QUDA_COMM_LOCAL char hostname[128];
 
     if (!cached) {
       gethostname(hostname, 128);
@@ -23,7 +23,7 @@ namespace quda
     return hostname;
   }
 
-  static unsigned long int rand_seed = 137;
+  static QUDA_COMM_LOCAL unsigned long int rand_seed = 137;
 
   /**
    * We provide our own random number generator to avoid re-seeding
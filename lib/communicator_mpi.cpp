@@ -86,6 +86,7 @@ namespace quda
   Communicator::~Communicator()
   {
     comm_finalize();
+    reproducible_free();
     if (!user_set_comm_handle) { MPI_Comm_free(&MPI_COMM_HANDLE); }
   }
 
@@ -271,6 +272,21 @@ namespace quda
     return query;
   }
 
+  void Communicator::reproducible_init()
+  {
+    if (reproducible_type != MPI_DATATYPE_NULL) return;
+    MPI_CHECK(MPI_Type_contiguous(sizeof(reproducible::accumulator_t), MPI_BYTE, &reproducible_type));
+    MPI_CHECK(MPI_Type_commit(&reproducible_type));
+    MPI_CHECK(MPI_Op_create(reproducible::mpi_sum, 1, &reproducible_op));
+  }
+
+  void Communicator::reproducible_free()
+  {
+    if (reproducible_type == MPI_DATATYPE_NULL) return;
+    MPI_CHECK(MPI_Op_free(&reproducible_op));
+    MPI_CHECK(MPI_Type_free(&reproducible_type));
+  }
+
   void Communicator::comm_allreduce_sum_array(double *data, size_t size)
   {
     if (!comm_deterministic_reduce()) {
@@ -278,16 +294,14 @@ namespace quda
       MPI_CHECK(MPI_Allreduce(data, recvbuf.data(), size, MPI_DOUBLE, MPI_SUM, MPI_COMM_HANDLE));
       memcpy(data, recvbuf.data(), size * sizeof(double));
     } else {
-      size_t n = comm_size();
-      std::vector<double> recv_buf(size * n);
-      MPI_CHECK(MPI_Allgather(data, size, MPI_DOUBLE, recv_buf.data(), size, MPI_DOUBLE, MPI_COMM_HANDLE));
-
-      std::vector<double> recv_trans(size * n);
-      for (size_t i = 0; i < n; i++) {
-        for (size_t j = 0; j < size; j++) { recv_trans[j * n + i] = recv_buf[i * size + j]; }
-      }
-
-      for (size_t i = 0; i < size; i++) { data[i] = deterministic_reduce(recv_trans.data() + i * n, n); }
+      // the partials are summed in a binned representation whose merge is exactly associative and
+      // commutative, so the result is independent of the order of the reduction tree
+      reproducible_init();
+      std::vector<reproducible::accumulator_t> send_buf(data, data + size);
+      std::vector<reproducible::accumulator_t> recv_buf(size);
+      MPI_CHECK(MPI_Allreduce(send_buf.data(), recv_buf.data(), size, reproducible_type, reproducible_op,
+                              MPI_COMM_HANDLE));
+      for (size_t i = 0; i < size; i++) data[i] = recv_buf[i].value();
     }
   }
 
@@ -326,6 +340,11 @@ namespace quda
     MPI_CHECK(MPI_Bcast(data, (int)nbytes, MPI_BYTE, 0, MPI_COMM_HANDLE));
   }
 
+  void Communicator::comm_gather(void *recv_buf, const void *send_buf, size_t nbytes)
+  {
+    MPI_CHECK(MPI_Gather(send_buf, (int)nbytes, MPI_BYTE, recv_buf, (int)nbytes, MPI_BYTE, 0, MPI_COMM_HANDLE));
+  }
+
   void Communicator::comm_barrier(void) { MPI_CHECK(MPI_Barrier(MPI_COMM_HANDLE)); }
 
   void Communicator::comm_abort_(int status) { MPI_Abort(MPI_COMM_WORLD, status); }
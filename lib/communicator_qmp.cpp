@@ -103,6 +103,7 @@ namespace quda
   Communicator::~Communicator()
   {
     comm_finalize();
+    reproducible_free();
     if (!(user_set_comm_handle || is_qmp_handle_default)) {
       // - if it's a user set handle, or if it's the default QMP handle, we don't free it.
       QMP_comm_free(QMP_COMM_HANDLE);
@@ -299,22 +300,35 @@ void Communicator::comm_wait(MsgHandle *mh) { QMP_CHECK(QMP_wait(mh->handle)); }
 
 int Communicator::comm_query(MsgHandle *mh) { return (QMP_is_complete(mh->handle) == QMP_TRUE); }
 
+void Communicator::reproducible_init()
+{
+  if (reproducible_type != MPI_DATATYPE_NULL) return;
+  MPI_CHECK(MPI_Type_contiguous(sizeof(reproducible::accumulator_t), MPI_BYTE, &reproducible_type));
+  MPI_CHECK(MPI_Type_commit(&reproducible_type));
+  MPI_CHECK(MPI_Op_create(reproducible::mpi_sum, 1, &reproducible_op));
+}
+
+void Communicator::reproducible_free()
+{
+  if (reproducible_type == MPI_DATATYPE_NULL) return;
+  MPI_CHECK(MPI_Op_free(&reproducible_op));
+  MPI_CHECK(MPI_Type_free(&reproducible_type));
+}
+
 void Communicator::comm_allreduce_sum_array(double *data, size_t size)
 {
   if (!comm_deterministic_reduce()) {
     QMP_CHECK(QMP_comm_sum_double_array(QMP_COMM_HANDLE, data, size));
   } else {
     // we need to break out of QMP for the deterministic floating point reductions
-    size_t n = comm_size();
-    std::vector<double> recv_buf(size * n);
-    MPI_CHECK(MPI_Allgather(data, size, MPI_DOUBLE, recv_buf.data(), size, MPI_DOUBLE, MPI_COMM_HANDLE));
-
-    std::vector<double> recv_trans(size * n);
-    for (size_t i = 0; i < n; i++) {
-      for (size_t j = 0; j < size; j++) { recv_trans[j * n + i] = recv_buf[i * size + j]; }
-    }
-
-    for (size_t i = 0; i < size; i++) { data[i] = deterministic_reduce(recv_trans.data() + i * n, n); }
+    // the partials are summed in a binned representation whose merge is exactly associative and
+    // commutative, so the result is independent of the order of the reduction tree
+    reproducible_init();
+    std::vector<reproducible::accumulator_t> send_buf(data, data + size);
+    std::vector<reproducible::accumulator_t> recv_buf(size);
+    MPI_CHECK(MPI_Allreduce(send_buf.data(), recv_buf.data(), size, reproducible_type, reproducible_op,
+                            MPI_COMM_HANDLE));
+    for (size_t i = 0; i < size; i++) data[i] = recv_buf[i].value();
   }
 }
 
@@ -341,6 +355,12 @@ void Communicator::comm_broadcast(void *data, size_t nbytes)
   QMP_CHECK(QMP_comm_broadcast(QMP_COMM_HANDLE, data, nbytes));
 }
 
+void Communicator::comm_gather(void *recv_buf, const void *send_buf, size_t nbytes)
+{
+  // QMP has no gather, so we break out to MPI as for the all-gathers above
+  MPI_CHECK(MPI_Gather(send_buf, (int)nbytes, MPI_BYTE, recv_buf, (int)nbytes, MPI_BYTE, 0, MPI_COMM_HANDLE));
+}
+
 void Communicator::comm_barrier(void) { QMP_CHECK(QMP_comm_barrier(QMP_COMM_HANDLE)); }
 
 void Communicator::comm_abort_(int status) { QMP_abort(status); }
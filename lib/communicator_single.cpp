@@ -93,6 +93,11 @@ namespace quda
 
   void Communicator::comm_broadcast(void *, size_t) { }
 
+  void Communicator::comm_gather(void *recv_buf, const void *send_buf, size_t nbytes)
+  {
+    memcpy(recv_buf, send_buf, nbytes);
+  }
+
   void Communicator::comm_barrier(void) { }
 
   void Communicator::comm_abort_(int status) { exit(status); }
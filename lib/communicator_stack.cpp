@@ -2,15 +2,16 @@
 #include <map>
 #include <array.h>
 #include <lattice_field.h>
+#include <timer.h>
 
 namespace quda
 {
 
-  int Communicator::gpuid = -1;
+  QUDA_COMM_LOCAL int Communicator::gpuid = -1;
 
-  static std::map<CommKey, Communicator> communicator_stack;
+  static QUDA_COMM_LOCAL std::map<CommKey, Communicator> communicator_stack;
 
-  static CommKey current_key = {-1, -1, -1, -1};
+  static QUDA_COMM_LOCAL CommKey current_key = {-1, -1, -1, -1};
 
   void init_communicator_stack(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data,
                                bool user_set_comm_handle, void *user_comm)
@@ -177,6 +178,7 @@ namespace quda
 
   void comm_allreduce_sum_array(double *data, size_t size)
   {
+    trace_scope_t scope("allreduce");
     get_current_communicator().comm_allreduce_sum_array(data, size);
   }
 
@@ -214,6 +216,7 @@ namespace quda
 
   void comm_allreduce_max_array(double *data, size_t size)
   {
+    trace_scope_t scope("allreduce");
     get_current_communicator().comm_allreduce_max_array(data, size);
   }
 
@@ -246,6 +249,7 @@ namespace quda
 
   void comm_allreduce_min_array(double *data, size_t size)
   {
+    trace_scope_t scope("allreduce");
     get_current_communicator().comm_allreduce_min_array(data, size);
   }
 
@@ -270,6 +274,13 @@ namespace quda
 
   void comm_broadcast_global(void *data, size_t nbytes) { get_default_communicator().comm_broadcast(data, nbytes); }
 
+  void comm_gather_global(void *recv_buf, const void *send_buf, size_t nbytes)
+  {
+    get_default_communicator().comm_gather(recv_buf, send_buf, nbytes);
+  }
+
+  size_t comm_size_global() { return get_default_communicator().comm_size(); }
+
   void comm_barrier(void) { get_current_communicator().comm_barrier(); }
 
   void comm_abort_(int status) { Communicator::comm_abort_(status); };
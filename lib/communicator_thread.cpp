@@ -0,0 +1,530 @@
+/**
+ * In-process communications layer, where each rank is a thread of the
+ * same process.  Ranks are started with comm_thread_launch, and all
+ * communication goes through shared memory: a receive copies directly
+ * from the buffer posted by the matching send, so messages are never
+ * staged through intermediate buffers.
+ *
+ * This backend covers the comms layer only (point-to-point, collectives
+ * and split communicators).  The device, tuning and field state of
+ * QUDA remain per-process, so initQuda is rejected when more than one
+ * rank thread is present, and split_field/join_field, the Dirac
+ * operators and the comms-overlap dslash policies cannot be run with
+ * it.  Making that state per-rank is a separate piece of work.
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <string.h>
+
+#include <communicator_quda.h>
+
+namespace quda
+{
+
+  /**
+     A message posted by comm_start on a send handle, which remains
+     valid until it has been consumed by the matching receive.
+   */
+  struct message_t {
+    const char *buffer;
+    size_t blksize;
+    int nblocks;
+    size_t stride;
+    bool done;
+  };
+
+  using channel_key_t = std::tuple<int, int, int>; // (source rank, destination rank, tag)
+
+  /**
+     A group of rank threads, which plays the role of an MPI
+     communicator.  All state is protected by the group mutex.
+   */
+  struct comm_group_t {
+    const int size;
+    const bool world; // whether this is a world group, which is owned by the launcher rather than its communicators
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    int arrived = 0;         // number of ranks that have arrived at the current barrier
+    uint64_t generation = 0; // number of barriers completed
+    int n_ref;               // number of communicators that presently reference the group
+
+    std::vector<const void *> slot;                       // per-rank buffers exposed during a collective
+    std::map<channel_key_t, std::deque<message_t *>> channel; // posted sends that are yet to be received
+
+    comm_group_t(int size, bool world = false) : size(size), world(world), n_ref(size), slot(size) { }
+
+    void barrier()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      const auto gen = generation;
+      if (++arrived == size) {
+        arrived = 0;
+        generation++;
+        cv.notify_all();
+      } else {
+        cv.wait(lock, [&] { return generation != gen; });
+      }
+    }
+
+    /**
+       @brief Expose a buffer from each rank to all other ranks.  Upon
+       return, slot[r] holds the buffer of rank r, and these remain
+       valid until release is called.
+     */
+    void expose(int rank, const void *buffer)
+    {
+      slot[rank] = buffer;
+      barrier();
+    }
+
+    /**
+       @brief Wait until all ranks are done with the exposed buffers
+     */
+    void release() { barrier(); }
+  };
+
+  struct MsgHandle_s {
+    comm_group_t *group;
+    channel_key_t key;
+    bool send;
+
+    char *buffer;
+    size_t blksize;
+    int nblocks;
+    size_t stride;
+
+    message_t msg;  // the message posted by a send
+    bool received; // whether a receive has completed since it was last started
+  };
+
+  /**
+     The world group and rank of the calling thread, set by
+     comm_thread_launch.  Threads that were not launched as ranks
+     form a single-rank world.
+   */
+  static thread_local comm_group_t *thread_world = nullptr;
+  static thread_local int thread_rank = 0;
+
+  static comm_group_t *get_world()
+  {
+    static comm_group_t single(1, true);
+    return thread_world ? thread_world : &single;
+  }
+
+  void comm_thread_launch(int n_rank, void (*fn)(int rank, void *arg), void *arg)
+  {
+    if (thread_world) errorQuda("Cannot launch ranks from a rank thread");
+    if (n_rank < 1) errorQuda("Invalid number of ranks %d", n_rank);
+
+    comm_group_t world(n_rank, true);
+    std::vector<std::thread> threads;
+    threads.reserve(n_rank);
+    for (int r = 0; r < n_rank; r++) {
+      threads.emplace_back([&world, r, fn, arg]() {
+        thread_world = &world;
+        thread_rank = r;
+        fn(r, arg);
+        thread_world = nullptr;
+        thread_rank = 0;
+      });
+    }
+    for (auto &t : threads) t.join();
+  }
+
+  /**
+     @brief Copy between two buffers described as nblocks blocks of
+     blksize bytes separated by stride bytes.  The layouts may differ
+     provided the total message size is the same.
+   */
+  static void copy_message(char *dst, size_t dst_blksize, int dst_nblocks, size_t dst_stride, const char *src,
+                           size_t src_blksize, int src_nblocks, size_t src_stride)
+  {
+    const size_t bytes = dst_blksize * dst_nblocks;
+    if (bytes != src_blksize * src_nblocks)
+      errorQuda("Message size mismatch: receiving %lu bytes but %lu bytes were sent", bytes, src_blksize * src_nblocks);
+    if (bytes == 0) return;
+
+    if (dst_nblocks == 1 && src_nblocks == 1) {
+      memcpy(dst, src, bytes);
+      return;
+    }
+
+    size_t dst_offset = 0, src_offset = 0;
+    int dst_block = 0, src_block = 0;
+    while (dst_block < dst_nblocks) {
+      size_t n = std::min(dst_blksize - dst_offset, src_blksize - src_offset);
+      memcpy(dst + dst_block * dst_stride + dst_offset, src + src_block * src_stride + src_offset, n);
+      dst_offset += n;
+      src_offset += n;
+      if (dst_offset == dst_blksize) {
+        dst_offset = 0;
+        dst_block++;
+      }
+      if (src_offset == src_blksize) {
+        src_offset = 0;
+        src_block++;
+      }
+    }
+  }
+
+  static int displacement_tag(const int displacement[], int ndim, int sign)
+  {
+    int tag = 0;
+    for (int i = ndim - 1; i >= 0; i--) tag = tag * 4 * max_displacement + sign * displacement[i] + max_displacement;
+    return tag >= 0 ? tag : 2 * pow(4 * max_displacement, ndim) + tag;
+  }
+
+  static MsgHandle *declare_message(comm_group_t *group, bool send, int src, int dst, int tag, void *buffer,
+                                    size_t blksize, int nblocks, size_t stride)
+  {
+    MsgHandle *mh = new MsgHandle;
+    mh->group = group;
+    mh->key = channel_key_t(src, dst, tag);
+    mh->send = send;
+    mh->buffer = static_cast<char *>(buffer);
+    mh->blksize = blksize;
+    mh->nblocks = nblocks;
+    mh->stride = stride;
+    mh->msg = {mh->buffer, blksize, nblocks, stride, true};
+    mh->received = true;
+    return mh;
+  }
+
+  Communicator::Communicator(int nDim, const int *commDims, QudaCommsMap rank_from_coords, void *map_data,
+                             bool user_set_comm_handle_, void *)
+  {
+    if (user_set_comm_handle_) errorQuda("User-provided communicator handles are not supported with thread comms");
+    user_set_comm_handle = false;
+    group = get_world();
+
+    comm_init(nDim, commDims, rank_from_coords, map_data);
+    globalReduce.push(true);
+  }
+
+  Communicator::Communicator(Communicator &other, const int *comm_split) : globalReduce(other.globalReduce)
+  {
+    user_set_comm_handle = false;
+
+    constexpr int nDim = 4;
+
+    CommKey comm_dims_split;
+    CommKey comm_key_split;
+    CommKey comm_color_split;
+
+    for (int d = 0; d < nDim; d++) {
+      assert(other.comm_dim(d) % comm_split[d] == 0);
+      comm_dims_split[d] = other.comm_dim(d) / comm_split[d];
+      comm_key_split[d] = other.comm_coord(d) % comm_dims_split[d];
+      comm_color_split[d] = other.comm_coord(d) / comm_dims_split[d];
+    }
+
+    int key = index(nDim, comm_dims_split.data(), comm_key_split.data());
+    int color = index(nDim, comm_split, comm_color_split.data());
+
+    // the equivalent of MPI_Comm_split: ranks are ordered by key, and ties are broken by the parent rank
+    comm_group_t *parent = other.group;
+    int my_color_key[2] = {color, key};
+    std::vector<int> color_key(2 * parent->size);
+    parent->expose(other.rank, my_color_key);
+    for (int r = 0; r < parent->size; r++) memcpy(&color_key[2 * r], parent->slot[r], 2 * sizeof(int));
+    parent->release();
+
+    int leader = -1;
+    int split_size = 0;
+    int split_rank = 0;
+    for (int r = 0; r < parent->size; r++) {
+      if (color_key[2 * r] != color) continue;
+      if (leader < 0) leader = r;
+      split_size++;
+      if (color_key[2 * r + 1] < key || (color_key[2 * r + 1] == key && r < other.rank)) split_rank++;
+    }
+
+    // the lowest parent rank of each color creates the group and shares it with the others
+    comm_group_t *split = other.rank == leader ? new comm_group_t(split_size) : nullptr;
+    parent->expose(other.rank, split);
+    group = static_cast<comm_group_t *>(const_cast<void *>(parent->slot[leader]));
+    parent->release();
+    rank = split_rank;
+
+    QudaCommsMap func = lex_rank_from_coords_dim_t;
+    comm_init(nDim, comm_dims_split.data(), func, comm_dims_split.data());
+  }
+
+  Communicator::~Communicator()
+  {
+    comm_finalize();
+    if (group && !group->world) {
+      // freeing a split communicator is collective, as with MPI_Comm_free
+      group->barrier();
+      bool last;
+      {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        last = --group->n_ref == 0;
+      }
+      if (last) delete group;
+    }
+    group = nullptr;
+  }
+
+  void Communicator::comm_gather_hostname(char *hostname_recv_buf)
+  {
+    // every rank presents itself as a distinct node, so that each
+    // rank defaults to the first device, and inter-process
+    // peer-to-peer handles are never exchanged between threads
+    char hostname[128];
+    snprintf(hostname, 128, "%s/rank%d", comm_hostname(), comm_rank_global());
+    group->expose(rank, hostname);
+    for (int r = 0; r < group->size; r++) memcpy(&hostname_recv_buf[128 * r], group->slot[r], 128);
+    group->release();
+  }
+
+  void Communicator::comm_gather_gpuid(int *gpuid_recv_buf)
+  {
+    int gpuid = comm_gpuid();
+    group->expose(rank, &gpuid);
+    for (int r = 0; r < group->size; r++) gpuid_recv_buf[r] = *static_cast<const int *>(group->slot[r]);
+    group->release();
+  }
+
+  void Communicator::comm_init(int ndim, const int *dims, QudaCommsMap rank_from_coords, void *map_data)
+  {
+    if (group->world) rank = thread_rank;
+    size = group->size;
+
+    int grid_size = 1;
+    for (int i = 0; i < ndim; i++) { grid_size *= dims[i]; }
+    if (grid_size != size) {
+      errorQuda("Communication grid size declared via initCommsGridQuda() does not match"
+                " total number of thread ranks (%d != %d)",
+                grid_size, size);
+    }
+
+    // messages are copied with memcpy, so halo buffers must reside in host memory
+    if (comm_gdr_enabled()) errorQuda("GPU-Direct RDMA is not supported with thread comms (set QUDA_ENABLE_GDR=0)");
+
+    comm_init_common(ndim, dims, rank_from_coords, map_data);
+  }
+
+  int Communicator::comm_rank(void) { return rank; }
+
+  size_t Communicator::comm_size(void) { return size; }
+
+  MsgHandle *Communicator::comm_declare_send_rank(void *buffer, int rank, int tag, size_t nbytes)
+  {
+    return declare_message(group, true, this->rank, rank, tag, buffer, nbytes, 1, nbytes);
+  }
+
+  MsgHandle *Communicator::comm_declare_recv_rank(void *buffer, int rank, int tag, size_t nbytes)
+  {
+    return declare_message(group, false, rank, this->rank, tag, buffer, nbytes, 1, nbytes);
+  }
+
+  MsgHandle *Communicator::comm_declare_send_displaced(void *buffer, const int displacement[], size_t nbytes)
+  {
+    Topology *topo = comm_default_topology();
+    int ndim = comm_ndim(topo);
+    check_displacement(displacement, ndim);
+
+    int rank = comm_rank_displaced(topo, displacement);
+    int tag = displacement_tag(displacement, ndim, +1);
+    return declare_message(group, true, this->rank, rank, tag, buffer, nbytes, 1, nbytes);
+  }
+
+  MsgHandle *Communicator::comm_declare_receive_displaced(void *buffer, const int displacement[], size_t nbytes)
+  {
+    Topology *topo = comm_default_topology();
+    int ndim = comm_ndim(topo);
+    check_displacement(displacement, ndim);
+
+    int rank = comm_rank_displaced(topo, displacement);
+    int tag = displacement_tag(displacement, ndim, -1);
+    return declare_message(group, false, rank, this->rank, tag, buffer, nbytes, 1, nbytes);
+  }
+
+  MsgHandle *Communicator::comm_declare_strided_send_displaced(void *buffer, const int displacement[], size_t blksize,
+                                                               int nblocks, size_t stride)
+  {
+    Topology *topo = comm_default_topology();
+    int ndim = comm_ndim(topo);
+    check_displacement(displacement, ndim);
+
+    int rank = comm_rank_displaced(topo, displacement);
+    int tag = displacement_tag(displacement, ndim, +1);
+    return declare_message(group, true, this->rank, rank, tag, buffer, blksize, nblocks, stride);
+  }
+
+  MsgHandle *Communicator::comm_declare_strided_receive_displaced(void *buffer, const int displacement[],
+                                                                  size_t blksize, int nblocks, size_t stride)
+  {
+    Topology *topo = comm_default_topology();
+    int ndim = comm_ndim(topo);
+    check_displacement(displacement, ndim);
+
+    int rank = comm_rank_displaced(topo, displacement);
+    int tag = displacement_tag(displacement, ndim, -1);
+    return declare_message(group, false, rank, this->rank, tag, buffer, blksize, nblocks, stride);
+  }
+
+  void Communicator::comm_free(MsgHandle *&mh)
+  {
+    delete mh;
+    mh = nullptr;
+  }
+
+  void Communicator::comm_start(MsgHandle *mh)
+  {
+    if (mh->send) {
+      std::lock_guard<std::mutex> lock(mh->group->mutex);
+      mh->msg.done = false;
+      mh->group->channel[mh->key].push_back(&mh->msg);
+      mh->group->cv.notify_all();
+    } else {
+      mh->received = false;
+    }
+  }
+
+  /**
+     @brief Receive the oldest message posted on the channel of a
+     receive handle, copying it directly from the sender's buffer.
+     @param[in] mh The receive handle
+     @param[in] block Whether to wait for a message to be posted
+     @return Whether the receive has completed
+   */
+  static bool receive(MsgHandle *mh, bool block)
+  {
+    if (mh->received) return true;
+    auto &group = *mh->group;
+
+    message_t *msg;
+    {
+      std::unique_lock<std::mutex> lock(group.mutex);
+      auto &queue = group.channel[mh->key];
+      if (block)
+        group.cv.wait(lock, [&] { return !queue.empty(); });
+      else if (queue.empty())
+        return false;
+      msg = queue.front();
+      queue.pop_front();
+    }
+
+    copy_message(mh->buffer, mh->blksize, mh->nblocks, mh->stride, msg->buffer, msg->blksize, msg->nblocks, msg->stride);
+
+    std::lock_guard<std::mutex> lock(group.mutex);
+    msg->done = true;
+    group.cv.notify_all();
+    mh->received = true;
+    return true;
+  }
+
+  void Communicator::comm_wait(MsgHandle *mh)
+  {
+    if (mh->send) {
+      std::unique_lock<std::mutex> lock(mh->group->mutex);
+      mh->group->cv.wait(lock, [&] { return mh->msg.done; });
+    } else {
+      receive(mh, true);
+    }
+  }
+
+  int Communicator::comm_query(MsgHandle *mh)
+  {
+    if (mh->send) {
+      std::lock_guard<std::mutex> lock(mh->group->mutex);
+      return mh->msg.done;
+    } else {
+      return receive(mh, false);
+    }
+  }
+
+  /**
+     @brief Reduce an array over all ranks of a group.  Every rank
+     combines the contributions in rank order, so all ranks obtain a
+     bitwise identical result.
+   */
+  template <typename T, typename Combine>
+  static void allreduce(comm_group_t &group, int rank, T *data, size_t size, Combine combine)
+  {
+    std::vector<T> result(data, data + size);
+    group.expose(rank, data);
+    for (int r = 0; r < group.size; r++) {
+      if (r == 0) {
+        memcpy(result.data(), group.slot[r], size * sizeof(T));
+        continue;
+      }
+      auto in = static_cast<const T *>(group.slot[r]);
+      for (size_t i = 0; i < size; i++) result[i] = combine(result[i], in[i]);
+    }
+    group.release();
+    memcpy(data, result.data(), size * sizeof(T));
+  }
+
+  void Communicator::comm_allreduce_sum_array(double *data, size_t size)
+  {
+    if (!comm_deterministic_reduce()) {
+      allreduce(*group, rank, data, size, [](double a, double b) { return a + b; });
+    } else {
+      // use the same binned summation as the other backends, so results match regardless of the backend used
+      std::vector<reproducible::accumulator_t> sum(data, data + size);
+      group->expose(rank, sum.data());
+      std::vector<reproducible::accumulator_t> result(size);
+      for (int r = 0; r < group->size; r++) {
+        auto in = static_cast<const reproducible::accumulator_t *>(group->slot[r]);
+        for (size_t i = 0; i < size; i++) result[i].merge(in[i]);
+      }
+      group->release();
+      for (size_t i = 0; i < size; i++) data[i] = result[i].value();
+    }
+  }
+
+  void Communicator::comm_allreduce_max_array(double *data, size_t size)
+  {
+    allreduce(*group, rank, data, size, [](double a, double b) { return std::max(a, b); });
+  }
+
+  void Communicator::comm_allreduce_min_array(double *data, size_t size)
+  {
+    allreduce(*group, rank, data, size, [](double a, double b) { return std::min(a, b); });
+  }
+
+  void Communicator::comm_allreduce_int(int &data)
+  {
+    allreduce(*group, rank, &data, 1, [](int a, int b) { return a + b; });
+  }
+
+  void Communicator::comm_allreduce_xor(uint64_t &data)
+  {
+    allreduce(*group, rank, &data, 1, [](uint64_t a, uint64_t b) { return a ^ b; });
+  }
+
+  /**  broadcast from rank 0 */
+  void Communicator::comm_broadcast(void *data, size_t nbytes)
+  {
+    group->expose(rank, data);
+    if (rank != 0) memcpy(data, group->slot[0], nbytes);
+    group->release();
+  }
+
+  void Communicator::comm_gather(void *recv_buf, const void *send_buf, size_t nbytes)
+  {
+    group->expose(rank, send_buf);
+    if (rank == 0) {
+      for (int r = 0; r < group->size; r++) memcpy(static_cast<char *>(recv_buf) + r * nbytes, group->slot[r], nbytes);
+    }
+    group->release();
+  }
+
+  void Communicator::comm_barrier(void) { group->barrier(); }
+
+  void Communicator::comm_abort_(int status) { exit(status); }
+
+  int Communicator::comm_rank_global() { return thread_rank; }
+
+} // namespace quda
@@ -1,5 +1,5 @@
 #include <deflation.h>
-#include <qio_field.h>
+#include <vector_io.h>
 #include <string.h>
 
 #include <memory>
@@ -26,7 +26,8 @@ namespace quda
     // for reporting level 1 is the fine level but internally use level 0 for indexing
     printfQuda("Creating deflation space of %d vectors.\n", param.tot_dim);
 
-    if (param.eig_global.import_vectors) loadVectors(param.RV); // whether to load eigenvectors
+    // whether to load eigenvectors, with the projection if it was saved with them
+    if (param.eig_global.import_vectors && !loadSpace()) loadVectors(param.RV);
     // create aux fields
     ColorSpinorParam csParam(param.RV->Component(0));
     csParam.create = QUDA_ZERO_FIELD_CREATE;
@@ -319,7 +320,7 @@ if( param.eig_global.extlib_type == QUDA_EIGEN_EXTLIB ) {
   //supports seperate reading or single file read
   void Deflation::loadVectors(ColorSpinorField *RV)
   {
-    if (RV->IsComposite()) errorQuda("Not a composite field");
+    if (!RV->IsComposite()) errorQuda("Not a composite field");
 
     profile.TPSTOP(QUDA_PROFILE_INIT);
     profile.TPSTART(QUDA_PROFILE_IO);
@@ -327,33 +328,22 @@ if( param.eig_global.extlib_type == QUDA_EIGEN_EXTLIB ) {
     std::string vec_infile(param.eig_global.vec_infile);
     std::vector<ColorSpinorField *> &B = RV->Components();
 
-    const int Nvec = B.size();
-    printfQuda("Start loading %d vectors from %s\n", Nvec, vec_infile.c_str());
+    if (strcmp(vec_infile.c_str(), "") == 0) errorQuda("No eigenspace file defined");
 
-    void **V = new void*[Nvec];
-    for (int i = 0; i < Nvec; i++) {
-      V[i] = B[i]->V();
-      if (V[i] == NULL) {
-	printfQuda("Could not allocate V[%d]\n", i);
-      }
-    }
+    // assumes even parity if a single-parity field...
+    for (auto &b : B)
+      if (b->SiteSubset() == QUDA_PARITY_SITE_SUBSET) b->setSuggestedParity(QUDA_EVEN_PARITY);
 
-    if (strcmp(vec_infile.c_str(),"")!=0) {
-      auto parity = (B[0]->SiteSubset() == QUDA_FULL_SITE_SUBSET ? QUDA_INVALID_PARITY : QUDA_EVEN_PARITY);
-      read_spinor_field(vec_infile.c_str(), &V[0], B[0]->Precision(), B[0]->X(), B[0]->SiteSubset(), parity,
-                        B[0]->Ncolor(), B[0]->Nspin(), Nvec, 0, (char **)0);
-    } else {
-      errorQuda("No eigenspace file defined");
-    }
+    VectorIO io(vec_infile);
+    io.load(B);
 
-    printfQuda("Done loading vectors\n");
     profile.TPSTOP(QUDA_PROFILE_IO);
     profile.TPSTART(QUDA_PROFILE_INIT);
   }
 
   void Deflation::saveVectors(ColorSpinorField *RV)
   {
-    if (RV->IsComposite()) errorQuda("Not a composite field");
+    if (!RV->IsComposite()) errorQuda("Not a composite field");
 
     profile.TPSTOP(QUDA_PROFILE_INIT);
     profile.TPSTART(QUDA_PROFILE_IO);
@@ -362,28 +352,139 @@ if( param.eig_global.extlib_type == QUDA_EIGEN_EXTLIB ) {
     std::vector<ColorSpinorField*> &B = RV->Components();
 
     if (strcmp(param.eig_global.vec_outfile,"")!=0) {
-      const int Nvec = B.size();
-      printfQuda("Start saving %d vectors to %s\n", Nvec, vec_outfile.c_str());
-
-      void **V = static_cast<void**>(safe_malloc(Nvec*sizeof(void*)));
-      for (int i=0; i<Nvec; i++) {
-	V[i] = B[i]->V();
-	if (V[i] == NULL) {
-	  printfQuda("Could not allocate V[%d]\n", i);
-	}
-      }
-
       // assumes even parity if a single-parity field...
-      auto parity = (B[0]->SiteSubset() == QUDA_FULL_SITE_SUBSET ? QUDA_INVALID_PARITY : QUDA_EVEN_PARITY);
-      write_spinor_field(vec_outfile.c_str(), &V[0], B[0]->Precision(), B[0]->X(), B[0]->SiteSubset(), parity,
-                         B[0]->Ncolor(), B[0]->Nspin(), Nvec, 0, (char **)0);
+      for (auto &b : B)
+        if (b->SiteSubset() == QUDA_PARITY_SITE_SUBSET) b->setSuggestedParity(QUDA_EVEN_PARITY);
+
+      VectorIO io(vec_outfile);
+      io.save(B);
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_IO);
+    profile.TPSTART(QUDA_PROFILE_INIT);
+  }
+
+  /**
+     Header of the file holding the projection state of a saved
+     deflation space, followed by the cur_dim inverse Ritz values and
+     the cur_dim x cur_dim projection matrix stored row by row.
+   */
+  struct deflation_file_header_t {
+    char magic[8];         // identifies the file format and version
+    uint32_t byte_order;   // byte_order_marker as seen by the writer
+    int32_t cur_dim;       // current dimension of the space
+    int32_t tot_dim;       // full dimension of the space
+    int32_t use_inv_ritz;  // whether the space deflates with the inverse Ritz values
+  };
+
+  static constexpr char deflation_file_magic[8] = {'Q', 'U', 'D', 'A', 'D', 'E', 'F', '1'};
+  static constexpr uint32_t byte_order_marker = 0x01020304;
+
+  void Deflation::saveSpace()
+  {
+    if (strcmp(param.eig_global.vec_outfile, "") == 0) errorQuda("No eigenspace file defined");
+    if (param.cur_dim == 0) errorQuda("Cannot save an empty deflation space");
+
+    profile.TPSTART(QUDA_PROFILE_IO);
 
-      host_free(V);
-      printfQuda("Done saving vectors\n");
+    const std::string vec_outfile(param.eig_global.vec_outfile);
+    std::vector<ColorSpinorField *> B(param.RV->Components().begin(), param.RV->Components().begin() + param.cur_dim);
+    // assumes even parity if a single-parity field...
+    for (auto &b : B)
+      if (b->SiteSubset() == QUDA_PARITY_SITE_SUBSET) b->setSuggestedParity(QUDA_EVEN_PARITY);
+
+    VectorIO io(vec_outfile);
+    io.save(B);
+
+    if (comm_rank() == 0) {
+      const std::string proj_file = vec_outfile + ".proj";
+      FILE *f = fopen(proj_file.c_str(), "wb");
+      if (!f) errorQuda("Failed to open %s for writing", proj_file.c_str());
+
+      deflation_file_header_t header = {};
+      memcpy(header.magic, deflation_file_magic, sizeof(header.magic));
+      header.byte_order = byte_order_marker;
+      header.cur_dim = param.cur_dim;
+      header.tot_dim = param.tot_dim;
+      header.use_inv_ritz = param.use_inv_ritz;
+
+      bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+      ok = ok && fwrite(param.invRitzVals, sizeof(double), param.cur_dim, f) == static_cast<size_t>(param.cur_dim);
+      for (int i = 0; i < param.cur_dim; i++)
+        ok = ok
+          && fwrite(&param.matProj[i * param.ld], sizeof(Complex), param.cur_dim, f) == static_cast<size_t>(param.cur_dim);
+      if (fclose(f) != 0 || !ok) errorQuda("Failed to write %s", proj_file.c_str());
     }
 
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Saved deflation space of %d vectors to %s\n", param.cur_dim, vec_outfile.c_str());
+
+    profile.TPSTOP(QUDA_PROFILE_IO);
+  }
+
+  bool Deflation::loadSpace()
+  {
+    const std::string vec_infile(param.eig_global.vec_infile);
+    const std::string proj_file = vec_infile + ".proj";
+    if (strcmp(vec_infile.c_str(), "") == 0) errorQuda("No eigenspace file defined");
+
+    // rank 0 reads the projection state and broadcasts it, so every rank agrees on whether it exists
+    deflation_file_header_t header = {};
+    int found = 0;
+    FILE *f = nullptr;
+    if (comm_rank() == 0) {
+      f = fopen(proj_file.c_str(), "rb");
+      found = f && fread(&header, sizeof(header), 1, f) == 1
+        && memcmp(header.magic, deflation_file_magic, sizeof(header.magic)) == 0;
+      if (f && !found) errorQuda("%s is not a QUDA deflation projection file", proj_file.c_str());
+    }
+    comm_broadcast(&found, sizeof(found));
+    if (!found) return false;
+
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+    profile.TPSTART(QUDA_PROFILE_IO);
+
+    comm_broadcast(&header, sizeof(header));
+    if (header.byte_order != byte_order_marker) errorQuda("%s was written with a different byte order", proj_file.c_str());
+    if (header.cur_dim < 1 || header.cur_dim > header.tot_dim) errorQuda("Invalid dimensions in %s", proj_file.c_str());
+    // the requested dimension is kept: a smaller saved space is loaded and may continue to grow
+    if (header.tot_dim > param.tot_dim || header.tot_dim > param.RV->CompositeDim())
+      errorQuda("Deflation space in %s of dimension %d exceeds the requested dimension %d", proj_file.c_str(),
+                header.tot_dim, std::min(param.tot_dim, param.RV->CompositeDim()));
+
+    const int n = header.cur_dim;
+    std::vector<double> inv_ritz(n);
+    std::vector<Complex> proj(n * n);
+    if (comm_rank() == 0) {
+      bool ok = fread(inv_ritz.data(), sizeof(double), n, f) == static_cast<size_t>(n);
+      ok = ok && fread(proj.data(), sizeof(Complex), n * n, f) == static_cast<size_t>(n * n);
+      fclose(f);
+      if (!ok) errorQuda("Failed to read %s", proj_file.c_str());
+    }
+    comm_broadcast(inv_ritz.data(), n * sizeof(double));
+    comm_broadcast(proj.data(), n * n * sizeof(Complex));
+
+    std::vector<ColorSpinorField *> B(param.RV->Components().begin(), param.RV->Components().begin() + n);
+    // assumes even parity if a single-parity field...
+    for (auto &b : B)
+      if (b->SiteSubset() == QUDA_PARITY_SITE_SUBSET) b->setSuggestedParity(QUDA_EVEN_PARITY);
+
+    VectorIO io(vec_infile);
+    io.load(B);
+
+    for (int i = 0; i < n; i++) {
+      param.invRitzVals[i] = inv_ritz[i];
+      memcpy(&param.matProj[i * param.ld], &proj[i * n], n * sizeof(Complex));
+    }
+    param.cur_dim = n;
+    param.use_inv_ritz = header.use_inv_ritz;
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Loaded deflation space of %d vectors from %s\n", param.cur_dim, vec_infile.c_str());
+
     profile.TPSTOP(QUDA_PROFILE_IO);
     profile.TPSTART(QUDA_PROFILE_INIT);
+    return true;
   }
 
 } // namespace quda
@@ -316,4 +316,83 @@ namespace quda {
     if (tmp2) tmp2->prefetch(mem_space, stream);
   }
 
+  DiracChebyshev::DiracChebyshev(const DiracMatrix &mat, int degree, double a_min, double a_max) :
+    DiracMatrix(mat), mat(mat)
+  {
+    setPolynomial(degree, a_min, a_max);
+  }
+
+  void DiracChebyshev::setPolynomial(int degree, double a_min, double a_max)
+  {
+    if (degree < 1) errorQuda("Invalid Chebyshev polynomial degree %d", degree);
+    if (a_max <= a_min || a_max + a_min == 0.0) errorQuda("Invalid Chebyshev interval [%e, %e]", a_min, a_max);
+    this->degree = degree;
+    this->a_min = a_min;
+    this->a_max = a_max;
+  }
+
+  void DiracChebyshev::createWork(const ColorSpinorField &field, int n_work) const
+  {
+    for (int i = 0; i < n_work; i++) {
+      if (!work[i] || work[i]->Location() != field.Location() || work[i]->Precision() != field.Precision()
+          || work[i]->Length() != field.Length()) {
+        ColorSpinorParam param(field);
+        param.create = QUDA_NULL_FIELD_CREATE;
+        work[i] = std::make_unique<ColorSpinorField>(param);
+      }
+    }
+  }
+
+  template <typename MatVec>
+  void DiracChebyshev::apply(ColorSpinorField &out, const ColorSpinorField &in, const MatVec &matVec) const
+  {
+    if (&out == &in) errorQuda("Chebyshev polynomial cannot be applied in place");
+
+    const double delta = (a_max - a_min) / 2.0;
+    const double theta = (a_max + a_min) / 2.0;
+    const double sigma1 = -delta / theta;
+
+    // C_k is held in buffer (degree - k) % 3, so C_degree is written to out
+    createWork(in, std::min(degree - 1, 2));
+    ColorSpinorField *buffer[3] = {&out, work[0].get(), work[1].get()};
+    auto C = [&](int k) -> ColorSpinorField & {
+      return k == 0 ? const_cast<ColorSpinorField &>(in) : *buffer[(degree - k) % 3];
+    };
+
+    // C_1(x) = d1 * x + d2, with d1 = sigma1 / delta and d2 = 1
+    matVec(C(1), C(0));
+    blas::axpby(1.0, C(0), sigma1 / delta, C(1));
+
+    // C_{k+1}(x) = d1 * x * C_k(x) + d2 * C_k(x) + d3 * C_{k-1}(x), where the
+    // update is accumulated in place into the operator output
+    double sigma_old = sigma1;
+    for (int k = 1; k < degree; k++) {
+      const double sigma = 1.0 / (2.0 / sigma1 - sigma_old);
+      const double d1 = 2.0 * sigma / delta;
+      const double d2 = -d1 * theta;
+      const double d3 = -sigma * sigma_old;
+
+      matVec(C(k + 1), C(k));
+      blas::axpbypcz(d3, C(k - 1), d2, C(k), d1, C(k + 1));
+
+      sigma_old = sigma;
+    }
+  }
+
+  void DiracChebyshev::operator()(ColorSpinorField &out, const ColorSpinorField &in) const
+  {
+    apply(out, in, [&](ColorSpinorField &out, const ColorSpinorField &in) { mat(out, in); });
+  }
+
+  void DiracChebyshev::operator()(ColorSpinorField &out, const ColorSpinorField &in, ColorSpinorField &tmp) const
+  {
+    apply(out, in, [&](ColorSpinorField &out, const ColorSpinorField &in) { mat(out, in, tmp); });
+  }
+
+  void DiracChebyshev::operator()(ColorSpinorField &out, const ColorSpinorField &in, ColorSpinorField &Tmp1,
+                                  ColorSpinorField &Tmp2) const
+  {
+    apply(out, in, [&](ColorSpinorField &out, const ColorSpinorField &in) { mat(out, in, Tmp1, Tmp2); });
+  }
+
 } // namespace quda
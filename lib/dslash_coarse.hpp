@@ -44,7 +44,7 @@ namespace quda {
 
     unsigned int sharedBytesPerThread() const { return (sizeof(complex<Float>) * colors_per_thread(Nc, dim_threads)); }
     bool tuneAuxDim() const { return true; } // Do tune the aux dimensions
-    unsigned int minThreads() const { return color_col_stride * X.VolumeCB(); }
+    unsigned int minThreads() const { return color_col_stride * X.VolumeCB() * nSrc; }
 
     /**
        @param Helper function to check that the present launch parameters are valid
@@ -198,9 +198,10 @@ namespace quda {
         if (out.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER || Y.FieldOrder() != QUDA_QDP_GAUGE_ORDER)
           errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", inA.FieldOrder(), Y.FieldOrder());
 
-        launch_host<CoarseDslash>(
-          tp, stream,
-          Arg<1, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER, QUDA_QDP_GAUGE_ORDER>(out, inA, inB, Y, X, (Float)kappa, parity));
+        // the host engine applies the full operator at each site for all right-hand sides
+        Arg<1, 1, QUDA_SPACE_SPIN_COLOR_FIELD_ORDER, QUDA_QDP_GAUGE_ORDER> arg(out, inA, inB, Y, X, (Float)kappa, parity);
+        arg.threads = dim3(arg.volumeCB, nParity, 1);
+        Kernel2D_host<CoarseDslashHost>(arg, host_launch_param(tp));
       } else {
         if (out.FieldOrder() != QUDA_FLOAT2_FIELD_ORDER || Y.FieldOrder() != QUDA_FLOAT2_GAUGE_ORDER)
           errorQuda("Unsupported field order colorspinor=%d gauge=%d combination\n", inA.FieldOrder(), Y.FieldOrder());
@@ -1970,6 +1970,7 @@ namespace quda
   private:
    void apply(const qudaStream_t &)
    {
+     trace_scope_t scope("dslash", device::get_default_stream());
      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
 
      if (tp.aux.x >= static_cast<int>(policies.size())) errorQuda("Requested policy that is outside of range");
@@ -59,6 +59,7 @@ namespace quda
 
   void BLKTRLM::operator()(std::vector<ColorSpinorField *> &kSpace, std::vector<Complex> &evals)
   {
+    trace_scope_t scope("block_trlm", device::get_default_stream());
     // In case we are deflating an operator, save the tunechache from the inverter
     saveTuneCache();
 
@@ -84,8 +85,8 @@ namespace quda
     // original size before exit.
     prepareKrylovSpace(kSpace, evals);
 
-    // Check for Chebyshev maximum estimation
-    checkChebyOpMax(mat, kSpace);
+    // Check for Chebyshev interval estimation
+    checkChebyOpInterval(mat, kSpace);
 
     // Convergence and locking criteria
     double mat_norm = 0.0;
@@ -392,77 +393,63 @@ namespace quda
     int block_arrow_pos = arrow_pos / block_size;
     int num_locked_offset = (num_locked / block_size) * block_data_length;
 
-    // Eigen objects
-    MatrixXcd T = MatrixXcd::Zero(dim, dim);
-    block_ritz_mat.resize(dim * dim);
+    // Invert the spectrum due to Chebyshev (except the arrow diagonal)
+    double sign = reverse ? -1.0 : 1.0;
+    double arrow_sign = (reverse && restart_iter == 0) ? -1.0 : 1.0;
     int idx = 0;
 
     // Populate the r and eblocks
+    std::vector<double> d(arrow_pos);
+    std::vector<Complex> r(block_size * arrow_pos);
     for (int i = 0; i < block_arrow_pos; i++) {
       for (int b = 0; b < block_size; b++) {
         // E block
         idx = i * block_size + b;
-        T(idx, idx) = alpha[idx + num_locked];
+        d[idx] = arrow_sign * alpha[idx + num_locked];
 
         for (int c = 0; c < block_size; c++) {
           // r blocks
           idx = num_locked_offset + b * block_size + c;
-          T(arrow_pos + c, i * block_size + b) = block_beta[i * block_data_length + idx];
-          T(i * block_size + b, arrow_pos + c) = conj(block_beta[i * block_data_length + idx]);
+          r[(i * block_size + b) * block_size + c] = sign * block_beta[i * block_data_length + idx];
         }
       }
     }
 
     // Add the alpha blocks
+    std::vector<Complex> t_diag((blocks - block_arrow_pos) * block_data_length);
     for (int i = block_arrow_pos; i < blocks; i++) {
       for (int b = 0; b < block_size; b++) {
         for (int c = 0; c < block_size; c++) {
           idx = num_locked_offset + b * block_size + c;
-          T(i * block_size + b, i * block_size + c) = block_alpha[i * block_data_length + idx];
+          t_diag[(i - block_arrow_pos) * block_data_length + c * block_size + b]
+            = sign * block_alpha[i * block_data_length + idx];
         }
       }
     }
 
-    // Add the beta blocks
+    // Add the beta blocks, which are lower triangular
+    std::vector<Complex> t_sub(std::max(blocks - block_arrow_pos - 1, 0) * block_data_length, 0.0);
     for (int i = block_arrow_pos; i < blocks - 1; i++) {
       for (int b = 0; b < block_size; b++) {
         for (int c = 0; c < b + 1; c++) {
           idx = num_locked_offset + b * block_size + c;
-          // Sub diag
-          T((i + 1) * block_size + c, i * block_size + b) = block_beta[i * block_data_length + idx];
-          // Super diag
-          T(i * block_size + b, (i + 1) * block_size + c) = conj(block_beta[i * block_data_length + idx]);
-        }
-      }
-    }
-
-    // Invert the spectrum due to Chebyshev (except the arrow diagonal)
-    if (reverse) {
-      for (int b = 0; b < dim; b++) {
-        for (int c = 0; c < dim; c++) {
-          T(c, b) *= -1.0;
-          if (restart_iter > 0)
-            if (b == c && b < arrow_pos && c < arrow_pos) T(c, b) *= -1.0;
+          t_sub[(i - block_arrow_pos) * block_data_length + b * block_size + c]
+            = sign * block_beta[i * block_data_length + idx];
         }
       }
     }
 
     // Eigensolve the arrow matrix
-    SelfAdjointEigenSolver<MatrixXcd> eigensolver;
-    eigensolver.compute(T);
+    block_arrow_eig.compute(arrow_pos, block_size, d, r, t_diag, t_sub);
 
     // Populate the alpha array with eigenvalues
-    for (int i = 0; i < dim; i++) alpha[i + num_locked] = eigensolver.eigenvalues()[i];
-
-    // Repopulate ritz matrix: COLUMN major
-    for (int i = 0; i < dim; i++)
-      for (int j = 0; j < dim; j++) block_ritz_mat[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
+    for (int i = 0; i < dim; i++) alpha[i + num_locked] = block_arrow_eig.eigenvalues()[i];
 
     for (int i = 0; i < blocks; i++) {
       for (int b = 0; b < block_size; b++) {
         idx = b * (block_size + 1);
-        residua[i * block_size + b + num_locked] = fabs(block_beta[n_kr * block_size - block_data_length + idx]
-                                                        * block_ritz_mat[dim * (i * block_size + b + 1) - 1]);
+        residua[i * block_size + b + num_locked] = abs(block_beta[n_kr * block_size - block_data_length + idx]
+                                                       * block_arrow_eig.lastRow(block_size - 1, i * block_size + b));
       }
     }
 
@@ -474,6 +461,9 @@ namespace quda
     int offset = n_kr + block_size;
     int dim = n_kr - num_locked;
 
+    // Assemble the Ritz vectors we keep
+    block_arrow_eig.eigenvectors(block_ritz_mat, iter_keep);
+
     // Multi-BLAS friendly array to store part of Ritz matrix we want
     Complex *ritz_mat_keep = (Complex *)safe_malloc((dim * iter_keep) * sizeof(Complex));
     for (int j = 0; j < dim; j++) {
@@ -432,6 +432,7 @@ namespace quda
 
   void IRAM::operator()(std::vector<ColorSpinorField *> &kSpace, std::vector<Complex> &evals)
   {
+    trace_scope_t scope("iram", device::get_default_stream());
     // In case we are deflating an operator, save the tunechache from the inverter
     saveTuneCache();
 
@@ -43,6 +43,7 @@ namespace quda
 
   void TRLM::operator()(std::vector<ColorSpinorField *> &kSpace, std::vector<Complex> &evals)
   {
+    trace_scope_t scope("trlm", device::get_default_stream());
     // In case we are deflating an operator, save the tunechache from the inverter
     saveTuneCache();
 
@@ -67,8 +68,8 @@ namespace quda
     // original size before exit.
     prepareKrylovSpace(kSpace, evals);
 
-    // Check for Chebyshev maximum estimation
-    checkChebyOpMax(mat, kSpace);
+    // Check for Chebyshev interval estimation
+    checkChebyOpInterval(mat, kSpace);
 
     // Convergence and locking criteria
     double mat_norm = 0.0;
@@ -282,11 +283,6 @@ namespace quda
     int dim = n_kr - num_locked;
     int arrow_pos = num_keep - num_locked;
 
-    // Eigen objects
-    MatrixXd A = MatrixXd::Zero(dim, dim);
-    ritz_mat.resize(dim * dim);
-    for (int i = 0; i < dim * dim; i++) ritz_mat[i] = 0.0;
-
     // Invert the spectrum due to chebyshev
     if (reverse) {
       for (int i = num_locked; i < n_kr - 1; i++) {
@@ -296,39 +292,20 @@ namespace quda
       alpha[n_kr - 1] *= -1.0;
     }
 
-    // Construct arrow mat A_{dim,dim}
-    for (int i = 0; i < dim; i++) {
-
-      // alpha populates the diagonal
-      A(i, i) = alpha[i + num_locked];
-    }
-
-    for (int i = 0; i < arrow_pos; i++) {
-
-      // beta populates the arrow
-      A(i, arrow_pos) = beta[i + num_locked];
-      A(arrow_pos, i) = beta[i + num_locked];
-    }
-
-    for (int i = arrow_pos; i < dim - 1; i++) {
-
-      // beta populates the sub-diagonal
-      A(i, i + 1) = beta[i + num_locked];
-      A(i + 1, i) = beta[i + num_locked];
-    }
+    // Construct arrow mat A_{dim,dim}: alpha populates the diagonal,
+    // beta populates the arrow and the sub-diagonal
+    std::vector<double> d(alpha + num_locked, alpha + num_locked + arrow_pos);
+    std::vector<double> r(beta + num_locked, beta + num_locked + arrow_pos);
+    std::vector<double> t_diag(alpha + num_locked + arrow_pos, alpha + n_kr);
+    std::vector<double> t_sub(beta + num_locked + arrow_pos, beta + n_kr - 1);
 
     // Eigensolve the arrow matrix
-    SelfAdjointEigenSolver<MatrixXd> eigensolver;
-    eigensolver.compute(A);
-
-    // repopulate ritz matrix
-    for (int i = 0; i < dim; i++)
-      for (int j = 0; j < dim; j++) ritz_mat[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
+    arrow_eig.compute(arrow_pos, 1, d, r, t_diag, t_sub);
 
     for (int i = 0; i < dim; i++) {
-      residua[i + num_locked] = fabs(beta[n_kr - 1] * eigensolver.eigenvectors().col(i)[dim - 1]);
+      residua[i + num_locked] = fabs(beta[n_kr - 1] * arrow_eig.lastRow(0, i));
       // Update the alpha array
-      alpha[i + num_locked] = eigensolver.eigenvalues()[i];
+      alpha[i + num_locked] = arrow_eig.eigenvalues()[i];
     }
 
     // Put spectrum back in order
@@ -344,6 +321,9 @@ namespace quda
     int offset = n_kr + 1;
     int dim = n_kr - num_locked;
 
+    // Assemble the Ritz vectors we keep
+    arrow_eig.eigenvectors(ritz_mat, iter_keep);
+
     // Multi-BLAS friendly array to store part of Ritz matrix we want
     double *ritz_mat_keep = (double *)safe_malloc((dim * iter_keep) * sizeof(double));
     for (int j = 0; j < dim; j++) {
@@ -27,7 +27,8 @@ namespace quda
     eig_param(eig_param),
     profile(profile),
     tmp1(nullptr),
-    tmp2(nullptr)
+    tmp2(nullptr),
+    cheby_mat(nullptr)
   {
     bool profile_running = profile.isRunning(QUDA_PROFILE_INIT);
     if (!profile_running) profile.TPSTART(QUDA_PROFILE_INIT);
@@ -41,6 +42,7 @@ namespace quda
     n_ev_deflate = (eig_param->n_ev_deflate == -1 ? n_conv : eig_param->n_ev_deflate);
     tol = eig_param->tol;
     reverse = false;
+    random_guess = false;
 
     // Algorithm variables
     converged = false;
@@ -151,6 +153,7 @@ namespace quda
   //------------------------------------------------------------------------------
   void EigenSolver::prepareInitialGuess(std::vector<ColorSpinorField *> &kSpace)
   {
+    random_guess = sqrt(blas::norm2(*kSpace[0])) == 0.0;
     if (kSpace[0]->Location() == QUDA_CPU_FIELD_LOCATION) {
       for (int b = 0; b < block_size; b++) {
         if (sqrt(blas::norm2(*kSpace[b])) == 0.0) { kSpace[b]->Source(QUDA_RANDOM_SOURCE); }
@@ -182,12 +185,25 @@ namespace quda
     if (!orthed) errorQuda("Failed to orthonormalise initial guesses");
   }
 
-  void EigenSolver::checkChebyOpMax(const DiracMatrix &mat, std::vector<ColorSpinorField *> &kSpace)
+  void EigenSolver::checkChebyOpInterval(const DiracMatrix &mat, std::vector<ColorSpinorField *> &kSpace)
   {
-    if (eig_param->use_poly_acc && eig_param->a_max <= 0.0) {
-      // Use part of the kSpace as temps
-      eig_param->a_max = estimateChebyOpMax(mat, *kSpace[block_size + 2], *kSpace[block_size + 1]);
-      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Chebyshev maximum estimate: %e.\n", eig_param->a_max);
+    // The Chebyshev operator is rebuilt for each solve: it refers to
+    // the operator of the previous solve, which may no longer exist
+    // even if a new operator now lives at the same address.
+    cheby.reset();
+    cheby_mat = nullptr;
+
+    if (eig_param->use_poly_acc && (eig_param->a_max <= 0.0 || eig_param->a_min <= 0.0)) {
+      double a_min, a_max;
+      estimateChebyOpInterval(mat, kSpace, a_min, a_max);
+      if (eig_param->a_max <= 0.0) {
+        eig_param->a_max = a_max;
+        if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Chebyshev maximum estimate: %e.\n", eig_param->a_max);
+      }
+      if (eig_param->a_min <= 0.0) {
+        eig_param->a_min = std::min(a_min, 0.5 * eig_param->a_max);
+        if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Chebyshev minimum estimate: %e.\n", eig_param->a_min);
+      }
     }
   }
 
@@ -333,91 +349,113 @@ namespace quda
 
     if (eig_param->poly_deg == 0) { errorQuda("Polynomial acceleration requested with zero polynomial degree"); }
 
-    // Compute the polynomial accelerated operator.
-    double a = eig_param->a_min;
-    double b = eig_param->a_max;
-    double delta = (b - a) / 2.0;
-    double theta = (b + a) / 2.0;
-    double sigma1 = -delta / theta;
-    double sigma;
-    double d1 = sigma1 / delta;
-    double d2 = 1.0;
-    double d3;
-
-    // out = d2 * in + d1 * out
-    // C_1(x) = x
-    matVec(mat, out, in);
-    blas::caxpby(d2, const_cast<ColorSpinorField &>(in), d1, out);
-    if (eig_param->poly_deg == 1) return;
-
-    // C_0 is the current 'in'  vector.
-    // C_1 is the current 'out' vector.
-
-    // Clone 'in' to two temporary vectors.
-    auto tmp1 = std::make_unique<ColorSpinorField>(in);
-    auto tmp2 = std::make_unique<ColorSpinorField>(out);
-
-    // Using Chebyshev polynomial recursion relation,
-    // C_{m+1}(x) = 2*x*C_{m} - C_{m-1}
-
-    double sigma_old = sigma1;
-
-    // construct C_{m+1}(x)
-    for (int i = 2; i < eig_param->poly_deg; i++) {
-      sigma = 1.0 / (2.0 / sigma1 - sigma_old);
-
-      d1 = 2.0 * sigma / delta;
-      d2 = -d1 * theta;
-      d3 = -sigma * sigma_old;
-
-      // FIXME - we could introduce a fused matVec + blas kernel here, eliminating one temporary
-      // mat*C_{m}(x)
-      matVec(mat, out, *tmp2);
-
-      blas::axpbypczw(d3, *tmp1, d2, *tmp2, d1, out, *tmp1);
-      std::swap(tmp1, tmp2);
+    // poly_deg counts the terms C_0 ... C_{poly_deg - 1} of the recurrence
+    const int degree = std::max(eig_param->poly_deg - 1, 1);
+    if (!cheby || cheby_mat != &mat) {
+      cheby = std::make_unique<DiracChebyshev>(mat, degree, eig_param->a_min, eig_param->a_max);
+      cheby_mat = &mat;
+    } else {
+      cheby->setPolynomial(degree, eig_param->a_min, eig_param->a_max);
+    }
 
-      sigma_old = sigma;
+    if (!tmp1 || !tmp2) {
+      ColorSpinorParam param(in);
+      if (!tmp1) tmp1 = new ColorSpinorField(param);
+      if (!tmp2) tmp2 = new ColorSpinorField(param);
     }
-    blas::copy(out, *tmp2);
+    (*cheby)(out, in, *tmp1, *tmp2);
 
     // Save Chebyshev tuning
     saveTuneCache();
   }
 
-  double EigenSolver::estimateChebyOpMax(const DiracMatrix &mat, ColorSpinorField &out, ColorSpinorField &in)
+  void EigenSolver::estimateChebyOpInterval(const DiracMatrix &mat, std::vector<ColorSpinorField *> &kSpace,
+                                            double &a_min, double &a_max)
   {
-
-    if (in.Location() == QUDA_CPU_FIELD_LOCATION) {
-      in.Source(QUDA_RANDOM_SOURCE);
+    // Number of Lanczos steps used for the estimate
+    constexpr int n_step = 20;
+
+    // The Lanczos vectors are separate temporaries, since the Krylov
+    // space may not have been extended yet (e.g., for ARPACK)
+    ColorSpinorParam param(*kSpace[0]);
+    param.create = QUDA_ZERO_FIELD_CREATE;
+    ColorSpinorField lanczos_0(param), lanczos_1(param), lanczos_2(param);
+    ColorSpinorField *v_prev = &lanczos_0;
+    ColorSpinorField *v = &lanczos_1;
+    ColorSpinorField *w = &lanczos_2;
+
+    // Start from the initial guess if it is random, since the
+    // spectral density is then sampled without bias
+    if (random_guess) {
+      blas::copy(*v, *kSpace[0]);
+    } else if (v->Location() == QUDA_CPU_FIELD_LOCATION) {
+      v->Source(QUDA_RANDOM_SOURCE);
     } else {
-      RNG *rng = new RNG(in, 1234);
-      spinorNoise(in, *rng, QUDA_NOISE_UNIFORM);
-      delete rng;
+      RNG rng(*v, 1234);
+      spinorNoise(*v, rng, QUDA_NOISE_UNIFORM);
+    }
+    blas::ax(1.0 / sqrt(blas::norm2(*v)), *v);
+    blas::zero(*v_prev);
+
+    std::vector<double> alpha;
+    std::vector<double> beta;
+    for (int j = 0; j < n_step; j++) {
+      matVec(mat, *w, *v);
+      alpha.push_back(blas::reDotProduct(*v, *w));
+
+      // w = w - alpha_j * v - beta_{j-1} * v_prev
+      blas::axpbypczw(-alpha[j], *v, j > 0 ? -beta[j - 1] : 0.0, *v_prev, 1.0, *w, *w);
+      beta.push_back(sqrt(blas::norm2(*w)));
+      if (beta[j] <= DBL_EPSILON * fabs(alpha[j])) break; // invariant subspace
+
+      blas::ax(1.0 / beta[j], *w);
+      std::swap(v_prev, v);
+      std::swap(v, w);
     }
 
-    ColorSpinorField *in_ptr = &in;
-    ColorSpinorField *out_ptr = &out;
-
-    // Power iteration
-    double norm = 0.0;
-    for (int i = 0; i < 100; i++) {
-      if ((i + 1) % 10 == 0) {
-        norm = sqrt(blas::norm2(*in_ptr));
-        blas::ax(1.0 / norm, *in_ptr);
+    // Ritz values and Gauss quadrature weights of the Lanczos tridiagonal
+    int m = alpha.size();
+    MatrixXd T = MatrixXd::Zero(m, m);
+    for (int i = 0; i < m; i++) T(i, i) = alpha[i];
+    for (int i = 0; i < m - 1; i++) T(i, i + 1) = T(i + 1, i) = beta[i];
+    SelfAdjointEigenSolver<MatrixXd> eigensolver(T);
+    const VectorXd &theta = eigensolver.eigenvalues();
+
+    // The extremal Ritz values converge quickly, so their residual
+    // norms give safe bounds on the ends of the spectrum (Zhou and Li),
+    // to which we add a 1% margin
+    a_max = 1.01 * (theta[m - 1] + beta[m - 1] * fabs(eigensolver.eigenvectors()(m - 1, m - 1)));
+    double lower = theta[0] - beta[m - 1] * fabs(eigensolver.eigenvectors()(m - 1, 0));
+
+    // The weight of each Ritz value is the square of the first
+    // component of its Ritz vector, and counts the fraction of the
+    // spectrum it represents.  We interpolate the cumulative count,
+    // splitting each weight evenly about its Ritz value, to the point
+    // below which n_ev eigenvalues are expected to lie.
+    double dim = static_cast<double>(kSpace[0]->Volume()) * kSpace[0]->Nspin() * kSpace[0]->Ncolor() * comm_size();
+    double total = 0.0;
+    double count = 0.0;
+    double x = lower;
+    a_min = theta[m - 1];
+    for (int i = 0; i < m; i++) {
+      double weight = dim * eigensolver.eigenvectors()(0, i) * eigensolver.eigenvectors()(0, i);
+      double next = total + 0.5 * weight;
+      if (next >= n_ev) {
+        a_min = x + (theta[i] - x) * (n_ev - count) / (next - count);
+        break;
       }
-      matVec(mat, *out_ptr, *in_ptr);
-      std::swap(out_ptr, in_ptr);
+      total += weight;
+      count = next;
+      x = theta[i];
     }
+    a_min = std::max(a_min, theta[0]);
 
-    // Compute spectral radius estimate
-    double result = blas::reDotProduct(*out_ptr, *in_ptr);
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Lanczos spectral estimate from %d steps: lowest Ritz value %e, highest Ritz value %e\n", m, theta[0],
+                 theta[m - 1]);
 
-    // Save Chebyshev Max tuning
+    // Save Chebyshev interval tuning
     saveTuneCache();
-
-    // Increase final result by 10% for safety
-    return result * 1.10;
   }
 
   bool EigenSolver::orthoCheck(std::vector<ColorSpinorField *> vecs, int size)
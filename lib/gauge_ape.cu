@@ -29,7 +29,8 @@ namespace quda {
     void apply(const qudaStream_t &stream)
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-      launch<APE>(tp, stream, GaugeAPEArg<Float,nColor,recon, apeDim>(out, in, alpha));
+      constexpr bool enable_host = true;
+      launch<APE, enable_host>(tp, stream, GaugeAPEArg<Float,nColor,recon, apeDim>(out, in, alpha));
     }
 
     void preTune() { out.backup(); } // defensive measure in case they alias
@@ -55,7 +56,7 @@ namespace quda {
     checkReconstruct(out, in);
     checkNative(out, in);
 
-    copyExtendedGauge(in, out, QUDA_CUDA_FIELD_LOCATION);
+    copyExtendedGauge(in, out, out.Location());
     in.exchangeExtendedGhost(in.R(), false);
     instantiate<GaugeAPE>(out, in, alpha);
     out.exchangeExtendedGhost(out.R(), false);
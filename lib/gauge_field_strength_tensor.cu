@@ -25,7 +25,8 @@ namespace quda
     void apply(const qudaStream_t &stream)
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-      launch<ComputeFmunu>(tp, stream, FmunuArg<Float, nColor, recon>(f, u));
+      constexpr bool enable_host = true;
+      launch<ComputeFmunu, enable_host>(tp, stream, FmunuArg<Float, nColor, recon>(f, u));
     }
 
     long long flops() const { return (2430 + 36) * 6 * f.Volume(); }
@@ -22,8 +22,9 @@ namespace quda {
     void apply(const qudaStream_t &stream)
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      constexpr bool enable_host = true;
       GaugePlaqArg<Float, nColor, recon> arg(u);
-      launch<Plaquette>(plq, tp, stream, arg);
+      launch<Plaquette, enable_host>(plq, tp, stream, arg);
       for (int i = 0; i < 2; i++) plq[i] /= 9.*2*arg.threads.x*comm_size();
     }
 
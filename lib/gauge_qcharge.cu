@@ -32,14 +32,15 @@ namespace quda
     void apply(const qudaStream_t &stream)
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      constexpr bool enable_host = true;
 
       typename Arg<>::reduce_t result{};
       if (!density) {
         Arg<false> arg(Fmunu, static_cast<Float*>(qdensity));
-        launch<qCharge>(result, tp, stream, arg);
+        launch<qCharge, enable_host>(result, tp, stream, arg);
       } else {
         Arg<true> arg(Fmunu, static_cast<Float*>(qdensity));
-        launch<qCharge>(result, tp, stream, arg);
+        launch<qCharge, enable_host>(result, tp, stream, arg);
       }
 
       for (int i=0; i<2; i++) energy[i+1] = result[i] / (Fmunu.Volume() * comm_size());
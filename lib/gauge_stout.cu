@@ -34,10 +34,11 @@ namespace quda {
     void apply(const qudaStream_t &stream)
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      constexpr bool enable_host = true;
       if (!improved) {
-        launch<STOUT>(tp, stream, STOUTArg<Float, nColor, recon, 3>(out, in, rho));
+        launch<STOUT, enable_host>(tp, stream, STOUTArg<Float, nColor, recon, 3>(out, in, rho));
       } else if (improved) {
-        launch<OvrImpSTOUT>(tp, stream, STOUTArg<Float, nColor, recon, 4>(out, in, rho, epsilon));
+        launch<OvrImpSTOUT, enable_host>(tp, stream, STOUTArg<Float, nColor, recon, 4>(out, in, rho, epsilon));
       }
     }
 
@@ -62,7 +63,7 @@ namespace quda {
     checkReconstruct(out, in);
     checkNative(out, in);
 
-    copyExtendedGauge(in, out, QUDA_CUDA_FIELD_LOCATION);
+    copyExtendedGauge(in, out, out.Location());
     in.exchangeExtendedGhost(in.R(), false);
     instantiate<GaugeSTOUT>(out, in, false, rho);
     out.exchangeExtendedGhost(out.R(), false);
@@ -74,7 +75,7 @@ namespace quda {
     checkReconstruct(out, in);
     checkNative(out, in);
 
-    copyExtendedGauge(in, out, QUDA_CUDA_FIELD_LOCATION);
+    copyExtendedGauge(in, out, out.Location());
     in.exchangeExtendedGhost(in.R(), false);
     instantiate<GaugeSTOUT>(out, in, true, rho, epsilon);
     out.exchangeExtendedGhost(out.R(), false);
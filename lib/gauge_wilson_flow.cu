@@ -12,6 +12,7 @@ namespace quda {
     static constexpr int wflow_dim = 4; // apply flow in all dims
     GaugeField &out;
     GaugeField &temp;
+    GaugeField &low;
     const GaugeField &in;
     const real epsilon;
     const QudaGaugeSmearType wflow_type;
@@ -24,10 +25,12 @@ namespace quda {
     int blockMin() const { return 8; }
 
   public:
-    GaugeWFlowStep(GaugeField &out, GaugeField &temp, const GaugeField &in, const double epsilon, const QudaGaugeSmearType wflow_type, const WFlowStepType step_type) :
+    GaugeWFlowStep(GaugeField &out, GaugeField &temp, GaugeField &low, const GaugeField &in, const double epsilon,
+                   const QudaGaugeSmearType wflow_type, const WFlowStepType step_type) :
       TunableKernel3D(in, 2, wflow_dim),
       out(out),
       temp(temp),
+      low(low),
       in(in),
       epsilon(epsilon),
       wflow_type(wflow_type),
@@ -43,6 +46,9 @@ namespace quda {
       case WFLOW_STEP_W1: strcat(aux, "_W1"); break;
       case WFLOW_STEP_W2: strcat(aux, "_W2"); break;
       case WFLOW_STEP_VT: strcat(aux, "_VT"); break;
+      case WFLOW_STEP_W1_EMBEDDED: strcat(aux, "_W1_embedded"); break;
+      case WFLOW_STEP_W2_EMBEDDED: strcat(aux, "_W2_embedded"); break;
+      case WFLOW_STEP_VT_EMBEDDED: strcat(aux, "_VT_embedded"); break;
       default : errorQuda("Unknown Wilson Flow step type %d", step_type);
       }
 
@@ -55,31 +61,50 @@ namespace quda {
     void apply(const qudaStream_t &stream)
     {
       TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      constexpr bool enable_host = true;
 
       switch (wflow_type) {
       case QUDA_GAUGE_SMEAR_WILSON_FLOW:
         switch (step_type) {
         case WFLOW_STEP_W1:
-          launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_W1>(out, temp, in, epsilon));
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_W1>(out, temp, low, in, epsilon));
           break;
         case WFLOW_STEP_W2:
-          launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_W2>(out, temp, in, epsilon));
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_W2>(out, temp, low, in, epsilon));
           break;
         case WFLOW_STEP_VT:
-          launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_VT>(out, temp, in, epsilon));
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_VT>(out, temp, low, in, epsilon));
+          break;
+        case WFLOW_STEP_W1_EMBEDDED:
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_W1_EMBEDDED>(out, temp, low, in, epsilon));
+          break;
+        case WFLOW_STEP_W2_EMBEDDED:
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_W2_EMBEDDED>(out, temp, low, in, epsilon));
+          break;
+        case WFLOW_STEP_VT_EMBEDDED:
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_WILSON_FLOW, WFLOW_STEP_VT_EMBEDDED>(out, temp, low, in, epsilon));
           break;
         }
         break;
       case QUDA_GAUGE_SMEAR_SYMANZIK_FLOW:
         switch (step_type) {
         case WFLOW_STEP_W1:
-          launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_W1>(out, temp, in, epsilon));
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_W1>(out, temp, low, in, epsilon));
           break;
         case WFLOW_STEP_W2:
-          launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_W2>(out, temp, in, epsilon));
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_W2>(out, temp, low, in, epsilon));
           break;
         case WFLOW_STEP_VT:
-          launch<WFlow>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_VT>(out, temp, in, epsilon));
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_VT>(out, temp, low, in, epsilon));
+          break;
+        case WFLOW_STEP_W1_EMBEDDED:
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_W1_EMBEDDED>(out, temp, low, in, epsilon));
+          break;
+        case WFLOW_STEP_W2_EMBEDDED:
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_W2_EMBEDDED>(out, temp, low, in, epsilon));
+          break;
+        case WFLOW_STEP_VT_EMBEDDED:
+          launch<WFlow, enable_host>(tp, stream, Arg<QUDA_GAUGE_SMEAR_SYMANZIK_FLOW, WFLOW_STEP_VT_EMBEDDED>(out, temp, low, in, epsilon));
           break;
         }
         break;
@@ -87,8 +112,25 @@ namespace quda {
       }
     }
 
-    void preTune() { out.backup(); temp.backup(); }
-    void postTune() { out.restore(); temp.restore(); }
+    bool embedded() const
+    {
+      return step_type == WFLOW_STEP_W1_EMBEDDED || step_type == WFLOW_STEP_W2_EMBEDDED
+        || step_type == WFLOW_STEP_VT_EMBEDDED;
+    }
+
+    void preTune()
+    {
+      out.backup();
+      temp.backup();
+      if (embedded()) low.backup();
+    }
+
+    void postTune()
+    {
+      out.restore();
+      temp.restore();
+      if (embedded()) low.restore();
+    }
 
     long long flops() const
     {
@@ -96,6 +138,7 @@ namespace quda {
       long long threads = in.LocalVolume() * wflow_dim;
       long long mat_flops = nColor * nColor * (8 * nColor - 2);
       long long mat_muls = 1; // 1 comes from Z * conj(U) term
+      if (step_type == WFLOW_STEP_W2_EMBEDDED) mat_muls += 1; // exp(Z) * W0 for the embedded solution
       switch (wflow_type) {
       case QUDA_GAUGE_SMEAR_WILSON_FLOW: mat_muls += 4 * (wflow_dim - 1); break;
       case QUDA_GAUGE_SMEAR_SYMANZIK_FLOW: mat_muls += 28 * (wflow_dim - 1); break;
@@ -112,8 +155,14 @@ namespace quda {
       case QUDA_GAUGE_SMEAR_SYMANZIK_FLOW: links = 24; break;
       default : errorQuda("Unknown Wilson Flow type");
       }
-      auto temp_io = step_type == WFLOW_STEP_W2 ? 2 : step_type == WFLOW_STEP_VT ? 1 : 0;
-      return ((1 + (wflow_dim - 1) * links) * in.Bytes() + out.Bytes() + temp_io * temp.Bytes());
+      auto temp_io = (step_type == WFLOW_STEP_W2 || step_type == WFLOW_STEP_W2_EMBEDDED) ? 2 :
+        (step_type == WFLOW_STEP_VT || step_type == WFLOW_STEP_VT_EMBEDDED)                ? 1 :
+                                                                                              0;
+      // the embedded W1 step saves W0 in low, the embedded W2 and Vt steps update low
+      auto low_io = step_type == WFLOW_STEP_W1_EMBEDDED ? 1 :
+        (step_type == WFLOW_STEP_W2_EMBEDDED || step_type == WFLOW_STEP_VT_EMBEDDED) ? 2 :
+                                                                                         0;
+      return ((1 + (wflow_dim - 1) * links) * in.Bytes() + out.Bytes() + temp_io * temp.Bytes() + low_io * low.Bytes());
     }
   }; // GaugeWFlowStep
 
@@ -128,16 +177,42 @@ namespace quda {
     
     // Set each step type as an arg parameter, update halos if needed
     // Step W1
-    instantiate<GaugeWFlowStep>(out, temp, in, epsilon, smear_type, WFLOW_STEP_W1);
+    instantiate<GaugeWFlowStep>(out, temp, temp, in, epsilon, smear_type, WFLOW_STEP_W1);
     out.exchangeExtendedGhost(out.R(), false);
 
     // Step W2
-    instantiate<GaugeWFlowStep>(in, temp, out, epsilon, smear_type, WFLOW_STEP_W2);
+    instantiate<GaugeWFlowStep>(in, temp, temp, out, epsilon, smear_type, WFLOW_STEP_W2);
     in.exchangeExtendedGhost(in.R(), false);
 
     // Step Vt
-    instantiate<GaugeWFlowStep>(out, temp, in, epsilon, smear_type, WFLOW_STEP_VT);
+    instantiate<GaugeWFlowStep>(out, temp, temp, in, epsilon, smear_type, WFLOW_STEP_VT);
     out.exchangeExtendedGhost(out.R(), false);
   }
 
+  double WFlowStepEmbedded(GaugeField &out, GaugeField &temp, GaugeField &low, GaugeField &mid, const GaugeField &in,
+                           const double epsilon, const QudaGaugeSmearType smear_type)
+  {
+    checkPrecision(out, temp, low, mid, in);
+    checkReconstruct(out, mid, in);
+    checkNative(out, mid, in);
+    if (temp.Reconstruct() != QUDA_RECONSTRUCT_NO) errorQuda("Temporary vector must not use reconstruct");
+    if (low.Reconstruct() != QUDA_RECONSTRUCT_NO) errorQuda("Embedded solution field must not use reconstruct");
+    if (!(smear_type == QUDA_GAUGE_SMEAR_WILSON_FLOW || smear_type == QUDA_GAUGE_SMEAR_SYMANZIK_FLOW))
+      errorQuda("Gauge smear type %d not supported for flow kernels", smear_type);
+
+    // Step W1, saving W0 for the embedded solution
+    instantiate<GaugeWFlowStep>(out, temp, low, in, epsilon, smear_type, WFLOW_STEP_W1_EMBEDDED);
+    out.exchangeExtendedGhost(out.R(), false);
+
+    // Step W2, along with the embedded second-order solution, into mid so that the input is kept
+    instantiate<GaugeWFlowStep>(mid, temp, low, out, epsilon, smear_type, WFLOW_STEP_W2_EMBEDDED);
+    mid.exchangeExtendedGhost(mid.R(), false);
+
+    // Step Vt, leaving the deviation from the embedded solution in low
+    instantiate<GaugeWFlowStep>(out, temp, low, mid, epsilon, smear_type, WFLOW_STEP_VT_EMBEDDED);
+    out.exchangeExtendedGhost(out.R(), false);
+
+    return low.abs_max();
+  }
+
 }
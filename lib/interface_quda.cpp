@@ -3,12 +3,14 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <map>
 #include <sys/time.h>
 #include <complex.h>
 
 #include <quda.h>
 #include <quda_internal.h>
 #include <device.h>
+#include <thread_pool.h>
 #include <timer.h>
 #include <comm_quda.h>
 #include <tune_quda.h>
@@ -31,6 +33,7 @@
 
 #include <multigrid.h>
 #include <deflation.h>
+#include <vector_io.h>
 
 #include <split_grid.h>
 
@@ -110,6 +113,36 @@ std::vector<ColorSpinorField> solutionResident;
 // each entry is one p
 std::vector<std::vector<ColorSpinorField>> chronoResident(QUDA_MAX_CHRONO);
 
+/**
+   Operator applied to each chronological basis, A p_j, kept resident
+   between solves.  Since the basis is only ever orthogonalized in
+   place and shifted, to both of which the A p_j are subjected alike,
+   the A p_j remain valid while the operator is unchanged, so only the
+   products for new basis vectors need to be applied.
+
+   This only saves work when successive solves share an operator,
+   e.g., repeated solves on one configuration (multiple sources, or
+   measurements).  In HMC the gauge field changes before every solve,
+   so all the products are recomputed and nothing is saved.  Since the
+   in-place orthogonalization is carried out at chrono precision,
+   round-off accumulates in the stored A p_j, so they are also all
+   recomputed every chronoRefreshInterval() forecasts.
+ */
+struct chrono_op_t {
+  std::vector<ColorSpinorField> Ap; // A p_j for each basis vector
+  std::vector<bool> valid;          // whether each Ap[j] is current
+  ColorSpinorField tmp;             // temporary for the operator application
+  uint64_t epoch = 0;               // operator epoch the products were computed for
+  QudaInvertParam param;            // operator parameters the products were computed for
+  bool hermitian = false;           // whether the products are of the normal operator
+  int n_reuse = 0;                  // forecasts since the products were all recomputed
+};
+std::vector<chrono_op_t> chronoResidentOp(QUDA_MAX_CHRONO);
+
+// Counter bumped whenever the resident gauge or clover fields change,
+// used to detect when the resident chrono products must be recomputed
+static uint64_t operator_epoch = 1;
+
 // Mapped memory buffer used to hold unitarization failures
 static int *num_failures_h = nullptr;
 static int *num_failures_d = nullptr;
@@ -334,7 +367,7 @@ void setMPICommHandleQuda(void *mycomm)
 void setMPICommHandleQuda(void *) { }
 #endif
 
-static bool comms_initialized = false;
+static QUDA_COMM_LOCAL bool comms_initialized = false;
 
 void initCommsGridQuda(int nDim, const int *dims, QudaCommsMap func, void *fdata)
 {
@@ -420,6 +453,12 @@ extern char* gitversion;
  */
 void initQudaDevice(int dev)
 {
+#ifdef THREAD_COMMS
+  if (comms_initialized && comm_size() > 1)
+    errorQuda("The threaded communications backend supports the comms layer only, not initQuda with %lu ranks",
+              comm_size());
+#endif
+
   //static bool initialized = false;
   if (initialized) return;
   initialized = true;
@@ -519,6 +558,70 @@ void initQuda(int dev)
 // possible flag to indicate we need to recompute the clover field
 static bool invalidate_clover = true;
 
+/**
+   Cache of the parameters and checksums of the host gauge fields
+   last loaded with loadGaugeQuda for each link type, used to skip the
+   upload (and keep the sloppy copies and clover field) when a host
+   field is loaded again unchanged.
+ */
+struct gauge_cache_t {
+  QudaGaugeParam param;  // parameters the resident fields were created with
+  uint64_t checksum = 0; // checksum over all sites
+};
+static std::map<QudaLinkType, gauge_cache_t> gauge_cache;
+
+/**
+   @brief Invalidate the gauge field cache entry of a given link
+   type, or of all link types if none is given.  This must be called
+   by any function that modifies or frees the resident gauge fields.
+   The clover field is left alone, as it is only recomputed when a
+   new gauge field is loaded.
+ */
+static void invalidateGaugeCache(QudaLinkType type = QUDA_INVALID_LINKS)
+{
+  if (type == QUDA_INVALID_LINKS)
+    gauge_cache.clear();
+  else
+    gauge_cache.erase(type);
+  operator_epoch++;
+}
+
+/**
+   @brief Return whether two gauge parameter sets create the same resident gauge fields
+ */
+static bool sameGaugeParam(const QudaGaugeParam &a, const QudaGaugeParam &b)
+{
+  for (int d = 0; d < 4; d++)
+    if (a.X[d] != b.X[d]) return false;
+  return a.location == b.location && a.anisotropy == b.anisotropy && a.tadpole_coeff == b.tadpole_coeff
+    && a.scale == b.scale && a.gauge_order == b.gauge_order && a.t_boundary == b.t_boundary
+    && a.cpu_prec == b.cpu_prec && a.cuda_prec == b.cuda_prec && a.reconstruct == b.reconstruct
+    && a.cuda_prec_sloppy == b.cuda_prec_sloppy && a.reconstruct_sloppy == b.reconstruct_sloppy
+    && a.cuda_prec_refinement_sloppy == b.cuda_prec_refinement_sloppy
+    && a.reconstruct_refinement_sloppy == b.reconstruct_refinement_sloppy
+    && a.cuda_prec_precondition == b.cuda_prec_precondition && a.reconstruct_precondition == b.reconstruct_precondition
+    && a.cuda_prec_eigensolver == b.cuda_prec_eigensolver && a.reconstruct_eigensolver == b.reconstruct_eigensolver
+    && a.gauge_fix == b.gauge_fix && a.ga_pad == b.ga_pad && a.staggered_phase_type == b.staggered_phase_type
+    && a.staggered_phase_applied == b.staggered_phase_applied && a.i_mu == b.i_mu && a.overlap == b.overlap
+    && a.gauge_offset == b.gauge_offset && a.site_size == b.site_size;
+}
+
+/**
+   @brief Return whether loaded gauge fields are cached.  The cache
+   can be disabled by setting QUDA_ENABLE_GAUGE_CACHE=0.
+ */
+static bool gaugeCacheEnabled()
+{
+  static bool enabled = true;
+  static bool init = false;
+  if (!init) {
+    char *cache_env = getenv("QUDA_ENABLE_GAUGE_CACHE");
+    if (cache_env && strcmp(cache_env, "0") == 0) enabled = false;
+    init = true;
+  }
+  return enabled;
+}
+
 void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 {
   profileGauge.TPSTART(QUDA_PROFILE_TOTAL);
@@ -537,21 +640,40 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
     static_cast<GaugeField*>(new cpuGaugeField(gauge_param)) :
     static_cast<GaugeField*>(new cudaGaugeField(gauge_param));
 
-  if (in->Order() == QUDA_BQCD_GAUGE_ORDER) {
-    static size_t checksum = SIZE_MAX;
-    size_t in_checksum = in->checksum(true);
-    if (in_checksum == checksum) {
+  // checksums are only supported for host fields in these orders
+  bool cacheable = gaugeCacheEnabled() && param->location == QUDA_CPU_FIELD_LOCATION && !param->use_resident_gauge
+    && param->type != QUDA_SMEARED_LINKS;
+  switch (in->Order()) {
+  case QUDA_QDP_GAUGE_ORDER:
+  case QUDA_QDPJIT_GAUGE_ORDER:
+  case QUDA_MILC_GAUGE_ORDER:
+  case QUDA_BQCD_GAUGE_ORDER:
+  case QUDA_TIFR_GAUGE_ORDER:
+  case QUDA_TIFR_PADDED_GAUGE_ORDER: break;
+  default: cacheable = false;
+  }
+
+  gauge_cache_t cache_entry;
+  if (cacheable) {
+    // the full checksum is stored with every new entry, so an unchanged field is served from the
+    // cache on its second load; invalidate_clover is left as is, since the clover field may not yet
+    // have been recomputed for this gauge field
+    cache_entry.param = *param;
+    cache_entry.checksum = in->checksum();
+    auto cached = gauge_cache.find(param->type);
+    if (cached != gauge_cache.end() && sameGaugeParam(cached->second.param, *param)
+        && cached->second.checksum == cache_entry.checksum) {
       if (getVerbosity() >= QUDA_VERBOSE)
-        printfQuda("Gauge field unchanged - using cached gauge field %lu\n", checksum);
+        printfQuda("Gauge field unchanged - using cached gauge field %lu\n", cache_entry.checksum);
       profileGauge.TPSTOP(QUDA_PROFILE_INIT);
       profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
       delete in;
-      invalidate_clover = false;
       return;
     }
-    checksum = in_checksum;
-    invalidate_clover = true;
   }
+  gauge_cache.erase(param->type);
+  if (param->type == QUDA_WILSON_LINKS) invalidate_clover = true;
+  operator_epoch++;
 
   // free any current gauge field before new allocations to reduce memory overhead
   switch (param->type) {
@@ -764,6 +886,8 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
   delete in;
   profileGauge.TPSTOP(QUDA_PROFILE_FREE);
 
+  if (cacheable) gauge_cache[param->type] = cache_entry;
+
   if (extendedGaugeResident) {
     // updated the resident gauge field if needed
     QudaReconstructType recon = extendedGaugeResident->Reconstruct();
@@ -874,6 +998,7 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
   // compute or download clover field only if gauge field has been updated or clover field doesn't exist
   if (clover_update) {
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating new clover field\n");
+    operator_epoch++;
     freeSloppyCloverQuda();
     if (cloverPrecise) delete cloverPrecise;
 
@@ -1024,6 +1149,8 @@ void freeSloppyGaugeQuda()
 {
   if (!initialized) errorQuda("QUDA not initialized");
 
+  invalidateGaugeCache();
+
   // Wilson gauges
   //---------------------------------------------------------------------------
   // Delete gaugeRefinement if it does not alias gaugeSloppy.
@@ -1127,6 +1254,8 @@ void freeGaugeQuda(void)
 
 void loadSloppyGaugeQuda(const QudaPrecision *prec, const QudaReconstructType *recon)
 {
+  invalidateGaugeCache();
+
   // first do SU3 links (if they exist)
   if (gaugePrecise) {
     GaugeFieldParam gauge_param(*gaugePrecise);
@@ -1361,6 +1490,7 @@ void freeCloverQuda(void)
   freeSloppyCloverQuda();
   if (cloverPrecise) delete cloverPrecise;
   cloverPrecise = nullptr;
+  operator_epoch++;
 }
 
 void flushChronoQuda(int i)
@@ -1369,6 +1499,82 @@ void flushChronoQuda(int i)
     errorQuda("Requested chrono index %d is outside of max %d\n", i, QUDA_MAX_CHRONO);
 
   chronoResident[i].clear();
+  chronoResidentOp[i] = chrono_op_t();
+}
+
+/**
+   @brief Return aliases of a chrono basis for I/O.  The vector I/O
+   requires single-parity vectors to carry a suggested parity, which
+   the basis vectors do not consistently have, so the aliases of a
+   single-parity basis are always labeled with the even parity.
+ */
+static std::vector<ColorSpinorField> chronoIOAliases(std::vector<ColorSpinorField> &basis)
+{
+  std::vector<ColorSpinorField> alias;
+  alias.reserve(basis.size());
+  for (auto &v : basis) {
+    ColorSpinorParam param(v);
+    if (v.SiteSubset() == QUDA_PARITY_SITE_SUBSET) param.suggested_parity = QUDA_EVEN_PARITY;
+    alias.push_back(v.create_alias(param));
+  }
+  return alias;
+}
+
+void saveChronoQuda(const char *filename, int i)
+{
+  if (!initialized) errorQuda("QUDA not initialized");
+  if (i < 0 || i >= QUDA_MAX_CHRONO) errorQuda("Requested chrono index %d is outside of max %d\n", i, QUDA_MAX_CHRONO);
+
+  auto &basis = chronoResident[i];
+  if (basis.size() == 0) errorQuda("Chrono index %d has no history to save", i);
+
+  auto alias = chronoIOAliases(basis);
+  std::vector<ColorSpinorField *> vecs;
+  for (auto &v : alias) vecs.push_back(&v);
+
+  if (getVerbosity() >= QUDA_SUMMARIZE)
+    printfQuda("Saving chrono index %d with %lu vectors to %s\n", i, basis.size(), filename);
+  VectorIO io(filename, false, true);
+  io.save(vecs);
+}
+
+void loadChronoQuda(const char *filename, int i, QudaInvertParam *param)
+{
+  profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
+  profileInvert.TPSTART(QUDA_PROFILE_INIT);
+
+  if (!initialized) errorQuda("QUDA not initialized");
+  if (!gaugePrecise) errorQuda("Gauge field not allocated");
+  if (i < 0 || i >= QUDA_MAX_CHRONO) errorQuda("Requested chrono index %d is outside of max %d\n", i, QUDA_MAX_CHRONO);
+  if (param->chrono_max_dim < 1) errorQuda("Cannot load chrono history with chrono_max_dim %d", param->chrono_max_dim);
+
+  flushChronoQuda(i);
+
+  VectorIO io(filename, false, true);
+  const int n = std::min(io.numVectors(), param->chrono_max_dim);
+
+  // the basis has the layout of the solution field of the solve, as when made resident by invertQuda
+  bool pc_solve = (param->solve_type == QUDA_DIRECT_PC_SOLVE) || (param->solve_type == QUDA_NORMOP_PC_SOLVE)
+    || (param->solve_type == QUDA_NORMERR_PC_SOLVE);
+  ColorSpinorParam cpuParam(nullptr, *param, gaugePrecise->X(), pc_solve, param->input_location);
+  ColorSpinorParam cs_param(cpuParam, *param, QUDA_CUDA_FIELD_LOCATION);
+  cs_param.create = QUDA_NULL_FIELD_CREATE;
+  cs_param.setPrecision(param->chrono_precision, param->chrono_precision, true);
+
+  auto &basis = chronoResident[i];
+  basis.reserve(n);
+  for (int j = 0; j < n; j++) basis.emplace_back(cs_param);
+  profileInvert.TPSTOP(QUDA_PROFILE_INIT);
+
+  profileInvert.TPSTART(QUDA_PROFILE_IO);
+  if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Loading chrono index %d with %d vectors from %s\n", i, n, filename);
+  auto alias = chronoIOAliases(basis);
+  std::vector<ColorSpinorField *> vecs;
+  for (auto &v : alias) vecs.push_back(&v);
+  io.load(vecs);
+  profileInvert.TPSTOP(QUDA_PROFILE_IO);
+
+  profileInvert.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
 void endQuda(void)
@@ -1404,6 +1610,7 @@ void endQuda(void)
 
   saveTuneCache();
   saveProfile();
+  trace::save();
 
   // flush any outstanding force monitoring (if enabled)
   flushForceMonitor();
@@ -1458,6 +1665,7 @@ void endQuda(void)
 
   assertAllMemFree();
 
+  host::destroy();
   device::destroy();
 }
 
@@ -2698,7 +2906,119 @@ void* newDeflationQuda(QudaEigParam *eig_param) {
 }
 
 void destroyDeflationQuda(void *df) {
-  delete static_cast<deflated_solver*>(df);
+  auto *defl = static_cast<deflated_solver *>(df);
+  // persist the deflation space with its projection so that later jobs can reuse it without rebuilding it
+  if (defl->defl && defl->defl->size() > 0 && strcmp(defl->deflParam->eig_global.vec_outfile, "") != 0)
+    defl->defl->saveSpace();
+  delete defl;
+}
+
+/**
+   @brief Return whether two parameter sets define the same Dirac
+   operator on the same resident fields, and so whether the resident
+   chrono products can be reused.
+ */
+static bool sameChronoOperator(const QudaInvertParam &a, const QudaInvertParam &b)
+{
+  if (a.Ls != b.Ls) return false;
+  for (int s = 0; s < a.Ls && s < QUDA_MAX_DWF_LS; s++)
+    if (a.b_5[s] != b.b_5[s] || a.c_5[s] != b.c_5[s]) return false;
+  return a.dslash_type == b.dslash_type && a.kappa == b.kappa && a.mass == b.mass && a.m5 == b.m5 && a.mu == b.mu
+    && a.epsilon == b.epsilon && a.tm_rho == b.tm_rho && a.twist_flavor == b.twist_flavor && a.mq1 == b.mq1
+    && a.mq2 == b.mq2 && a.mq3 == b.mq3 && a.eofa_pm == b.eofa_pm && a.eofa_shift == b.eofa_shift
+    && a.laplace3D == b.laplace3D && a.matpc_type == b.matpc_type && a.dagger == b.dagger
+    && a.solve_type == b.solve_type && a.solution_type == b.solution_type && a.cuda_prec == b.cuda_prec
+    && a.cuda_prec_sloppy == b.cuda_prec_sloppy && a.chrono_precision == b.chrono_precision
+    && a.use_mobius_fused_kernel == b.use_mobius_fused_kernel;
+}
+
+/**
+   @brief Forecast the solution from the resident chronological basis
+   by minimizing the residual over the span of the basis.  The operator
+   products of the basis are kept resident, and only the products of
+   basis vectors added since the operator last changed, or since the
+   last periodic refresh, are applied.
+   @param[out] out The forecast solution
+   @param[in] in The source
+   @param[in] m The outer operator
+   @param[in] mSloppy The sloppy operator
+   @param[in] param The invert parameters
+   @param[in] hermitian Whether m is the hermitian normal operator
+ */
+/**
+   @brief Return the number of forecasts after which the resident
+   chrono products are all recomputed, bounding the round-off
+   accumulated through their in-place orthogonalization.  This can be
+   set with QUDA_CHRONO_REFRESH (default 4), where 1 recomputes them
+   on every forecast.
+ */
+static int chronoRefreshInterval()
+{
+  static int interval = 4;
+  static bool init = false;
+  if (!init) {
+    char *refresh_env = getenv("QUDA_CHRONO_REFRESH");
+    if (refresh_env) {
+      interval = atoi(refresh_env);
+      if (interval < 1) errorQuda("Invalid QUDA_CHRONO_REFRESH=%s", refresh_env);
+    }
+    init = true;
+  }
+  return interval;
+}
+
+static void chronoForecast(ColorSpinorField &out, const ColorSpinorField &in, const DiracMatrix &m,
+                           const DiracMatrix &mSloppy, const QudaInvertParam &param, bool hermitian)
+{
+  profileInvert.TPSTART(QUDA_PROFILE_CHRONO);
+
+  auto &basis = chronoResident[param.chrono_index];
+  auto &op = chronoResidentOp[param.chrono_index];
+
+  const DiracMatrix *mat = nullptr;
+  if (param.chrono_precision == param.cuda_prec) {
+    mat = &m;
+  } else if (param.chrono_precision == param.cuda_prec_sloppy) {
+    mat = &mSloppy;
+  } else {
+    errorQuda("Unexpected precision %d for chrono vectors (doesn't match outer %d or sloppy precision %d)",
+              param.chrono_precision, param.cuda_prec, param.cuda_prec_sloppy);
+  }
+
+  ColorSpinorParam cs_param(basis[0]);
+  if (op.Ap.size() != basis.size() || op.Ap[0].Precision() != basis[0].Precision()
+      || op.Ap[0].Volume() != basis[0].Volume() || op.Ap[0].SiteSubset() != basis[0].SiteSubset()) {
+    op = chrono_op_t();
+    op.Ap.reserve(basis.size());
+    for (auto i = 0u; i < basis.size(); i++) op.Ap.emplace_back(cs_param);
+    op.valid.resize(basis.size(), false);
+    op.tmp = ColorSpinorField(cs_param);
+  } else if (op.epoch != operator_epoch || op.hermitian != hermitian || !sameChronoOperator(op.param, param)
+             || op.n_reuse >= chronoRefreshInterval()) {
+    std::fill(op.valid.begin(), op.valid.end(), false);
+  }
+  op.n_reuse = std::all_of(op.valid.begin(), op.valid.end(), [](bool v) { return !v; }) ? 1 : op.n_reuse + 1;
+  op.epoch = operator_epoch;
+  op.param = param;
+  op.hermitian = hermitian;
+
+  ColorSpinorField tmp2 = out.create_alias(cs_param);
+  int n_apply = 0;
+  for (auto j = 0u; j < basis.size(); j++) {
+    if (op.valid[j]) continue;
+    (*mat)(op.Ap[j], basis[j], op.tmp, tmp2);
+    op.valid[j] = true;
+    n_apply++;
+  }
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+    printfQuda("Chrono forecast applied the operator to %d of %lu basis vectors\n", n_apply, basis.size());
+
+  bool orthogonal = true;
+  bool apply_mat = false;
+  MinResExt mre(m, orthogonal, apply_mat, hermitian, profileInvert);
+  mre(out, in, basis, op.Ap);
+
+  profileInvert.TPSTOP(QUDA_PROFILE_CHRONO);
 }
 
 void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
@@ -2910,33 +3230,8 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     DiracM m(dirac), mSloppy(diracSloppy), mPre(diracPre), mEig(diracEig);
     SolverParam solverParam(*param);
     // chronological forecasting
-    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0) {
-      profileInvert.TPSTART(QUDA_PROFILE_CHRONO);
-
-      auto &basis = chronoResident[param->chrono_index];
-
-      ColorSpinorParam cs_param(basis[0]);
-      ColorSpinorField tmp(cs_param);
-      ColorSpinorField tmp2 = out->create_alias(cs_param);
-      std::vector<ColorSpinorField> Ap(basis.size(), cs_param);
-
-      if (param->chrono_precision == param->cuda_prec) {
-        for (unsigned int j = 0; j < basis.size(); j++) m(Ap[j], basis[j], tmp, tmp2);
-      } else if (param->chrono_precision == param->cuda_prec_sloppy) {
-        for (unsigned int j = 0; j < basis.size(); j++) mSloppy(Ap[j], basis[j], tmp, tmp2);
-      } else {
-        errorQuda("Unexpected precision %d for chrono vectors (doesn't match outer %d or sloppy precision %d)",
-                  param->chrono_precision, param->cuda_prec, param->cuda_prec_sloppy);
-      }
-
-      bool orthogonal = true;
-      bool apply_mat = false;
-      bool hermitian = false;
-      MinResExt mre(m, orthogonal, apply_mat, hermitian, profileInvert);
-      mre(*out, *in, basis, Ap);
-
-      profileInvert.TPSTOP(QUDA_PROFILE_CHRONO);
-    }
+    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0)
+      chronoForecast(*out, *in, m, mSloppy, *param, false);
 
     Solver *solve = Solver::create(solverParam, m, mSloppy, mPre, mEig, profileInvert);
     (*solve)(*out, *in);
@@ -2947,33 +3242,8 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     SolverParam solverParam(*param);
 
     // chronological forecasting
-    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0) {
-      profileInvert.TPSTART(QUDA_PROFILE_CHRONO);
-
-      auto &basis = chronoResident[param->chrono_index];
-
-      ColorSpinorParam cs_param(basis[0]);
-      std::vector<ColorSpinorField> Ap(basis.size(), cs_param);
-      ColorSpinorField tmp(cs_param);
-      ColorSpinorField tmp2 = out->create_alias(cs_param);
-
-      if (param->chrono_precision == param->cuda_prec) {
-        for (unsigned int j = 0; j < basis.size(); j++) m(Ap[j], basis[j], tmp, tmp2);
-      } else if (param->chrono_precision == param->cuda_prec_sloppy) {
-        for (unsigned int j = 0; j < basis.size(); j++) mSloppy(Ap[j], basis[j], tmp, tmp2);
-      } else {
-        errorQuda("Unexpected precision %d for chrono vectors (doesn't match outer %d or sloppy precision %d)",
-                  param->chrono_precision, param->cuda_prec, param->cuda_prec_sloppy);
-      }
-
-      bool orthogonal = true;
-      bool apply_mat = false;
-      bool hermitian = true;
-      MinResExt mre(m, orthogonal, apply_mat, hermitian, profileInvert);
-      mre(*out, *in, basis, Ap);
-
-      profileInvert.TPSTOP(QUDA_PROFILE_CHRONO);
-    }
+    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0)
+      chronoForecast(*out, *in, m, mSloppy, *param, true);
 
     // if using a Schwarz preconditioner with a normal operator then we must use the DiracMdagMLocal operator
     if (param->inv_type_precondition != QUDA_INVALID_INVERTER && param->schwarz_type != QUDA_INVALID_SCHWARZ) {
@@ -3017,18 +3287,29 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
       errorQuda("Requested chrono_max_dim %i is smaller than already existing chronology %lu", param->chrono_max_dim, basis.size());
     }
 
+    // the resident operator products must be kept in step with the basis
+    auto &op = chronoResidentOp[i];
+    if (op.Ap.size() != basis.size()) op = chrono_op_t();
+
     if(not param->chrono_replace_last){
       // if we have not filled the space yet just augment
       if ((int)basis.size() < param->chrono_max_dim) {
         ColorSpinorParam cs_param(*out);
         cs_param.setPrecision(param->chrono_precision);
         basis.emplace_back(cs_param);
+        if (op.Ap.size() > 0) {
+          op.Ap.emplace_back(ColorSpinorParam(op.Ap[0]));
+          op.valid.push_back(false);
+        }
       }
 
       // shuffle every entry down one and bring the last to the front
       std::rotate(basis.begin(), basis.end() - 1, basis.end());
+      std::rotate(op.Ap.begin(), op.Ap.end() - std::min(op.Ap.size(), size_t(1)), op.Ap.end());
+      std::rotate(op.valid.begin(), op.valid.end() - std::min(op.valid.size(), size_t(1)), op.valid.end());
     }
     basis[0] = *out; // set first entry to new solution
+    if (op.valid.size() > 0) op.valid[0] = false;
   }
   dirac.reconstruct(x, b, param->solution_type);
 
@@ -4045,6 +4326,7 @@ int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int
   profileGaugeForce.TPSTART(QUDA_PROFILE_FREE);
   if (qudaGaugeParam->make_resident_gauge) {
     if (gaugePrecise && gaugePrecise != cudaSiteLink) delete gaugePrecise;
+    invalidateGaugeCache(QUDA_WILSON_LINKS);
     gaugePrecise = cudaSiteLink;
   } else {
     delete cudaSiteLink;
@@ -4152,6 +4434,7 @@ int computeGaugePathQuda(void *out, void *siteLink, int ***input_path_buf, int *
   profileGaugePath.TPSTART(QUDA_PROFILE_FREE);
   if (qudaGaugeParam->make_resident_gauge) {
     if (gaugePrecise && gaugePrecise != cudaSiteLink) delete gaugePrecise;
+    invalidateGaugeCache(QUDA_WILSON_LINKS);
     gaugePrecise = cudaSiteLink;
     if (extendedGaugeResident) delete extendedGaugeResident;
     extendedGaugeResident = cudaGauge;
@@ -4958,6 +5241,7 @@ void updateGaugeFieldQuda(void* gauge,
   } else { // or use resident fields already present
     if (!gaugePrecise) errorQuda("No resident gauge field allocated");
     cudaInGauge = gaugePrecise;
+    invalidateGaugeCache(QUDA_WILSON_LINKS);
     gaugePrecise = nullptr;
   }
 
@@ -4987,6 +5271,7 @@ void updateGaugeFieldQuda(void* gauge,
   profileGaugeUpdate.TPSTART(QUDA_PROFILE_FREE);
   if (param->make_resident_gauge) {
     if (gaugePrecise != nullptr) delete gaugePrecise;
+    invalidateGaugeCache(QUDA_WILSON_LINKS);
     gaugePrecise = cudaOutGauge;
   } else {
     delete cudaOutGauge;
@@ -5032,6 +5317,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->use_resident_gauge) {
      if (!gaugePrecise) errorQuda("No resident gauge field to use");
      cudaGauge = gaugePrecise;
+     invalidateGaugeCache(QUDA_WILSON_LINKS);
      gaugePrecise = nullptr;
    } else {
      profileProject.TPSTART(QUDA_PROFILE_H2D);
@@ -5058,6 +5344,7 @@ void updateGaugeFieldQuda(void* gauge,
 
    if (param->make_resident_gauge) {
      if (gaugePrecise != nullptr && cudaGauge != gaugePrecise) delete gaugePrecise;
+     invalidateGaugeCache(QUDA_WILSON_LINKS);
      gaugePrecise = cudaGauge;
    } else {
      delete cudaGauge;
@@ -5093,6 +5380,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->use_resident_gauge) {
      if (!gaugePrecise) errorQuda("No resident gauge field to use");
      cudaGauge = gaugePrecise;
+     invalidateGaugeCache(QUDA_WILSON_LINKS);
    } else {
      profilePhase.TPSTART(QUDA_PROFILE_H2D);
      cudaGauge->loadCPUField(*cpuGauge);
@@ -5114,6 +5402,7 @@ void updateGaugeFieldQuda(void* gauge,
 
    if (param->make_resident_gauge) {
      if (gaugePrecise != nullptr && cudaGauge != gaugePrecise) delete gaugePrecise;
+     invalidateGaugeCache(QUDA_WILSON_LINKS);
      gaugePrecise = cudaGauge;
    } else {
      delete cudaGauge;
@@ -5193,6 +5482,7 @@ void gaussGaugeQuda(unsigned long long seed, double sigma)
   if (!gaugePrecise) errorQuda("Cannot generate Gauss GaugeField as there is no resident gauge field");
 
   cudaGaugeField *data = gaugePrecise;
+  invalidateGaugeCache(QUDA_WILSON_LINKS);
 
   profileGauss.TPSTART(QUDA_PROFILE_COMPUTE);
   quda::gaugeGauss(*data, seed, sigma);
@@ -5434,32 +5724,107 @@ void performWFlowQuda(QudaGaugeSmearParam *smear_param, QudaGaugeObservableParam
 
   int measurement_n = 0; // The nth measurement to take
 
+  auto print_measurement = [&](double t, const QudaGaugeObservableParam &obs) {
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      printfQuda("%le %.16e %+.16e %+.16e %+.16e %+.16e\n", t, obs.plaquette[0], obs.energy[0], obs.energy[1],
+                 obs.energy[2], obs.qcharge);
+    }
+  };
+
   gaugeObservables(*in, obs_param[measurement_n], profileWFlow);
 
-  if (getVerbosity() >= QUDA_SUMMARIZE) {
-    printfQuda("flow t, plaquette, E_tot, E_spatial, E_temporal, Q charge\n");
-    printfQuda("%le %.16e %+.16e %+.16e %+.16e %+.16e\n", 0.0, obs_param[0].plaquette[0], obs_param[0].energy[0],
-               obs_param[0].energy[1], obs_param[0].energy[2], obs_param[0].qcharge);
-  }
+  if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("flow t, plaquette, E_tot, E_spatial, E_temporal, Q charge\n");
+  print_measurement(0.0, obs_param[0]);
+
+  if (smear_param->adaptive_tol <= 0.0) {
+    for (unsigned int i = 0; i < smear_param->n_steps; i++) {
+      // Perform W1, W2, and Vt Wilson Flow steps as defined in
+      // https://arxiv.org/abs/1006.4518v3
+      profileWFlow.TPSTART(QUDA_PROFILE_COMPUTE);
+      WFlowStep(*out, *gaugeTemp, *in, smear_param->epsilon, smear_param->smear_type);
+      std::swap(in, out); // output from this step becomes input for the next step
+      profileWFlow.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+      if ((i + 1) % smear_param->meas_interval == 0) {
+        measurement_n++; // increment measurements.
+        gaugeObservables(*in, obs_param[measurement_n], profileWFlow);
+        print_measurement(smear_param->epsilon * (i + 1), obs_param[measurement_n]);
+      }
+    }
+  } else {
+    // Adaptive step size integration as defined in
+    // https://arxiv.org/abs/1301.4388: each step is accepted if the
+    // deviation from the embedded second-order solution is below
+    // adaptive_tol, and the next step size is chosen such that the
+    // deviation, which scales as epsilon^3, is expected to just meet
+    // it.  The flow runs to t = n_steps * epsilon, and steps are
+    // shortened to end on the measurement times of the fixed step
+    // integration, the only times at which the observables are
+    // measured.  The input of a step is left intact, so a rejected
+    // step is simply retried from it.
+    auto *gaugeLow = GaugeField::Create(gParam);
+    auto *gaugeMid = GaugeField::Create(gParamEx);
+
+    const double tol = smear_param->adaptive_tol;
+    const unsigned int n_meas = smear_param->n_steps / smear_param->meas_interval;
+    auto t_meas = [&](unsigned int k) { return smear_param->epsilon * (k * smear_param->meas_interval); };
+    const double t_end = smear_param->epsilon * smear_param->n_steps;
+
+    double t = 0.0;
+    double epsilon = smear_param->epsilon; // step size proposed by the controller
+    unsigned int n_accept = 0;
+    unsigned int n_reject = 0;
+
+    while (t < t_end) {
+      const bool to_meas = static_cast<unsigned int>(measurement_n) < n_meas;
+      const double t_next = to_meas ? t_meas(measurement_n + 1) : t_end;
+      const bool to_stop = t + epsilon >= t_next - 1e-12 * t_end;
+      const double step = to_stop ? t_next - t : epsilon;
+
+      profileWFlow.TPSTART(QUDA_PROFILE_COMPUTE);
+      double dist = WFlowStepEmbedded(*out, *gaugeTemp, *gaugeLow, *gaugeMid, *in, step, smear_param->smear_type);
+      profileWFlow.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+      double scale = dist > 0.0 ? 0.95 * std::cbrt(tol / dist) : 5.0;
+      scale = std::min(std::max(scale, 0.2), 5.0);
+
+      if (dist > tol) {
+        // reject the step and retry from the unchanged input
+        if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+          printfQuda("Rejected step t = %e epsilon = %e deviation = %e\n", t, step, dist);
+        epsilon = step * scale;
+        n_reject++;
+        if (epsilon < 1e-10 * t_end) errorQuda("Flow step size %e underflow at t = %e", epsilon, t);
+        continue;
+      }
 
-  for (unsigned int i = 0; i < smear_param->n_steps; i++) {
-    // Perform W1, W2, and Vt Wilson Flow steps as defined in
-    // https://arxiv.org/abs/1006.4518v3
-    profileWFlow.TPSTART(QUDA_PROFILE_COMPUTE);
-    if (i > 0) std::swap(in, out); // output from prior step becomes input for next step
-    WFlowStep(*out, *gaugeTemp, *in, smear_param->epsilon, smear_param->smear_type);
-    profileWFlow.TPSTOP(QUDA_PROFILE_COMPUTE);
+      n_accept++;
+      t = to_stop ? t_next : t + step;
+      std::swap(in, out); // accepted output becomes input for the next step
 
-    if ((i + 1) % smear_param->meas_interval == 0) {
-      measurement_n++; // increment measurements.
-      gaugeObservables(*out, obs_param[measurement_n], profileWFlow);
-      if (getVerbosity() >= QUDA_SUMMARIZE) {
-        printfQuda("%le %.16e %+.16e %+.16e %+.16e %+.16e\n", smear_param->epsilon * (i + 1),
-                   obs_param[measurement_n].plaquette[0], obs_param[measurement_n].energy[0],
-                   obs_param[measurement_n].energy[1], obs_param[measurement_n].energy[2],
-                   obs_param[measurement_n].qcharge);
+      // a step shortened to end on a stop does not limit the next one
+      epsilon = to_stop ? std::max(epsilon, step * scale) : step * scale;
+
+      if (to_stop && to_meas) {
+        measurement_n++;
+        gaugeObservables(*in, obs_param[measurement_n], profileWFlow);
+        print_measurement(t, obs_param[measurement_n]);
       }
     }
+
+    smear_param->adaptive_n_steps = n_accept + n_reject;
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Adaptive flow to t = %e took %u steps (%u rejected) in place of %u fixed steps of epsilon = %e\n",
+                 t_end, n_accept + n_reject, n_reject, smear_param->n_steps, smear_param->epsilon);
+
+    delete gaugeMid;
+    delete gaugeLow;
+  }
+
+  // leave the flowed field in gaugeSmeared
+  if (in != gaugeSmeared) {
+    gaugeSmeared->copy(*in);
+    gaugeSmeared->exchangeExtendedGhost(gaugeSmeared->R(), false);
   }
 
   delete gaugeTemp;
@@ -5528,6 +5893,7 @@ int computeGaugeFixingOVRQuda(void *gauge, const unsigned int gauge_dir, const u
 
   if (param->make_resident_gauge) {
     if (gaugePrecise != nullptr) delete gaugePrecise;
+    invalidateGaugeCache(QUDA_WILSON_LINKS);
     gaugePrecise = cudaInGauge;
     if (extendedGaugeResident) delete extendedGaugeResident;
     extendedGaugeResident = cudaInGaugeEx;
@@ -5594,6 +5960,7 @@ int computeGaugeFixingFFTQuda(void* gauge, const unsigned int gauge_dir,  const
 
   if (param->make_resident_gauge) {
     if (gaugePrecise != nullptr) delete gaugePrecise;
+    invalidateGaugeCache(QUDA_WILSON_LINKS);
     gaugePrecise = cudaInGauge;
   } else {
     delete cudaInGauge;
@@ -51,6 +51,7 @@ namespace quda {
 
   void BiCGstab::operator()(ColorSpinorField &x, ColorSpinorField &b) 
   {
+    trace_scope_t scope("bicgstab", device::get_default_stream());
     profile.TPSTART(QUDA_PROFILE_PREAMBLE);
 
     if (!init) {
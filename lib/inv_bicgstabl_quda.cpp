@@ -431,6 +431,7 @@ namespace quda {
 
   void BiCGstabL::operator()(ColorSpinorField &x, ColorSpinorField &b) 
   {
+    trace_scope_t scope("bicgstabl", device::get_default_stream());
     // BiCGstab-l is based on the algorithm outlined in
     // BICGSTAB(L) FOR LINEAR EQUATIONS INVOLVING UNSYMMETRIC MATRICES WITH COMPLEX SPECTRUM
     // G. Sleijpen, D. Fokkema, 1993.
@@ -62,6 +62,7 @@ namespace quda
   // CACGNE: M Mdag y = b is solved; x = Mdag y is returned as solution.
   void CACGNE::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("cacgne", device::get_default_stream());
     if (param.maxiter == 0 || param.Nsteps == 0) {
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
       return;
@@ -142,6 +143,7 @@ namespace quda
   // CACGNR: Mdag M x = Mdag b is solved.
   void CACGNR::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("cacgnr", device::get_default_stream());
     if (param.maxiter == 0 || param.Nsteps == 0) {
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
       return;
@@ -412,6 +414,7 @@ namespace quda
   */
   void CACG::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("cacg", device::get_default_stream());
     if (param.is_preconditioner) commGlobalReductionPush(param.global_reduction);
 
     const int n_krylov = param.Nkrylov;
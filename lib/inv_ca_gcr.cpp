@@ -141,6 +141,7 @@ namespace quda
   */
   void CAGCR::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("cagcr", device::get_default_stream());
     const int n_krylov = param.Nkrylov;
 
     if (param.maxiter == 0 || n_krylov == 0) {
@@ -73,6 +73,7 @@ namespace quda {
   // CG3NE: M Mdag y = b is solved; x = Mdag y is returned as solution.
   void CG3NE::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("cg3ne", device::get_default_stream());
     if (param.maxiter == 0 || param.Nsteps == 0) {
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
       return;
@@ -152,6 +153,7 @@ namespace quda {
   // CG3NR: Mdag M x = Mdag b is solved.
   void CG3NR::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("cg3nr", device::get_default_stream());
     if (param.maxiter == 0 || param.Nsteps == 0) {
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
       return;
@@ -194,6 +196,7 @@ namespace quda {
 
   void CG3::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("cg3", device::get_default_stream());
     if (checkLocation(x, b) != QUDA_CUDA_FIELD_LOCATION)
       errorQuda("Not supported");
     if (x.Precision() != param.precision || b.Precision() != param.precision)
@@ -96,6 +96,7 @@ namespace quda {
   // CGNE: M Mdag y = b is solved; x = Mdag y is returned as solution.
   void CGNE::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("cgne", device::get_default_stream());
     if (param.maxiter == 0 || param.Nsteps == 0) {
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
       return;
@@ -176,6 +177,7 @@ namespace quda {
   // CGNR: Mdag M x = Mdag b is solved.
   void CGNR::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("cgnr", device::get_default_stream());
     if (param.maxiter == 0 || param.Nsteps == 0) {
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
       return;
@@ -218,6 +220,7 @@ namespace quda {
 
   void CG::operator()(ColorSpinorField &x, ColorSpinorField &b, ColorSpinorField *p_init, double r2_old_init)
   {
+    trace_scope_t scope("cg", device::get_default_stream());
     if (param.is_preconditioner) commGlobalReductionPush(param.global_reduction);
 
     if (checkLocation(x, b) != QUDA_CUDA_FIELD_LOCATION)
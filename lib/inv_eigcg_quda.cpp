@@ -623,6 +623,7 @@ namespace quda {
 
   void IncEigCG::operator()(ColorSpinorField &out, ColorSpinorField &in)
   {
+    trace_scope_t scope("inc_eigcg", device::get_default_stream());
      if(param.rhs_idx == 0) max_eigcg_cycles = param.eigcg_max_restarts;
 
      const bool mixed_prec = (param.precision != param.precision_sloppy);
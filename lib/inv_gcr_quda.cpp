@@ -229,6 +229,7 @@ namespace quda {
 
   void GCR::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("gcr", device::get_default_stream());
     if (n_krylov == 0) {
       // Krylov space is zero-dimensional so return doing no work
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
@@ -390,6 +390,7 @@ namespace quda {
 
   void GMResDR::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("gmresdr", device::get_default_stream());
     profile.TPSTART(QUDA_PROFILE_INIT);
 
     const double tol_threshold     = 1.2;
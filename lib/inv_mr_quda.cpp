@@ -59,6 +59,7 @@ namespace quda
 
   void MR::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("mr", device::get_default_stream());
     if (param.maxiter == 0 || param.Nsteps == 0) {
       if (param.use_init_guess == QUDA_USE_INIT_GUESS_NO) blas::zero(x);
       return;
@@ -201,6 +201,7 @@ namespace quda {
   void MultiShiftCG::operator()(std::vector<ColorSpinorField> &x, ColorSpinorField &b, std::vector<ColorSpinorField> &p,
                                 std::vector<double> &r2_old_array)
   {
+    trace_scope_t scope("multi_shift_cg", device::get_default_stream());
     pushOutputPrefix("MultiShiftCG: ");
     create(x, b, p);
 
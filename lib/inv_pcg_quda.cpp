@@ -98,6 +98,7 @@ namespace quda
   void PreconCG::solve_and_collect(ColorSpinorField &x, ColorSpinorField &b, std::vector<ColorSpinorField *> &v_r,
                                    int collect_miniter, double collect_tol)
   {
+    trace_scope_t scope("pcg", device::get_default_stream());
     K->train_param(*this, b);
 
     profile.TPSTART(QUDA_PROFILE_INIT);
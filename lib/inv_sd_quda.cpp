@@ -33,6 +33,7 @@ namespace quda {
 
   void SD::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("sd", device::get_default_stream());
     commGlobalReductionPush(param.global_reduction);
 
     if (!init) {
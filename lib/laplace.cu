@@ -146,6 +146,9 @@ namespace quda
       strcat(aux, laplace);
       return TuneKey(in.VolString(), typeid(*this).name(), aux);
     }
+
+    // the aux string above is built per launch, so the key parts are not available
+    bool tuneKeyParts(const char *&, const char *&, const char *&) const { return false; }
   };
 
   template <typename Float, int nColor, QudaReconstructType recon> struct LaplaceApply {
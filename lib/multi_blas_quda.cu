@@ -90,6 +90,14 @@ namespace quda {
 
       TuneKey tuneKey() const { return TuneKey(vol, typeid(f).name(), aux); }
 
+      bool tuneKeyParts(const char *&vol_, const char *&name, const char *&aux_) const
+      {
+        vol_ = vol;
+        name = typeid(f).name();
+        aux_ = aux;
+        return true;
+      }
+
       template <typename Arg> void Launch(const TuneParam &tp, const qudaStream_t &stream, Arg &&arg)
       {
         constexpr bool multi_1d = Arg::Functor::multi_1d;
@@ -151,7 +159,30 @@ namespace quda {
             tp.block.x /= tp.aux.x; // restore block size
           }
         } else {
-          errorQuda("Only implemented for GPU fields");
+          if (checkOrder(x[0], y[0], z[0], w[0]) != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+            errorQuda("CPU Blas functions expect AoS field order");
+
+          using host_store_t = typename host_type_mapper<store_t>::type;
+          using host_y_store_t = typename host_type_mapper<y_store_t>::type;
+          using host_real_t = typename mapper<host_y_store_t>::type;
+          Functor<host_real_t> f_(NXZ, NYW);
+
+          // redefine site_unroll with host_store types to ensure we have correct N/Ny/M values
+          constexpr bool site_unroll = !std::is_same<host_store_t, host_y_store_t>::value || isFixed<host_store_t>::value;
+          constexpr int N = n_vector<host_store_t, false, nSpin, site_unroll>();
+          constexpr int Ny = n_vector<host_y_store_t, false, nSpin, site_unroll>();
+          constexpr int M = N; // if site unrolling then M=N will be 24/6, e.g., full AoS
+          const int length = x[0].get().Length() / (nParity * M);
+
+          // the tuned loop nest processes blocks of sites for each of the NYW outputs in turn,
+          // so the NXZ inputs of a block are reused from cache across the NXZ x NYW tile
+          MultiBlasArg<1, host_real_t, M, NXZ, host_store_t, N, host_y_store_t, Ny, decltype(f_)> arg(x, y, z, w, f_,
+                                                                                                     NYW, length);
+          constexpr bool multi_1d = decltype(arg)::Functor::multi_1d;
+          if (a.size()) { set_param<multi_1d>(arg, 'a', a); }
+          if (b.size()) { set_param<multi_1d>(arg, 'b', b); }
+          if (c.size()) { set_param<multi_1d>(arg, 'c', c); }
+          launch_host<MultiBlas_>(tp, stream, arg);
         }
       }
 
@@ -1229,6 +1229,7 @@ namespace quda
 
   void MG::operator()(ColorSpinorField &x, ColorSpinorField &b)
   {
+    trace_scope_t scope("mg", device::get_default_stream());
     pushOutputPrefix(prefix);
 
     if (param.level < param.Nlevel - 1) { // set parity for the solver in the transfer operator
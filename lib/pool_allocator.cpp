@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <iterator>
+
+#include <util_quda.h>
+#include <pool_allocator.h>
+
+namespace quda
+{
+
+  static inline size_t round_up(size_t bytes, size_t granularity)
+  {
+    return ((bytes + granularity - 1) / granularity) * granularity;
+  }
+
+  PoolAllocator::PoolAllocator(backend_malloc_t backend_malloc, backend_free_t backend_free, size_t high_water) :
+    backend_malloc(backend_malloc), backend_free(backend_free), high_water(high_water)
+  {
+  }
+
+  PoolAllocator::~PoolAllocator() { flush(); }
+
+  size_t PoolAllocator::size_class(size_t bytes)
+  {
+    if (bytes <= alignment) return alignment;
+    if (bytes >= small_limit) return round_up(bytes, alignment);
+
+    // small requests are rounded up to one of four classes per power of two, bounding the waste at 25%
+    size_t pow2 = alignment;
+    while (2 * pow2 < bytes) pow2 *= 2;
+    return round_up(bytes, std::max(pow2 / 4, alignment));
+  }
+
+  void PoolAllocator::update_peak()
+  {
+    stats_.peak_live = std::max(stats_.peak_live, stats_.live);
+    stats_.peak_reserved = std::max(stats_.peak_reserved, stats_.reserved);
+  }
+
+  void PoolAllocator::insert_free(char *ptr, size_t size) { large_free.emplace(size, ptr); }
+
+  void PoolAllocator::erase_free(char *ptr, size_t size)
+  {
+    auto range = large_free.equal_range(size);
+    for (auto it = range.first; it != range.second; it++) {
+      if (it->second == ptr) {
+        large_free.erase(it);
+        return;
+      }
+    }
+    errorQuda("Free block %p of size %lu not found", ptr, size);
+  }
+
+  void PoolAllocator::release_arena(char *arena)
+  {
+    size_t size = arenas[arena];
+    erase_free(arena, size);
+    blocks.erase(arena);
+    arenas.erase(arena);
+    backend_free(__func__, __FILE__, __LINE__, arena);
+    stats_.cached -= size;
+    stats_.reserved -= size;
+    stats_.backend_frees++;
+  }
+
+  void *PoolAllocator::allocate_large(const char *func, const char *file, int line, size_t size)
+  {
+    auto it = large_free.lower_bound(size); // best fit
+
+    if (it == large_free.end()) {
+      // no free block is large enough, so any wholly free arenas are
+      // too small for this request: release these before growing
+      for (auto arena = arenas.begin(); arena != arenas.end();) {
+        auto next = std::next(arena);
+        auto &block = blocks[arena->first];
+        if (block.free && block.size == arena->second) release_arena(arena->first);
+        arena = next;
+      }
+
+      size_t arena_size = round_up(size, arena_granularity);
+      if (stats_.reserved + arena_size > high_water) trim(high_water > arena_size ? high_water - arena_size : 0);
+
+      char *arena = static_cast<char *>(backend_malloc(func, file, line, arena_size));
+      stats_.backend_allocs++;
+      stats_.reserved += arena_size;
+      stats_.cached += arena_size;
+      arenas[arena] = arena_size;
+      blocks[arena] = {arena, arena_size, true};
+      insert_free(arena, arena_size);
+      it = large_free.lower_bound(size);
+    }
+
+    char *ptr = it->second;
+    large_free.erase(it);
+    block_t &block = blocks[ptr];
+
+    // split off the remainder if it is large enough to serve a future request
+    if (block.size - size >= small_limit) {
+      blocks[ptr + size] = {block.arena, block.size - size, true};
+      insert_free(ptr + size, block.size - size);
+      block.size = size;
+    }
+
+    block.free = false;
+    stats_.cached -= block.size;
+    return ptr;
+  }
+
+  void *PoolAllocator::allocate(const char *func, const char *file, int line, size_t bytes)
+  {
+    size_t size = size_class(bytes);
+    void *ptr = nullptr;
+
+    if (size < small_limit) {
+      auto &list = small_free[size];
+      if (!list.empty()) {
+        ptr = list.back();
+        list.pop_back();
+        stats_.cached -= size;
+      } else {
+        if (stats_.reserved + size > high_water) trim(high_water > size ? high_water - size : 0);
+        ptr = backend_malloc(func, file, line, size);
+        stats_.backend_allocs++;
+        stats_.reserved += size;
+      }
+    } else {
+      ptr = allocate_large(func, file, line, size);
+      size = blocks[static_cast<char *>(ptr)].size;
+    }
+
+    allocations[ptr] = {size, bytes};
+    stats_.live += bytes;
+    stats_.wasted += size - bytes;
+    update_peak();
+    return ptr;
+  }
+
+  void PoolAllocator::deallocate_large(char *ptr)
+  {
+    auto it = blocks.find(ptr);
+    it->second.free = true;
+    stats_.cached += it->second.size;
+
+    // blocks tile their arena, so neighbors in the same arena are contiguous
+    auto next = std::next(it);
+    if (next != blocks.end() && next->second.free && next->second.arena == it->second.arena) {
+      erase_free(next->first, next->second.size);
+      it->second.size += next->second.size;
+      blocks.erase(next);
+    }
+
+    if (it != blocks.begin()) {
+      auto prev = std::prev(it);
+      if (prev->second.free && prev->second.arena == it->second.arena) {
+        erase_free(prev->first, prev->second.size);
+        prev->second.size += it->second.size;
+        blocks.erase(it);
+        it = prev;
+      }
+    }
+
+    insert_free(it->first, it->second.size);
+  }
+
+  void PoolAllocator::deallocate(const char *func, const char *file, int line, void *ptr)
+  {
+    auto it = allocations.find(ptr);
+    if (it == allocations.end()) errorQuda("Attempt to free invalid pointer %p (%s:%d in %s())", ptr, file, line, func);
+    allocation_t allocation = it->second;
+    allocations.erase(it);
+
+    stats_.live -= allocation.requested;
+    stats_.wasted -= allocation.size - allocation.requested;
+
+    if (allocation.size < small_limit) {
+      small_free[allocation.size].push_back(ptr);
+      stats_.cached += allocation.size;
+    } else {
+      deallocate_large(static_cast<char *>(ptr));
+    }
+
+    if (stats_.reserved > high_water) trim(high_water);
+  }
+
+  void PoolAllocator::trim(size_t limit)
+  {
+    // release the largest wholly free arenas first
+    while (stats_.reserved > limit) {
+      char *arena = nullptr;
+      size_t arena_size = 0;
+      for (auto &a : arenas) {
+        auto &block = blocks[a.first];
+        if (block.free && block.size == a.second && a.second > arena_size) {
+          arena = a.first;
+          arena_size = a.second;
+        }
+      }
+      if (!arena) break;
+      release_arena(arena);
+    }
+
+    // and then the cached small blocks, largest class first
+    for (auto c = small_free.rbegin(); c != small_free.rend() && stats_.reserved > limit; c++) {
+      auto &list = c->second;
+      while (!list.empty() && stats_.reserved > limit) {
+        backend_free(__func__, __FILE__, __LINE__, list.back());
+        list.pop_back();
+        stats_.cached -= c->first;
+        stats_.reserved -= c->first;
+        stats_.backend_frees++;
+      }
+    }
+  }
+
+  void PoolAllocator::set_high_water(size_t high_water)
+  {
+    this->high_water = high_water;
+    if (stats_.reserved > high_water) trim(high_water);
+  }
+
+  void PoolAllocator::print_stats(const char *name) const
+  {
+    constexpr double MiB = 1 << 20;
+    printfQuda("%s pool: live = %.1f MiB, cached = %.1f MiB, wasted = %.1f MiB (peak live = %.1f MiB, peak reserved = "
+               "%.1f MiB)\n",
+               name, stats_.live / MiB, stats_.cached / MiB, stats_.wasted / MiB, stats_.peak_live / MiB,
+               stats_.peak_reserved / MiB);
+  }
+
+} // namespace quda
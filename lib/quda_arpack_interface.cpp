@@ -252,6 +252,10 @@ namespace quda
         d_v2 = ColorSpinorField::Create(param);
         resid = ColorSpinorField::Create(param);
         allocate = false;
+
+        // Estimate any unset ends of the Chebyshev interval before the first polynomial is built
+        std::vector<ColorSpinorField *> kSpace {d_v};
+        eig_solver->checkChebyOpInterval(mat, kSpace);
       }
 
       if (ido_ == 99 || info_ == 1) break;
@@ -69,6 +69,14 @@ namespace quda {
 
       TuneKey tuneKey() const { return TuneKey(vol, typeid(r).name(), aux); }
 
+      bool tuneKeyParts(const char *&vol_, const char *&name, const char *&aux_) const
+      {
+        vol_ = vol;
+        name = typeid(r).name();
+        aux_ = aux;
+        return true;
+      }
+
       void apply(const qudaStream_t &stream)
       {
         constexpr bool site_unroll_check = !std::is_same<store_t, y_store_t>::value || isFixed<store_t>::value || decltype(r)::site_unroll;
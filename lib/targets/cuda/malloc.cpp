@@ -5,6 +5,7 @@
 #include <unistd.h>   // for getpagesize()
 #include <execinfo.h> // for backtrace
 #include <quda_internal.h>
+#include <pool_allocator.h>
 #include <device.h>
 #include <shmem_helper.cuh>
 
@@ -549,6 +550,7 @@ namespace quda
     printfQuda("Shmem memory used = %.1f MiB\n", max_total_bytes[SHMEM] / (double)(1 << 20));
     printfQuda("Page-locked host memory used = %.1f MiB\n", max_total_pinned_bytes / (double)(1 << 20));
     printfQuda("Total host memory used >= %.1f MiB\n", max_total_host_bytes / (double)(1 << 20));
+    pool::print_stats();
   }
 
   void assertAllMemFree()
@@ -621,25 +623,14 @@ namespace quda
   namespace pool
   {
 
-    /** Cache of inactive pinned-memory allocations.  We cache pinned
-        memory allocations so that fields can reuse these with minimal
-        overhead.*/
-    static std::multimap<size_t, void *> pinnedCache;
+    /** Pool of pinned-memory allocations.  We cache pinned memory
+        allocations so that fields can reuse these with minimal
+        overhead.  Created by init() and never destroyed, since the
+        backend may not be available at static destruction. */
+    static PoolAllocator *pinned_pool = nullptr;
 
-    /** Sizes of active pinned-memory allocations.  For convenience,
-        we keep track of the sizes of active allocations (i.e., those not
-        in the cache). */
-    static std::map<void *, size_t> pinnedSize;
-
-    /** Cache of inactive device-memory allocations.  We cache pinned
-        memory allocations so that fields can reuse these with minimal
-        overhead.*/
-    static std::multimap<size_t, void *> deviceCache;
-
-    /** Sizes of active device-memory allocations.  For convenience,
-        we keep track of the sizes of active allocations (i.e., those not
-        in the cache). */
-    static std::map<void *, size_t> deviceSize;
+    /** Pool of device-memory allocations. */
+    static PoolAllocator *device_pool = nullptr;
 
     static bool pool_init = false;
 
@@ -649,6 +640,18 @@ namespace quda
     /** whether to use a memory pool allocator for pinned memory */
     static bool pinned_memory_pool = true;
 
+    /**
+       @brief Return the high-water mark of a pool in bytes, set from
+       the given environment variable in MiB, with no limit by default
+    */
+    static size_t pool_high_water(const char *env)
+    {
+      char *high_water = getenv(env);
+      if (!high_water) return PoolAllocator::no_limit;
+      warningQuda("Setting %s = %s MiB", env, high_water);
+      return static_cast<size_t>(atol(high_water)) << 20;
+    }
+
     void init()
     {
       if (!pool_init) {
@@ -657,6 +660,8 @@ namespace quda
         if (!enable_device_pool || strcmp(enable_device_pool, "0") != 0) {
           warningQuda("Using device memory pool allocator");
           device_memory_pool = true;
+          device_pool = new PoolAllocator(quda::device_malloc_, quda::device_free_,
+                                          pool_high_water("QUDA_DEVICE_MEMORY_POOL_HIGH_WATER"));
         } else {
           warningQuda("Not using device memory pool allocator");
           device_memory_pool = false;
@@ -667,6 +672,8 @@ namespace quda
         if (!enable_pinned_pool || strcmp(enable_pinned_pool, "0") != 0) {
           warningQuda("Using pinned memory pool allocator");
           pinned_memory_pool = true;
+          pinned_pool = new PoolAllocator(quda::pinned_malloc_, quda::host_free_,
+                                          pool_high_water("QUDA_PINNED_MEMORY_POOL_HIGH_WATER"));
         } else {
           warningQuda("Not using pinned memory pool allocator");
           pinned_memory_pool = false;
@@ -684,37 +691,17 @@ namespace quda
 
     void *pinned_malloc_(const char *func, const char *file, int line, size_t nbytes)
     {
-      void *ptr = nullptr;
       if (pinned_memory_pool) {
-        if (pinnedCache.empty()) {
-          ptr = quda::pinned_malloc_(func, file, line, nbytes);
-        } else {
-          auto it = pinnedCache.lower_bound(nbytes);
-          if (it != pinnedCache.end()) { // sufficiently large allocation found
-            nbytes = it->first;
-            ptr = it->second;
-            pinnedCache.erase(it);
-          } else { // sacrifice the smallest cached allocation
-            it = pinnedCache.begin();
-            ptr = it->second;
-            pinnedCache.erase(it);
-            host_free(ptr);
-            ptr = quda::pinned_malloc_(func, file, line, nbytes);
-          }
-        }
-        pinnedSize[ptr] = nbytes;
+        return pinned_pool->allocate(func, file, line, nbytes);
       } else {
-        ptr = quda::pinned_malloc_(func, file, line, nbytes);
+        return quda::pinned_malloc_(func, file, line, nbytes);
       }
-      return ptr;
     }
 
     void pinned_free_(const char *func, const char *file, int line, void *ptr)
     {
       if (pinned_memory_pool) {
-        if (!pinnedSize.count(ptr)) { errorQuda("Attempt to free invalid pointer"); }
-        pinnedCache.insert(std::make_pair(pinnedSize[ptr], ptr));
-        pinnedSize.erase(ptr);
+        pinned_pool->deallocate(func, file, line, ptr);
       } else {
         quda::host_free_(func, file, line, ptr);
       }
@@ -722,37 +709,17 @@ namespace quda
 
     void *device_malloc_(const char *func, const char *file, int line, size_t nbytes)
     {
-      void *ptr = nullptr;
       if (device_memory_pool) {
-        if (deviceCache.empty()) {
-          ptr = quda::device_malloc_(func, file, line, nbytes);
-        } else {
-          auto it = deviceCache.lower_bound(nbytes);
-          if (it != deviceCache.end()) { // sufficiently large allocation found
-            nbytes = it->first;
-            ptr = it->second;
-            deviceCache.erase(it);
-          } else { // sacrifice the smallest cached allocation
-            it = deviceCache.begin();
-            ptr = it->second;
-            deviceCache.erase(it);
-            quda::device_free_(func, file, line, ptr);
-            ptr = quda::device_malloc_(func, file, line, nbytes);
-          }
-        }
-        deviceSize[ptr] = nbytes;
+        return device_pool->allocate(func, file, line, nbytes);
       } else {
-        ptr = quda::device_malloc_(func, file, line, nbytes);
+        return quda::device_malloc_(func, file, line, nbytes);
       }
-      return ptr;
     }
 
     void device_free_(const char *func, const char *file, int line, void *ptr)
     {
       if (device_memory_pool) {
-        if (!deviceSize.count(ptr)) { errorQuda("Attempt to free invalid pointer"); }
-        deviceCache.insert(std::make_pair(deviceSize[ptr], ptr));
-        deviceSize.erase(ptr);
+        device_pool->deallocate(func, file, line, ptr);
       } else {
         quda::device_free_(func, file, line, ptr);
       }
@@ -772,18 +739,18 @@ namespace quda
 
     void flush_pinned()
     {
-      if (pinned_memory_pool) {
-        for (auto it : pinnedCache) { host_free(it.second); }
-        pinnedCache.clear();
-      }
+      if (pinned_memory_pool) pinned_pool->flush();
     }
 
     void flush_device()
     {
-      if (device_memory_pool) {
-        for (auto it : deviceCache) { device_free(it.second); }
-        deviceCache.clear();
-      }
+      if (device_memory_pool) device_pool->flush();
+    }
+
+    void print_stats()
+    {
+      if (device_memory_pool) device_pool->print_stats("Device memory");
+      if (pinned_memory_pool) pinned_pool->print_stats("Pinned memory");
     }
 
   } // namespace pool
@@ -0,0 +1,150 @@
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <util_quda.h>
+#include <thread_pool.h>
+
+namespace quda
+{
+
+  namespace host
+  {
+
+    /**
+       @brief Persistent pool of worker threads.  Each parallel region
+       increments the generation counter which releases the workers;
+       the calling thread executes as thread 0 and then waits for the
+       remaining threads to check in.
+     */
+    class ThreadPool
+    {
+      std::vector<std::thread> workers;
+      std::mutex mutex;
+      std::condition_variable start_cv;
+      std::condition_variable done_cv;
+
+      unsigned long generation = 0;
+      bool exit = false;
+
+      int n_active = 0;  // number of threads partaking in the present region
+      int n_pending = 0; // number of workers yet to complete the present region
+      void (*fn)(int, int, void *) = nullptr;
+      void *ctx = nullptr;
+
+      void worker(int tid)
+      {
+        unsigned long seen = 0;
+        while (true) {
+          std::unique_lock<std::mutex> lock(mutex);
+          start_cv.wait(lock, [&] { return exit || generation != seen; });
+          if (exit) return;
+          seen = generation;
+          if (tid >= n_active) continue; // not needed for this region
+          auto fn_ = fn;
+          auto ctx_ = ctx;
+          auto n_active_ = n_active;
+          lock.unlock();
+
+          region_thread(tid, n_active_, fn_, ctx_);
+
+          lock.lock();
+          if (--n_pending == 0) done_cv.notify_one();
+        }
+      }
+
+    public:
+      static thread_local bool active;
+
+      static void region_thread(int tid, int n_threads, void (*fn)(int, int, void *), void *ctx)
+      {
+        active = true;
+        fn(tid, n_threads, ctx);
+        active = false;
+      }
+
+      ThreadPool(int n_threads)
+      {
+        workers.reserve(n_threads - 1);
+        for (int i = 1; i < n_threads; i++) workers.emplace_back(&ThreadPool::worker, this, i);
+      }
+
+      ~ThreadPool()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          exit = true;
+        }
+        start_cv.notify_all();
+        for (auto &w : workers) w.join();
+      }
+
+      int size() const { return workers.size() + 1; }
+
+      void run(int n_threads, void (*fn_)(int, int, void *), void *ctx_)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          fn = fn_;
+          ctx = ctx_;
+          n_active = n_threads;
+          n_pending = n_threads - 1;
+          generation++;
+        }
+        start_cv.notify_all();
+
+        region_thread(0, n_threads, fn_, ctx_);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [&] { return n_pending == 0; });
+      }
+    };
+
+    thread_local bool ThreadPool::active = false;
+
+    static ThreadPool *pool = nullptr;
+    static std::mutex pool_mutex;
+
+    int max_threads()
+    {
+      static int n_threads = 0;
+      if (n_threads == 0) {
+        char *host_threads_env = getenv("QUDA_HOST_THREADS");
+        if (!host_threads_env) host_threads_env = getenv("OMP_NUM_THREADS");
+        n_threads = host_threads_env ? atoi(host_threads_env) : 1;
+        if (n_threads < 1) {
+          warningQuda("Invalid host thread count %s, using a single thread", host_threads_env);
+          n_threads = 1;
+        }
+      }
+      return n_threads;
+    }
+
+    bool in_parallel() { return ThreadPool::active; }
+
+    void destroy()
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      delete pool;
+      pool = nullptr;
+    }
+
+    void parallel_region(int n_threads, void (*fn)(int, int, void *), void *ctx)
+    {
+      n_threads = std::max(std::min(n_threads, max_threads()), 1);
+      if (n_threads == 1 || in_parallel()) {
+        for (int tid = 0; tid < n_threads; tid++) fn(tid, n_threads, ctx);
+        return;
+      }
+
+      // regions issued from concurrent host threads are serialized on the pool
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      if (!pool) pool = new ThreadPool(max_threads());
+      pool->run(n_threads, fn, ctx);
+    }
+
+  } // namespace host
+
+} // namespace quda
@@ -1,4 +1,13 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <vector>
+
 #include <quda_internal.h>
+#include <comm_quda.h>
 #include <timer.h>
 
 namespace quda {
@@ -113,4 +122,270 @@ namespace quda {
     }
   }
 
+  namespace trace
+  {
+
+    using clock = std::chrono::steady_clock;
+
+    /**
+       Number of latency histogram bins: bin 0 counts calls shorter
+       than 1 us, and bin b > 0 counts calls in [2^(b-1), 2^b) us.
+     */
+    constexpr int n_bin = 32;
+
+    /**
+       A node in the tree of scopes, corresponding to a distinct scope path
+     */
+    struct node_t {
+      std::string name;
+      int parent;
+      std::map<std::string, int> children;
+      uint64_t count = 0;
+      double total = 0.0;
+      double min = 0.0;
+      double max = 0.0;
+      uint64_t histogram[n_bin] = {};
+      node_t(const std::string &name, int parent) : name(name), parent(parent) { }
+    };
+
+    /**
+       A scope that is presently open
+     */
+    struct open_t {
+      const void *key;
+      int node;
+      clock::time_point start;
+    };
+
+    /**
+       A completed scope, recorded for the Chrome trace (times in us since the start of the trace)
+     */
+    struct event_t {
+      int node;
+      double start;
+      double duration;
+    };
+
+    struct state_t {
+      std::vector<node_t> tree {node_t("", -1)}; // node 0 is the root
+      std::vector<open_t> stack;
+      std::vector<event_t> events;
+      clock::time_point epoch = clock::now();
+      bool overflow = false;
+    };
+
+    // each rank traces separately, which matters when ranks are threads
+    static QUDA_COMM_LOCAL state_t *state = nullptr;
+
+    enum mode_t { TRACE_SUMMARY = 1, TRACE_EVENTS = 2 };
+
+    static int mode()
+    {
+      static int mode_ = -1;
+      if (mode_ < 0) {
+        mode_ = 0;
+        char *trace_env = getenv("QUDA_PROFILE_TRACE");
+        if (trace_env) {
+          if (strcmp(trace_env, "json") == 0)
+            mode_ = TRACE_SUMMARY;
+          else if (strcmp(trace_env, "chrome") == 0)
+            mode_ = TRACE_EVENTS;
+          else if (strcmp(trace_env, "all") == 0)
+            mode_ = TRACE_SUMMARY | TRACE_EVENTS;
+          else if (strcmp(trace_env, "0") != 0)
+            warningQuda("Unknown QUDA_PROFILE_TRACE=%s, tracing disabled (use json, chrome or all)", trace_env);
+        }
+      }
+      return mode_;
+    }
+
+    /**
+       @brief Return the maximum number of events recorded for the
+       Chrome trace, set with QUDA_PROFILE_TRACE_MAX_EVENTS (default
+       one million).  The summary is unaffected by this limit.
+     */
+    static size_t max_events()
+    {
+      static size_t max_events_ = 0;
+      if (max_events_ == 0) {
+        char *max_env = getenv("QUDA_PROFILE_TRACE_MAX_EVENTS");
+        max_events_ = max_env ? std::max(atol(max_env), 1l) : 1000000;
+      }
+      return max_events_;
+    }
+
+    bool enabled() { return mode() != 0; }
+
+    void push(const void *key, const std::string &name)
+    {
+      if (!state) state = new state_t;
+      auto &tree = state->tree;
+      const int parent = state->stack.empty() ? 0 : state->stack.back().node;
+
+      int node;
+      auto child = tree[parent].children.find(name);
+      if (child != tree[parent].children.end()) {
+        node = child->second;
+      } else {
+        node = tree.size();
+        tree[parent].children[name] = node;
+        tree.emplace_back(name, parent);
+      }
+
+      state->stack.push_back({key, node, clock::now()});
+    }
+
+    void pop(const void *key)
+    {
+      if (!state) return;
+      const auto stop = clock::now();
+      auto &stack = state->stack;
+
+      auto it = std::find_if(stack.rbegin(), stack.rend(), [key](const open_t &o) { return o.key == key; });
+      if (it == stack.rend()) return; // opened before tracing began
+      const open_t scope = *it;
+      stack.erase(std::next(it).base());
+
+      const double duration = std::chrono::duration<double>(stop - scope.start).count();
+      auto &node = state->tree[scope.node];
+      node.min = node.count == 0 ? duration : std::min(node.min, duration);
+      node.max = std::max(node.max, duration);
+      node.total += duration;
+      node.count++;
+      const double us = 1e6 * duration;
+      node.histogram[us < 1.0 ? 0 : std::min(n_bin - 1, 1 + static_cast<int>(std::log2(us)))]++;
+
+      if (mode() & TRACE_EVENTS) {
+        if (state->events.size() < max_events()) {
+          const double start = 1e6 * std::chrono::duration<double>(scope.start - state->epoch).count();
+          state->events.push_back({scope.node, start, us});
+        } else if (!state->overflow) {
+          warningQuda("Trace event limit %lu reached, further events are not recorded", max_events());
+          state->overflow = true;
+        }
+      }
+    }
+
+    /**
+       @brief Return the path of a node, e.g., invertQuda/compute/dslash
+     */
+    static std::string path(int node)
+    {
+      std::string p = state->tree[node].name;
+      for (int n = state->tree[node].parent; n > 0; n = state->tree[n].parent) p = state->tree[n].name + "/" + p;
+      return p;
+    }
+
+    /**
+       @brief Return a string as a quoted JSON string
+     */
+    static std::string quote(const std::string &s)
+    {
+      std::string q = "\"";
+      for (auto c : s) {
+        if (c == '"' || c == '\\') q += '\\';
+        q += c;
+      }
+      return q + "\"";
+    }
+
+    static std::string filename(const std::string &prefix)
+    {
+      std::string dir = ".";
+      char *path_env = getenv("QUDA_PROFILE_TRACE_PATH");
+      char *resource_env = getenv("QUDA_RESOURCE_PATH");
+      if (path_env && strlen(path_env) > 0)
+        dir = path_env;
+      else if (resource_env && strlen(resource_env) > 0)
+        dir = resource_env;
+      return dir + "/" + prefix + "_rank" + std::to_string(comm_rank()) + ".json";
+    }
+
+    /**
+       @brief Write the per-scope summary, with the scopes in depth-first order
+     */
+    static void save_summary()
+    {
+      const std::string name = filename("trace_summary");
+      std::ofstream out(name);
+      if (!out) {
+        warningQuda("Unable to write trace summary %s", name.c_str());
+        return;
+      }
+
+      // times are in us with fixed precision, so that large values are not rounded to a few significant figures
+      out << std::fixed << std::setprecision(3);
+      out << "{\n  \"rank\": " << comm_rank() << ",\n  \"time_unit\": \"us\",\n";
+      out << "  \"histogram_bins_us\": \"[0,1), [1,2), [2,4), ...\",\n";
+      out << "  \"scopes\": [";
+      bool first = true;
+      std::vector<int> todo;
+      for (auto c = state->tree[0].children.rbegin(); c != state->tree[0].children.rend(); c++)
+        todo.push_back(c->second);
+      while (!todo.empty()) {
+        const int n = todo.back();
+        todo.pop_back();
+        auto &node = state->tree[n];
+        for (auto c = node.children.rbegin(); c != node.children.rend(); c++) todo.push_back(c->second);
+
+        out << (first ? "\n" : ",\n") << "    {\"path\": " << quote(path(n)) << ", \"count\": " << node.count
+            << ", \"total\": " << 1e6 * node.total << ", \"mean\": " << (node.count ? 1e6 * node.total / node.count : 0.0)
+            << ", \"min\": " << 1e6 * node.min << ", \"max\": " << 1e6 * node.max << ", \"histogram\": [";
+        int last = n_bin - 1;
+        while (last > 0 && node.histogram[last] == 0) last--;
+        for (int b = 0; b <= last; b++) out << (b ? ", " : "") << node.histogram[b];
+        out << "]}";
+        first = false;
+      }
+      out << "\n  ]\n}\n";
+      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Saved trace summary to %s\n", name.c_str());
+    }
+
+    /**
+       @brief Write the recorded events in the Chrome trace-event format
+     */
+    static void save_events()
+    {
+      const std::string name = filename("trace");
+      std::ofstream out(name);
+      if (!out) {
+        warningQuda("Unable to write trace %s", name.c_str());
+        return;
+      }
+
+      const int rank = comm_rank();
+      out << std::fixed << std::setprecision(3); // ts and dur are in us, and ts grows large over a long run
+      out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+      out << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << rank << ", \"args\": {\"name\": \"rank "
+          << rank << "\"}}";
+      std::vector<std::string> paths(state->tree.size());
+      for (auto &e : state->events) {
+        if (paths[e.node].empty()) paths[e.node] = quote(path(e.node));
+        out << ",\n  {\"name\": " << quote(state->tree[e.node].name) << ", \"cat\": " << paths[e.node]
+            << ", \"ph\": \"X\", \"pid\": " << rank << ", \"tid\": 0, \"ts\": " << e.start << ", \"dur\": " << e.duration
+            << "}";
+      }
+      out << "\n]}\n";
+      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Saved trace to %s\n", name.c_str());
+    }
+
+    void save()
+    {
+      if (!enabled() || !state) return;
+      if (!state->stack.empty())
+        warningQuda("%lu trace scopes still open, these are not included in the trace", state->stack.size());
+
+      if (mode() & TRACE_SUMMARY) save_summary();
+      if (mode() & TRACE_EVENTS) save_events();
+      reset();
+    }
+
+    void reset()
+    {
+      delete state;
+      state = nullptr;
+    }
+
+  } // namespace trace
+
 }
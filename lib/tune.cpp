@@ -4,15 +4,24 @@
 #include <timer.h>
 #include <sys/stat.h> // for stat()
 #include <fcntl.h>
+#include <sys/file.h> // for flock()
+#include <signal.h>   // for kill()
+#include <cerrno>
+#include <dirent.h> // for opendir()
 #include <cfloat> // for FLT_MAX
+#include <limits>
 #include <ctime>
 #include <fstream>
 #include <typeinfo>
+#include <algorithm>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <list>
 #include <unistd.h>
 #include <uint_to_char.h>
 #include <target_device.h>
+#include <thread_pool.h>
 
 #include <deque>
 #include <queue>
@@ -27,9 +36,10 @@ extern char *gitversion;
 
 namespace quda
 {
-  static TuneKey last_key;
+  static TuneKey last_key;                            // storage for keys that are not held in the tunecache
+  static const TuneKey *last_key_ptr = &last_key; // avoid copying the key when launching from the tunecache
 
-  TuneKey getLastTuneKey() { return quda::last_key; }
+  TuneKey getLastTuneKey() { return *quda::last_key_ptr; }
 
   typedef std::map<TuneKey, TuneParam> map;
 
@@ -103,8 +113,51 @@ namespace quda
   static const std::string quda_hash = QUDA_HASH; // defined in lib/Makefile
   static std::string resource_path;
   static map tunecache;
-  static map::iterator it;
-  static size_t initial_cache_size = 0;
+  static bool version_check = true;
+  static std::vector<TuneKey> broadcast_pending; // keys tuned on process 0 that have yet to be broadcast
+  static std::vector<TuneKey> journal_pending;   // keys tuned by this process that have yet to be saved to disk
+
+  /**
+   * Hash functors for indexing the tunecache through pointers to the
+   * keys it holds, so each key is stored (interned) only once.
+   */
+  struct TuneKeyPtrHash {
+    size_t operator()(const TuneKey *key) const { return key->hash(); }
+  };
+
+  struct TuneKeyPtrEqual {
+    bool operator()(const TuneKey *a, const TuneKey *b) const { return *a == *b; }
+  };
+
+  /**
+   * Hash index into the tunecache, giving O(1) lookup on the launch
+   * path.  The ordered map is retained for serialization.
+   */
+  static std::unordered_map<const TuneKey *, map::iterator, TuneKeyPtrHash, TuneKeyPtrEqual> tunecache_index;
+
+  /**
+   * Find a tunecache entry through the hash index
+   */
+  static map::iterator findTuneCache(const TuneKey &key)
+  {
+    auto entry = tunecache_index.find(&key);
+    return entry != tunecache_index.end() ? entry->second : tunecache.end();
+  }
+
+  /**
+   * Insert or update a tunecache entry, keeping the hash index in
+   * sync.  Updates are made in place, so that pointers to existing
+   * entries remain valid.
+   */
+  static map::iterator insertTuneCache(const TuneKey &key, const TuneParam &param)
+  {
+    auto result = tunecache.emplace(key, param);
+    if (result.second)
+      tunecache_index.emplace(&result.first->first, result.first);
+    else
+      result.first->second = param;
+    return result.first;
+  }
 
 #define STR_(x) #x
 #define STR(x) STR_(x)
@@ -128,8 +181,11 @@ namespace quda
 
   /**
    * Deserialize tunecache from an istream, useful for reading a file or receiving from other nodes.
+   * Entries are inserted into cache if set, else into the tunecache.  Lines that do not parse
+   * completely, or that are not newline terminated (e.g., the tail of a journal whose writer was
+   * killed mid-write), are dropped.
    */
-  static void deserializeTuneCache(std::istream &in)
+  static void deserializeTuneCache(std::istream &in, map *cache = nullptr)
   {
     std::string line;
     std::stringstream ls;
@@ -141,47 +197,57 @@ namespace quda
     std::string n;
     std::string a;
 
-    int check;
-
     while (in.good()) {
       getline(in, line);
       if (!line.length()) continue; // skip blank lines (e.g., at end of file)
+      if (in.eof()) {               // every entry ends with a newline, so this line is truncated
+        warningQuda("Dropping truncated tunecache entry \"%s\"", line.c_str());
+        break;
+      }
       ls.clear();
       ls.str(line);
       ls >> v >> n >> a >> param.block.x >> param.block.y >> param.block.z;
-      check = snprintf(key.volume, key.volume_n, "%s", v.c_str());
-      if (check < 0 || check >= key.volume_n) errorQuda("Error writing volume string (check = %d)", check);
-      check = snprintf(key.name, key.name_n, "%s", n.c_str());
-      if (check < 0 || check >= key.name_n) errorQuda("Error writing name string (check=%d)", check);
-      check = snprintf(key.aux, key.aux_n, "%s", a.c_str());
-      if (check < 0 || check >= key.aux_n) errorQuda("Error writing aux string (check=%d)", check);
       ls >> param.grid.x >> param.grid.y >> param.grid.z >> param.shared_bytes >> param.aux.x >> param.aux.y
-        >> param.aux.z >> param.aux.w >> param.time;
+        >> param.aux.z >> param.aux.w >> param.host.x >> param.host.y >> param.host.z >> param.host.w >> param.time;
+      if (ls.fail() || v.size() >= static_cast<size_t>(key.volume_n) || n.size() >= static_cast<size_t>(key.name_n)
+          || a.size() >= static_cast<size_t>(key.aux_n)) {
+        warningQuda("Dropping malformed tunecache entry \"%s\"", line.c_str());
+        continue;
+      }
+      strcpy(key.volume, v.c_str());
+      strcpy(key.name, n.c_str());
+      strcpy(key.aux, a.c_str());
       ls.ignore(1);               // throw away tab before comment
+      param.comment.clear();
       getline(ls, param.comment); // assume anything remaining on the line is a comment
       param.comment += "\n";      // our convention is to include the newline, since ctime() likes to do this
-      tunecache[key] = param;
+      if (cache)
+        (*cache)[key] = param;
+      else
+        insertTuneCache(key, param);
     }
   }
 
   /**
-   * Serialize tunecache to an ostream, useful for writing to a file or sending to other nodes.
+   * Serialize a single tunecache entry to an ostream.
    */
-  static void serializeTuneCache(std::ostream &out)
+  static void serializeTuneCacheEntry(std::ostream &out, const TuneKey &key, const TuneParam &param)
   {
-    map::iterator entry;
-
-    for (entry = tunecache.begin(); entry != tunecache.end(); entry++) {
-      TuneKey key = entry->first;
-      TuneParam param = entry->second;
+    out << std::setw(16) << key.volume << "\t" << key.name << "\t" << key.aux << "\t";
+    out << param.block.x << "\t" << param.block.y << "\t" << param.block.z << "\t";
+    out << param.grid.x << "\t" << param.grid.y << "\t" << param.grid.z << "\t";
+    out << param.shared_bytes << "\t" << param.aux.x << "\t" << param.aux.y << "\t" << param.aux.z << "\t"
+        << param.aux.w << "\t";
+    out << param.host.x << "\t" << param.host.y << "\t" << param.host.z << "\t" << param.host.w << "\t";
+    out << param.time << "\t" << param.comment; // param.comment ends with a newline
+  }
 
-      out << std::setw(16) << key.volume << "\t" << key.name << "\t" << key.aux << "\t";
-      out << param.block.x << "\t" << param.block.y << "\t" << param.block.z << "\t";
-      out << param.grid.x << "\t" << param.grid.y << "\t" << param.grid.z << "\t";
-      out << param.shared_bytes << "\t" << param.aux.x << "\t" << param.aux.y << "\t" << param.aux.z << "\t"
-          << param.aux.w << "\t";
-      out << param.time << "\t" << param.comment; // param.comment ends with a newline
-    }
+  /**
+   * Serialize tunecache to an ostream, useful for writing to a file or sending to other nodes.
+   */
+  static void serializeTuneCache(std::ostream &out, const map &cache = tunecache)
+  {
+    for (auto &entry : cache) serializeTuneCacheEntry(out, entry.first, entry.second);
   }
 
   template <class T> struct less_significant : std::binary_function<T, T, bool> {
@@ -268,6 +334,69 @@ namespace quda
               << "# Total time spent in asynchronous execution = " << async_total_time << " seconds" << std::endl;
   }
 
+  /**
+   * Serialize the profile as JSON, recording for each kernel the
+   * achieved throughput and arithmetic intensity in addition to the
+   * timings of the tsv profile.  The rates are computed from the
+   * tuned time per call, and the schema is versioned by the
+   * "schema" and "version" fields.
+   */
+  static void serializeProfileJson(std::ostream &out, const std::string &label)
+  {
+    json kernels = json::array();
+    double total_time = 0.0;
+    for (auto &entry : tunecache) {
+      const TuneKey &key = entry.first;
+      const TuneParam &param = entry.second;
+      if (param.n_calls == 0) continue;
+
+      char tmp[TuneKey::aux_n] = {};
+      strncpy(tmp, key.aux, TuneKey::aux_n);
+      bool is_policy_kernel = strncmp(tmp, "policy_kernel", 13) == 0;
+      bool is_policy = strncmp(tmp, "policy", 6) == 0 && !is_policy_kernel;
+      bool is_nested_policy = strncmp(tmp, "nested_policy", 13) == 0;
+      if (is_nested_policy) continue;
+
+      const double time = param.n_calls * static_cast<double>(param.time);
+      if (!is_policy) total_time += time;
+
+      std::string comment = param.comment;
+      while (!comment.empty() && (comment.back() == '\n' || comment.back() == '\r')) comment.pop_back();
+
+      kernels.push_back({{"name", key.name},
+                         {"volume", key.volume},
+                         {"aux", key.aux},
+                         {"policy", is_policy},
+                         {"calls", param.n_calls},
+                         {"time_per_call", param.time},
+                         {"total_time", time},
+                         {"flops_per_call", param.flops},
+                         {"bytes_per_call", param.bytes},
+                         {"gflops", param.time > 0 ? 1e-9 * param.flops / param.time : 0.0},
+                         {"gbytes", param.time > 0 ? 1e-9 * param.bytes / param.time : 0.0},
+                         {"arithmetic_intensity",
+                          param.bytes > 0 ? static_cast<double>(param.flops) / param.bytes : 0.0},
+                         {"comment", comment}});
+    }
+
+    // order the kernels by decreasing total time as in the tsv profile
+    std::stable_sort(kernels.begin(), kernels.end(), [](const json &a, const json &b) {
+      return a["total_time"].get<double>() > b["total_time"].get<double>();
+    });
+
+    json profile = {{"schema", "quda-kernel-profile"},
+                    {"version", 1},
+                    {"label", label},
+                    {"quda_version", quda_version},
+#ifdef GITVERSION
+                    {"git", gitversion},
+#endif
+                    {"hash", quda_hash},
+                    {"total_kernel_time", total_time},
+                    {"kernels", kernels}};
+    out << profile.dump(1) << std::endl;
+  }
+
   /**
    * Serialize trace to an ostream, useful for writing to a file or sending to other nodes.
    */
@@ -296,36 +425,379 @@ namespace quda
   }
 
   /**
-   * Distribute the tunecache from node 0 to all other nodes.
+   * Append a string to a binary buffer, prefixed by its length.
+   */
+  static void packString(std::vector<char> &buffer, const char *str)
+  {
+    uint16_t length = strlen(str);
+    const char *length_ = reinterpret_cast<const char *>(&length);
+    buffer.insert(buffer.end(), length_, length_ + sizeof(length));
+    buffer.insert(buffer.end(), str, str + length);
+  }
+
+  /**
+   * Extract a length-prefixed string from a binary buffer, returning the position following the string.
+   */
+  static const char *unpackString(const char *buffer, std::string &str)
+  {
+    uint16_t length;
+    memcpy(&length, buffer, sizeof(length));
+    buffer += sizeof(length);
+    str.assign(buffer, length);
+    return buffer + length;
+  }
+
+  /**
+   * Extract a length-prefixed string from a binary buffer into a fixed-length character array.
+   */
+  static const char *unpackString(const char *buffer, char *str, int max_length)
+  {
+    std::string str_;
+    buffer = unpackString(buffer, str_);
+    int check = snprintf(str, max_length, "%s", str_.c_str());
+    if (check < 0 || check >= max_length) errorQuda("Error unpacking string (check = %d)", check);
+    return buffer;
+  }
+
+  /**
+   * The launch parameters of a tunecache entry that are of fixed size, used for binary packing
+   */
+  struct PackedTuneParam {
+    unsigned int block[3];
+    unsigned int grid[3];
+    unsigned int shared_bytes;
+    int aux[4];
+    int host[4];
+    float time;
+  };
+
+  /**
+   * Append a tunecache entry to a binary buffer, useful for sending to other nodes.
+   */
+  static void packTuneCacheEntry(std::vector<char> &buffer, const TuneKey &key, const TuneParam &param)
+  {
+    packString(buffer, key.volume);
+    packString(buffer, key.name);
+    packString(buffer, key.aux);
+
+    PackedTuneParam packed = {{param.block.x, param.block.y, param.block.z},
+                              {param.grid.x, param.grid.y, param.grid.z},
+                              param.shared_bytes,
+                              {param.aux.x, param.aux.y, param.aux.z, param.aux.w},
+                              {param.host.x, param.host.y, param.host.z, param.host.w},
+                              param.time};
+    const char *packed_ = reinterpret_cast<const char *>(&packed);
+    buffer.insert(buffer.end(), packed_, packed_ + sizeof(packed));
+
+    std::string comment = param.comment.substr(0, std::numeric_limits<uint16_t>::max());
+    packString(buffer, comment.c_str());
+  }
+
+  /**
+   * Extract the key of a tunecache entry from a binary buffer, returning the position following the key.
+   */
+  static const char *unpackTuneKey(const char *buffer, TuneKey &key)
+  {
+    buffer = unpackString(buffer, key.volume, key.volume_n);
+    buffer = unpackString(buffer, key.name, key.name_n);
+    return unpackString(buffer, key.aux, key.aux_n);
+  }
+
+  /**
+   * Extract a tunecache entry from a binary buffer and insert it into the tunecache, returning the position
+   * following the entry.  The key of the entry is returned in key.  If insert is false the entry is skipped.
+   */
+  static const char *unpackTuneCacheEntry(const char *buffer, TuneKey &key, bool insert = true)
+  {
+    buffer = unpackTuneKey(buffer, key);
+
+    PackedTuneParam packed;
+    memcpy(&packed, buffer, sizeof(packed));
+    buffer += sizeof(packed);
+
+    TuneParam param;
+    param.block = dim3(packed.block[0], packed.block[1], packed.block[2]);
+    param.grid = dim3(packed.grid[0], packed.grid[1], packed.grid[2]);
+    param.shared_bytes = packed.shared_bytes;
+    param.aux = make_int4(packed.aux[0], packed.aux[1], packed.aux[2], packed.aux[3]);
+    param.host = make_int4(packed.host[0], packed.host[1], packed.host[2], packed.host[3]);
+    param.time = packed.time;
+
+    buffer = unpackString(buffer, param.comment);
+    if (!insert) return buffer;
+
+    // preserve the profile counters if we already have this entry
+    auto entry = findTuneCache(key);
+    if (entry != tunecache.end()) {
+      param.n_calls = entry->second.n_calls;
+      param.flops = entry->second.flops;
+      param.bytes = entry->second.bytes;
+    }
+    insertTuneCache(key, param);
+
+    return buffer;
+  }
+
+  /**
+   * Distribute tunecache entries from node 0 to all other nodes.  If
+   * delta is true, then only those entries that have been tuned
+   * since the last broadcast are distributed, else the entire
+   * tunecache is distributed.  Entries are sent using a compact
+   * binary encoding, with the text serialization reserved for the
+   * on-disk tunecache.
    */
-  static void broadcastTuneCache()
+  static void broadcastTuneCache(bool delta)
   {
 #ifdef MULTI_GPU
-    std::stringstream serialized;
+    std::vector<char> packed;
     size_t size;
 
     if (comm_rank_global() == 0) {
-      serializeTuneCache(serialized);
-      size = serialized.str().length();
+      if (delta) {
+        for (auto &key : broadcast_pending) packTuneCacheEntry(packed, key, findTuneCache(key)->second);
+      } else {
+        for (auto &entry : tunecache) packTuneCacheEntry(packed, entry.first, entry.second);
+      }
+      size = packed.size();
     }
     comm_broadcast_global(&size, sizeof(size_t));
 
     if (size > 0) {
-      if (comm_rank_global() == 0) {
-        comm_broadcast_global(const_cast<char *>(serialized.str().c_str()), size);
-      } else {
-        std::vector<char> serstr(size + 1);
-        comm_broadcast_global(serstr.data(), size);
-        serstr[size] = '\0'; // null-terminate
-        serialized.str(serstr.data());
-        deserializeTuneCache(serialized);
+      if (comm_rank_global() != 0) packed.resize(size);
+      comm_broadcast_global(packed.data(), size);
+      if (comm_rank_global() != 0) {
+        const char *buffer = packed.data();
+        TuneKey key;
+        while (buffer < packed.data() + size) buffer = unpackTuneCacheEntry(buffer, key);
       }
     }
+#else
+    (void)delta;
+#endif
+    broadcast_pending.clear();
+  }
+
+  /**
+   * Gather the tunecache entries that have been tuned on other nodes,
+   * but which are not present on node 0, onto node 0.  This is the
+   * case for kernels that are tuned without a global reduction, and
+   * thus are not broadcast from node 0, e.g., if the local volume
+   * differs between nodes.  Gathered entries are queued for saving.
+   * Kernels tuned with a global reduction are tuned on every node at
+   * once, so node 0 only distributes the hashes of the entries it has
+   * tuned since the last save; any other entry sent to node 0 that it
+   * already holds is discarded on receipt.
+   */
+  static void gatherTuneCache()
+  {
+#ifdef MULTI_GPU
+    const size_t n_rank = comm_size_global();
+    const bool root = comm_rank_global() == 0;
+
+    // first distribute the hashes of the keys tuned by node 0 since the last save
+    std::vector<uint64_t> hash;
+    size_t n_hash = 0;
+    if (root) {
+      hash.reserve(journal_pending.size());
+      for (auto &key : journal_pending) hash.push_back(key.hash());
+      n_hash = hash.size();
+    }
+    comm_broadcast_global(&n_hash, sizeof(n_hash));
+    if (!root) hash.resize(n_hash);
+    comm_broadcast_global(hash.data(), n_hash * sizeof(uint64_t));
+
+    // pack the locally tuned entries that node 0 has not seen
+    std::vector<char> packed;
+    if (!root) {
+      std::unordered_set<uint64_t> seen(hash.begin(), hash.end());
+      for (auto &key : journal_pending)
+        if (seen.find(key.hash()) == seen.end()) packTuneCacheEntry(packed, key, findTuneCache(key)->second);
+      journal_pending.clear();
+    }
+
+    // gather the packed sizes, and then the packed entries padded to the largest size
+    size_t size = packed.size();
+    std::vector<size_t> sizes(root ? n_rank : 0);
+    comm_gather_global(sizes.data(), &size, sizeof(size_t));
+    size_t max_size = root ? *std::max_element(sizes.begin(), sizes.end()) : 0;
+    comm_broadcast_global(&max_size, sizeof(max_size));
+    if (max_size == 0) return;
+
+    packed.resize(max_size);
+    std::vector<char> gathered(root ? n_rank * max_size : 0);
+    comm_gather_global(gathered.data(), packed.data(), max_size);
+
+    if (root) {
+      for (size_t r = 1; r < n_rank; r++) {
+        const char *buffer = gathered.data() + r * max_size;
+        const char *end = buffer + sizes[r];
+        while (buffer < end) {
+          // node 0 may already hold the entry, or two nodes may have tuned the same kernel
+          TuneKey key;
+          unpackTuneKey(buffer, key);
+          const bool missing = findTuneCache(key) == tunecache.end();
+          buffer = unpackTuneCacheEntry(buffer, key, missing);
+          if (missing) journal_pending.push_back(key);
+        }
+      }
+    }
+#endif
+  }
+
+  static const std::string journal_prefix = "tunecache_journal.";
+
+  /**
+   * Return the path of the journal belonging to this process.  Each
+   * process only ever appends to its own journal, so no locking is
+   * required even if many jobs share the resource path.
+   */
+  static std::string journalPath()
+  {
+    return resource_path + "/" + journal_prefix + comm_hostname() + "." + std::to_string(getpid()) + ".tsv";
+  }
+
+  /**
+   * Return the paths of all journals in the resource path, sorted so
+   * that merging is deterministic.
+   */
+  static std::vector<std::string> journalPaths()
+  {
+    std::vector<std::string> paths;
+    DIR *dir = opendir(resource_path.c_str());
+    if (!dir) return paths;
+    while (struct dirent *entry = readdir(dir)) {
+      std::string name(entry->d_name);
+      if (name.compare(0, journal_prefix.size(), journal_prefix) == 0 && name.size() > 4
+          && name.compare(name.size() - 4, 4, ".tsv") == 0)
+        paths.push_back(resource_path + "/" + name);
+    }
+    closedir(dir);
+    std::sort(paths.begin(), paths.end());
+    return paths;
+  }
+
+  /**
+   * Write the header of a tunecache or journal file, identifying the
+   * version and build of QUDA that wrote it.
+   */
+  static void writeTuneCacheHeader(std::ostream &out, const char *token)
+  {
+    time_t now;
+    time(&now);
+    out << token << "\t" << quda_version;
+#ifdef GITVERSION
+    out << "\t" << gitversion;
+#else
+    out << "\t" << quda_version;
 #endif
+    out << "\t" << quda_hash << "\t# Last updated " << ctime(&now) << std::endl;
+    out << std::setw(16) << "volume"
+        << "\tname\taux\tblock.x\tblock.y\tblock.z\tgrid.x\tgrid.y\tgrid.z\tshared_bytes\taux.x\taux.y\taux."
+           "z\taux.w\thost.x\thost.y\thost.z\thost.w\ttime\tcomment"
+        << std::endl;
+  }
+
+  /**
+   * Read the header of a tunecache or journal file, returning whether
+   * it is well formed.  Whether it was written by the present version
+   * and build of QUDA is returned in match.
+   */
+  static bool readTuneCacheHeader(std::istream &in, const char *token, bool &match)
+  {
+    std::string line, t;
+    std::stringstream ls;
+
+    if (!in.good()) return false;
+    getline(in, line);
+    ls.str(line);
+    ls >> t;
+    if (t.compare(token)) return false;
+
+    match = true;
+    ls >> t;
+    if (t.compare(quda_version)) match = false;
+    ls >> t;
+#ifdef GITVERSION
+    if (t.compare(gitversion)) match = false;
+#else
+    if (t.compare(quda_version)) match = false;
+#endif
+    ls >> t;
+    if (t.compare(quda_hash)) match = false;
+
+    if (!in.good()) return false;
+    getline(in, line); // eat the blank line
+
+    if (!in.good()) return false;
+    getline(in, line); // eat the description line
+
+    return !in.fail();
+  }
+
+  enum class JournalStatus { read, missing, mismatch, malformed };
+
+  /**
+   * Read a journal into cache, or into the tunecache if cache is not
+   * set.  Journals written by a different version or build of QUDA,
+   * or without a complete header (e.g., written by an older QUDA that
+   * died before writing it), are skipped with a warning.
+   */
+  static JournalStatus readJournal(const std::string &path, map *cache = nullptr)
+  {
+    std::ifstream file(path.c_str());
+    if (!file) return JournalStatus::missing; // may have been removed by its owner in the meantime
+    bool match;
+    if (!readTuneCacheHeader(file, "tunecache_journal", match)) {
+      warningQuda("Skipping journal %s with a bad header", path.c_str());
+      return JournalStatus::malformed;
+    }
+    if (!match && version_check) {
+      warningQuda("Skipping journal %s written by a different QUDA version or build", path.c_str());
+      return JournalStatus::mismatch;
+    }
+    deserializeTuneCache(file, cache);
+    return JournalStatus::read;
+  }
+
+  /**
+   * Return whether the journal at path belongs to a process on this
+   * host that is no longer running, and so will never be merged and
+   * removed by its owner.
+   */
+  static bool orphanedJournal(const std::string &path)
+  {
+    std::string host_prefix = resource_path + "/" + journal_prefix + comm_hostname() + ".";
+    if (path.compare(0, host_prefix.size(), host_prefix) != 0) return false; // cannot check other hosts
+    std::string pid_str = path.substr(host_prefix.size(), path.size() - host_prefix.size() - 4);
+    if (pid_str.empty() || pid_str.find_first_not_of("0123456789") != std::string::npos) return false;
+    pid_t pid = static_cast<pid_t>(std::stol(pid_str));
+    return pid != getpid() && kill(pid, 0) == -1 && errno == ESRCH;
   }
 
-  /*
-   * Read tunecache from disk.
+  /**
+   * Write cache to path.  We write to a temporary file that is then
+   * renamed over the target, so readers never observe a partially
+   * written file and no lock is required.
+   */
+  static bool writeTuneCacheFile(const std::string &path, const map &cache)
+  {
+    std::string tmp_path = path + "." + comm_hostname() + "." + std::to_string(getpid()) + ".tmp";
+    std::ofstream file(tmp_path.c_str());
+    writeTuneCacheHeader(file, "tunecache");
+    serializeTuneCache(file, cache);
+    file.close();
+
+    if (!file || rename(tmp_path.c_str(), path.c_str())) {
+      warningQuda("Unable to write %s.  Tuned launch parameters will not be cached to disk.", path.c_str());
+      remove(tmp_path.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Read tunecache from disk.  The tunecache comprises the main file
+   * together with any journals that have not yet been merged into it.
    */
   void loadTuneCache()
   {
@@ -336,9 +808,8 @@ namespace quda
 
     char *path;
     struct stat pstat;
-    std::string cache_path, line, token;
+    std::string cache_path;
     std::ifstream cache_file;
-    std::stringstream ls;
 
     path = getenv("QUDA_RESOURCE_PATH");
 
@@ -354,16 +825,13 @@ namespace quda
       resource_path = path;
     }
 
-    bool version_check = true;
     char *override_version_env = getenv("QUDA_TUNE_VERSION_CHECK");
     if (override_version_env && strcmp(override_version_env, "0") == 0) {
       version_check = false;
       warningQuda("Disabling QUDA tunecache version check");
     }
 
-#ifdef MULTI_GPU
     if (comm_rank_global() == 0) {
-#endif
 
       cache_path = resource_path;
       cache_path += "/tunecache.tsv";
@@ -371,134 +839,173 @@ namespace quda
 
       if (cache_file) {
 
-        if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-        getline(cache_file, line);
-        ls.str(line);
-        ls >> token;
-        if (token.compare("tunecache")) errorQuda("Bad format in %s", cache_path.c_str());
-        ls >> token;
-        if (version_check && token.compare(quda_version))
-          errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the "
-                    "QUDA_RESOURCE_PATH environment variable to point to a new path.",
-                    cache_path.c_str());
-        ls >> token;
-#ifdef GITVERSION
-        if (version_check && token.compare(gitversion))
-          errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the "
+        bool match;
+        if (!readTuneCacheHeader(cache_file, "tunecache", match)) errorQuda("Bad format in %s", cache_path.c_str());
+        if (!match && version_check)
+          errorQuda("Cache file %s does not match current QUDA version or build. \nPlease delete this file or set the "
                     "QUDA_RESOURCE_PATH environment variable to point to a new path.",
                     cache_path.c_str());
-#else
-      if (version_check && token.compare(quda_version))
-        errorQuda("Cache file %s does not match current QUDA version. \nPlease delete this file or set the "
-                  "QUDA_RESOURCE_PATH environment variable to point to a new path.",
-                  cache_path.c_str());
-#endif
-        ls >> token;
-        if (version_check && token.compare(quda_hash))
-          errorQuda("Cache file %s does not match current QUDA build. \nPlease delete this file or set the "
-                    "QUDA_RESOURCE_PATH environment variable to point to a new path.",
-                    cache_path.c_str());
-
-        if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-        getline(cache_file, line); // eat the blank line
-
-        if (!cache_file.good()) errorQuda("Bad format in %s", cache_path.c_str());
-        getline(cache_file, line); // eat the description line
 
         deserializeTuneCache(cache_file);
-
         cache_file.close();
-        initial_cache_size = tunecache.size();
-
-        if (getVerbosity() >= QUDA_SUMMARIZE) {
-          printfQuda("Loaded %d sets of cached parameters from %s\n", static_cast<int>(initial_cache_size),
-                     cache_path.c_str());
-        }
 
       } else {
         warningQuda("Cache file not found.  All kernels will be re-tuned (if tuning is enabled).");
       }
 
-#ifdef MULTI_GPU
+      auto journals = journalPaths();
+      for (auto &journal : journals) readJournal(journal);
+
+      if (getVerbosity() >= QUDA_SUMMARIZE && tunecache.size() > 0) {
+        printfQuda("Loaded %d sets of cached parameters from %s (including %lu journals)\n",
+                   static_cast<int>(tunecache.size()), cache_path.c_str(), journals.size());
+      }
     }
-#endif
 
-    broadcastTuneCache();
+    broadcastTuneCache(false);
   }
 
   /**
-   * Write tunecache to disk.
+   * Append the entries tuned since the last save to this process's
+   * journal.  The journal is append-only, so a crash at any point
+   * leaves the previously written entries intact.  A new journal is
+   * written to a temporary file together with its header and then
+   * renamed into place, so other processes never see a journal
+   * without a complete header.
    */
-  void saveTuneCache(bool error)
+  static void appendJournal()
   {
-    time_t now;
-    int lock_handle;
-    std::string lock_path, cache_path;
-    std::ofstream cache_file;
-
-    if (resource_path.empty()) return;
-
-      // FIXME: We should really check to see if any nodes have tuned a kernel that was not also tuned on node 0, since as things
-      //       stand, the corresponding launch parameters would never get cached to disk in this situation.  This will come up if we
-      //       ever support different subvolumes per GPU (as might be convenient for lattice volumes that don't divide evenly).
-
-#ifdef MULTI_GPU
-    if (comm_rank_global() == 0) {
-#endif
+    std::string journal_path = journalPath();
+    struct stat jstat;
+    bool exists = stat(journal_path.c_str(), &jstat) == 0 && jstat.st_size > 0;
+
+    std::string write_path = exists ? journal_path : journal_path + ".tmp";
+    std::ofstream journal(write_path.c_str(), exists ? std::ios::app : std::ios::trunc);
+    if (!exists) writeTuneCacheHeader(journal, "tunecache_journal");
+    for (auto &key : journal_pending) serializeTuneCacheEntry(journal, key, findTuneCache(key)->second);
+    journal.close();
+
+    if (!journal || (!exists && rename(write_path.c_str(), journal_path.c_str()))) {
+      warningQuda("Unable to write to journal %s", journal_path.c_str());
+      if (!exists) remove(write_path.c_str());
+    }
+  }
 
-      if (tunecache.size() == initial_cache_size && !error) return;
+  /**
+   * Fold the main tunecache file, all journals and the present
+   * tunecache into a new main file.  The whole merge is serialized
+   * across processes by an advisory lock, and a journal is only
+   * removed once we have re-read the main file and confirmed that all
+   * of its entries are present.  We remove our own journal, together
+   * with any orphaned by processes on this host that have died before
+   * merging; other journals are left for their owners to remove.  If
+   * the lock cannot be taken (e.g., the filesystem does not support
+   * flock()) we still write the main file but keep every journal, so
+   * nothing is lost and the journals are folded in by a later merge.
+   */
+  static void mergeTuneCache()
+  {
+    std::string cache_path = resource_path + "/tunecache.tsv";
+    std::string lock_path = resource_path + "/tunecache.lock";
+    std::string journal_path = journalPath();
+    map merged;
+    std::map<std::string, map> journals; // entries of each removable journal
+
+    int lock_handle = open(lock_path.c_str(), O_RDWR | O_CREAT, 0666);
+    bool locked = lock_handle != -1 && flock(lock_handle, LOCK_EX) == 0;
+    if (!locked) warningQuda("Unable to lock %s.  Journals will not be removed.", lock_path.c_str());
+
+    std::ifstream cache_file(cache_path.c_str());
+    if (cache_file) {
+      bool match;
+      if (!readTuneCacheHeader(cache_file, "tunecache", match))
+        warningQuda("Replacing cache file %s with a bad header", cache_path.c_str());
+      else if (match || !version_check)
+        deserializeTuneCache(cache_file, &merged);
+      else
+        warningQuda("Replacing cache file %s written by a different QUDA version or build", cache_path.c_str());
+      cache_file.close();
+    }
 
-      // Acquire lock.  Note that this is only robust if the filesystem supports flock() semantics, which is true for
-      // NFS on recent versions of linux but not Lustre by default (unless the filesystem was mounted with "-o flock").
-      lock_path = resource_path + "/tunecache.lock";
-      lock_handle = open(lock_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
-      if (lock_handle == -1) {
-        warningQuda("Unable to lock cache file.  Tuned launch parameters will not be cached to disk.  "
-                    "If you are certain that no other instances of QUDA are accessing this filesystem, "
-                    "please manually remove %s",
-                    lock_path.c_str());
-        return;
+    for (auto &journal : journalPaths()) {
+      if (journal == journal_path || orphanedJournal(journal)) {
+        map entries;
+        auto status = readJournal(journal, &entries);
+        if (status == JournalStatus::read || status == JournalStatus::malformed) {
+          // an orphaned journal with a bad header holds nothing we can read, so it is removed as if it were empty
+          for (auto &entry : entries) merged[entry.first] = entry.second;
+          journals[journal] = std::move(entries);
+        }
+      } else {
+        readJournal(journal, &merged);
       }
-      char msg[] = "If no instances of applications using QUDA are running,\n"
-                   "this lock file shouldn't be here and is safe to delete.";
-      int stat = write(lock_handle, msg, sizeof(msg)); // check status to avoid compiler warning
-      if (stat == -1) warningQuda("Unable to write to lock file for some bizarre reason");
+    }
+    for (auto &entry : tunecache) merged[entry.first] = entry.second;
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      printfQuda("Saving %d sets of cached parameters to %s\n", static_cast<int>(merged.size()), cache_path.c_str());
+    }
 
-      cache_path = resource_path + (error ? "/tunecache_error.tsv" : "/tunecache.tsv");
+    if (writeTuneCacheFile(cache_path, merged) && locked) {
+      // verify what actually landed on disk before removing anything
+      map check;
       cache_file.open(cache_path.c_str());
+      bool match;
+      if (cache_file && readTuneCacheHeader(cache_file, "tunecache", match) && (match || !version_check))
+        deserializeTuneCache(cache_file, &check);
+      cache_file.close();
 
-      if (getVerbosity() >= QUDA_SUMMARIZE) {
-        printfQuda("Saving %d sets of cached parameters to %s\n", static_cast<int>(tunecache.size()), cache_path.c_str());
+      for (auto &journal : journals) {
+        bool verified = true;
+        for (auto &entry : journal.second)
+          if (check.find(entry.first) == check.end()) verified = false;
+        if (!verified) continue;
+        if (journal.first != journal_path && getVerbosity() >= QUDA_VERBOSE)
+          printfQuda("Removing orphaned journal %s\n", journal.first.c_str());
+        remove(journal.first.c_str());
       }
+    }
 
-      time(&now);
-      cache_file << "tunecache\t" << quda_version;
-#ifdef GITVERSION
-      cache_file << "\t" << gitversion;
-#else
-    cache_file << "\t" << quda_version;
-#endif
-      cache_file << "\t" << quda_hash << "\t# Last updated " << ctime(&now) << std::endl;
-      cache_file << std::setw(16) << "volume"
-                 << "\tname\taux\tblock.x\tblock.y\tblock.z\tgrid.x\tgrid.y\tgrid.z\tshared_bytes\taux.x\taux.y\taux."
-                    "z\taux.w\ttime\tcomment"
-                 << std::endl;
-      serializeTuneCache(cache_file);
-      cache_file.close();
-
-      // Release lock.
+    if (lock_handle != -1) {
+      if (locked) flock(lock_handle, LOCK_UN);
       close(lock_handle);
-      remove(lock_path.c_str());
+    }
+  }
 
-      initial_cache_size = tunecache.size();
+  /**
+   * Write tunecache to disk.  Newly tuned entries from all nodes are
+   * gathered onto node 0, which appends them to its journal and then
+   * merges the journals into the main tunecache file.
+   */
+  void saveTuneCache(bool error)
+  {
+    if (resource_path.empty()) return;
 
-#ifdef MULTI_GPU
-    } else {
-      // give process 0 time to write out its tunecache if needed, but
-      // doesn't cause a hang if error is not triggered on process 0
-      if (error) sleep(10);
+    if (error) {
+      // an error may be raised on a subset of nodes, so we cannot
+      // communicate here: write out the tunecache on node 0 only
+      if (comm_rank_global() == 0) {
+        std::string cache_path = resource_path + "/tunecache_error.tsv";
+        if (getVerbosity() >= QUDA_SUMMARIZE) {
+          printfQuda("Saving %d sets of cached parameters to %s\n", static_cast<int>(tunecache.size()),
+                     cache_path.c_str());
+        }
+        writeTuneCacheFile(cache_path, tunecache);
+      } else {
+        // give process 0 time to write out its tunecache if needed, but
+        // doesn't cause a hang if error is not triggered on process 0
+        sleep(10);
+      }
+      return;
+    }
+
+    gatherTuneCache();
+
+    if (comm_rank_global() == 0 && !journal_pending.empty()) {
+      appendJournal();
+      journal_pending.clear();
+      mergeTuneCache();
     }
-#endif
   }
 
   static bool policy_tuning = false;
@@ -526,8 +1033,8 @@ namespace quda
   {
     time_t now;
     int lock_handle;
-    std::string lock_path, profile_path, async_profile_path, trace_path;
-    std::ofstream profile_file, async_profile_file, trace_file;
+    std::string lock_path, profile_path, async_profile_path, trace_path, json_profile_path;
+    std::ofstream profile_file, async_profile_file, trace_file, json_profile_file;
 
     if (resource_path.empty()) return;
 
@@ -560,10 +1067,12 @@ namespace quda
         warningQuda(
           "Environment variable QUDA_PROFILE_OUTPUT_BASE not set; writing to profile.tsv and profile_async.tsv");
         profile_path = resource_path + "/profile_" + std::to_string(count) + ".tsv";
+        json_profile_path = resource_path + "/profile_" + std::to_string(count) + ".json";
         async_profile_path = resource_path + "/profile_async_" + std::to_string(count) + ".tsv";
         if (traceEnabled()) trace_path = resource_path + "/trace_" + std::to_string(count) + ".tsv";
       } else {
         profile_path = resource_path + "/" + profile_fname + "_" + std::to_string(count) + ".tsv";
+        json_profile_path = resource_path + "/" + profile_fname + "_" + std::to_string(count) + ".json";
         async_profile_path = resource_path + "/" + profile_fname + "_" + std::to_string(count) + "_async.tsv";
         if (traceEnabled())
           trace_path = resource_path + "/" + profile_fname + "_trace_" + std::to_string(count) + ".tsv";
@@ -591,6 +1100,7 @@ namespace quda
 
         printfQuda("Saving %d sets of cached parameters to %s\n", n_entry, profile_path.c_str());
         printfQuda("Saving %d sets of cached profiles to %s\n", n_policy, async_profile_path.c_str());
+        printfQuda("Saving kernel profile with throughput metrics to %s\n", json_profile_path.c_str());
         if (traceEnabled())
           printfQuda("Saving trace list with %lu entries to %s\n", trace_list.size(), trace_path.c_str());
       }
@@ -634,6 +1144,10 @@ namespace quda
       profile_file.close();
       async_profile_file.close();
 
+      json_profile_file.open(json_profile_path.c_str());
+      serializeProfileJson(json_profile_file, Label);
+      json_profile_file.close();
+
       if (traceEnabled()) {
         trace_file << "trace"
                    << "\t" << quda_version;
@@ -669,16 +1183,112 @@ namespace quda
     shared_bytes(0),
     set_max_shared_bytes(false),
     aux(),
+    host(),
     time(FLT_MAX),
-    n_calls(0)
+    n_calls(0),
+    flops(0),
+    bytes(0)
   {
     aux = make_int4(1, 1, 1, 1);
+    host = make_int4(0, 1, 0, 0);
   }
 
   int Tunable::blockStep() const { return device::warp_size(); }
   int Tunable::blockMin() const { return device::warp_size(); }
 
+  // the loop nests explored by the host autotuner, see host_launch_param
+  static constexpr int host_nest_max = 3;
+  // the maximum chunks per thread explored by the host autotuner
+  static constexpr int host_chunks_max = 16;
+
+  void Tunable::initHostParam(TuneParam &param) const
+  {
+    param.host = make_int4(host::max_threads(), 1, static_cast<int>(host::schedule_t::static_chunk), 0);
+  }
+
+  bool Tunable::advanceHostParam(TuneParam &param) const
+  {
+    // loop nest and site blocking
+    if (tuneHostNest() && param.host.w < host_nest_max) {
+      param.host.w++;
+      return true;
+    }
+    param.host.w = 0;
+
+    // schedule: dynamic scheduling is only distinct with more than one chunk per thread
+    if (param.host.z == static_cast<int>(host::schedule_t::static_chunk) && param.host.y > 1) {
+      param.host.z = static_cast<int>(host::schedule_t::dynamic_chunk);
+      return true;
+    }
+    param.host.z = static_cast<int>(host::schedule_t::static_chunk);
+
+    // chunks per thread
+    if (param.host.y < host_chunks_max) {
+      param.host.y *= 4;
+      return true;
+    }
+    param.host.y = 1;
+
+    // thread count: we explore the full pool down to a quarter of the pool
+    if (param.host.x > std::max(host::max_threads() / 4, 1)) {
+      param.host.x /= 2;
+      return true;
+    }
+    param.host.x = host::max_threads();
+
+    return false;
+  }
+
+  TuneKey Tunable::launchKey() const
+  {
+    TuneKey key = tuneKey();
+    if (use_managed_memory()) strcat(key.aux, ",managed");
+    if (tuneLocation() == QUDA_CPU_FIELD_LOCATION) {
+      char threads[16];
+      i32toa(threads, host::max_threads());
+      strcat(key.aux, ",host_threads=");
+      strcat(key.aux, threads);
+    }
+    return key;
+  }
+
+  /**
+   * Launch memo, which outlives the Tunable instances (most of which
+   * are constructed anew for every call).  It is keyed by the address
+   * of the kernel name returned by Tunable::tuneKeyParts, and holds
+   * the tunecache entries most recently launched with that name.  A
+   * hit is confirmed by comparing the volume and aux strings with
+   * those of the interned key, so no key is built or hashed.  Entries
+   * point into the tunecache, whose entries are never erased.
+   */
+  struct LaunchMemoEntry {
+    const TuneKey *key;
+    TuneParam *param;
+  };
+  static constexpr size_t launch_memo_ways = 8; // entries retained per name, e.g., the kernel types of a dslash
+  static std::unordered_map<const char *, std::vector<LaunchMemoEntry>> launch_memo;
+
+  static LaunchMemoEntry *findLaunchMemo(const char *vol, const char *name, const char *aux)
+  {
+    auto search = launch_memo.find(name);
+    if (search == launch_memo.end()) return nullptr;
+    for (auto &entry : search->second)
+      if (strcmp(entry.key->volume, vol) == 0 && strcmp(entry.key->aux, aux) == 0) return &entry;
+    return nullptr;
+  }
+
+  static void insertLaunchMemo(const char *name, map::iterator entry)
+  {
+    auto &entries = launch_memo[name];
+    if (entries.size() == launch_memo_ways) entries.erase(entries.begin()); // evict the oldest
+    entries.push_back({&entry->first, &entry->second});
+  }
+
   static TimeProfile launchTimer("tuneLaunch");
+#ifdef LAUNCH_TIMER
+  static size_t launch_memo_hits = 0;     // launches served from the launch memo
+  static size_t launch_index_lookups = 0; // launches that required building the key and a tunecache lookup
+#endif
 
   /**
    * @brief Compare two TuneParams with respect to which has the lower time.
@@ -693,8 +1303,8 @@ namespace quda
    *
    */
 
-  NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(TuneParam, block, grid, shared_bytes, set_max_shared_bytes, aux, comment, time,
-                                     n_calls)
+  NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(TuneParam, block, grid, shared_bytes, set_max_shared_bytes, aux, host, comment,
+                                     time, n_calls, flops, bytes)
 
   class TuneCandidates : public std::priority_queue<TuneParam, std::vector<TuneParam>, TuneParamComp>
   {
@@ -802,9 +1412,43 @@ namespace quda
     launchTimer.TPSTART(QUDA_PROFILE_INIT);
 #endif
 
-    TuneKey key = tunable.tuneKey();
-    if (use_managed_memory()) strcat(key.aux, ",managed");
-    last_key = key;
+    // the launch memo applies when the key is exactly the one built from its parts, i.e., without the
+    // decorations added by launchKey()
+    const char *vol_part, *name_part, *aux_part;
+    const bool memo = enabled == QUDA_TUNE_YES && tunable.tuneKeyParts(vol_part, name_part, aux_part)
+      && !use_managed_memory() && tunable.tuneLocation() != QUDA_CPU_FIELD_LOCATION;
+
+    // first check the launch memo, which avoids building the key
+    const TuneKey *tuned_key = nullptr;
+    TuneParam *tuned_param = nullptr;
+    if (memo) {
+      auto entry = findLaunchMemo(vol_part, name_part, aux_part);
+      if (entry) {
+        tuned_key = entry->key;
+        tuned_param = entry->param;
+#ifdef LAUNCH_TIMER
+        launch_memo_hits++;
+#endif
+      }
+    }
+
+    // else build the key and look it up in the tunecache
+    TuneKey built_key;
+    if (!tuned_param) {
+      built_key = tunable.launchKey();
+      if (enabled == QUDA_TUNE_YES) {
+        auto entry = findTuneCache(built_key);
+        if (entry != tunecache.end()) {
+          tuned_key = &entry->first;
+          tuned_param = &entry->second;
+          if (memo) insertLaunchMemo(name_part, entry);
+        }
+#ifdef LAUNCH_TIMER
+        launch_index_lookups++;
+#endif
+      }
+    }
+    const TuneKey &key = tuned_key ? *tuned_key : built_key;
 
 #ifdef LAUNCH_TIMER
     launchTimer.TPSTOP(QUDA_PROFILE_INIT);
@@ -812,17 +1456,17 @@ namespace quda
 #endif
 
     static const Tunable *active_tunable; // for error checking
-    it = tunecache.find(key);
 
-    // first check if we have the tuned value and return if we have it
-    if (enabled == QUDA_TUNE_YES && it != tunecache.end()) {
+    // return the tuned value if we have it
+    if (tuned_param) {
+      last_key_ptr = tuned_key;
 
 #ifdef LAUNCH_TIMER
       launchTimer.TPSTOP(QUDA_PROFILE_PREAMBLE);
       launchTimer.TPSTART(QUDA_PROFILE_COMPUTE);
 #endif
 
-      TuneParam &param_tuned = it->second;
+      TuneParam &param_tuned = *tuned_param;
 
       if (verbosity >= QUDA_DEBUG_VERBOSE) {
         printfQuda("Launching %s with %s at vol=%s with %s\n", key.name, key.aux, key.volume,
@@ -837,7 +1481,14 @@ namespace quda
       tunable.checkLaunchParam(param_tuned);
 
       // we could be tuning outside of the current scope
-      if (!tuning && profile_count) param_tuned.n_calls++;
+      if (!tuning && profile_count) {
+        // the operation counts are recorded on the first call since the profile was flushed
+        if (param_tuned.n_calls == 0) {
+          param_tuned.flops = tunable.flops();
+          param_tuned.bytes = tunable.bytes();
+        }
+        param_tuned.n_calls++;
+      }
 
 #ifdef LAUNCH_TIMER
       launchTimer.TPSTOP(QUDA_PROFILE_EPILOGUE);
@@ -857,6 +1508,9 @@ namespace quda
     launchTimer.TPSTOP(QUDA_PROFILE_TOTAL);
 #endif
 
+    last_key = key;
+    last_key_ptr = &last_key;
+
     static TuneParam param;
 
     if (enabled == QUDA_TUNE_NO) {
@@ -892,14 +1546,21 @@ namespace quda
           printfQuda("Tuning %s with %s at vol=%s\n", key.name, key.aux, key.volume);
         }
 
+        // host instances are timed on the host and additionally tune the host launch parameters
+        const bool host_tune = tunable.tuneLocation() == QUDA_CPU_FIELD_LOCATION;
         const auto &stream = device::get_default_stream();
-        device_timer_t timer(stream);
+        device_timer_t device_timer(stream);
+        host_timer_t host_timer;
+        auto timer_start = [&]() { host_tune ? host_timer.start() : device_timer.start(); };
+        auto timer_stop = [&]() { host_tune ? host_timer.stop() : device_timer.stop(); };
+        auto timer_last = [&]() { return host_tune ? host_timer.last() : device_timer.last(); };
 
         host_timer_t tune_timer;
         tune_timer.start(__func__, __FILE__, __LINE__);
 
         param.aux = make_int4(-1, -1, -1, -1);
         tunable.initTuneParam(param);
+        if (host_tune) tunable.initHostParam(param);
 
         const int candidate_iterations = tunable.candidate_iter();
         while (tuning && candidatetuning) {
@@ -915,11 +1576,11 @@ namespace quda
 
           tunable.apply(stream); // do initial call in case we need to jit compile for these parameters or if policy tuning
 
-          timer.start();
+          timer_start();
           for (int i = 0; i < candidate_iterations; i++) {
             tunable.apply(stream); // calls tuneLaunch() again, which simply returns the currently active param
           }
-          timer.stop();
+          timer_stop();
           qudaDeviceSynchronize();
           auto error = qudaGetLastError();
 
@@ -929,7 +1590,7 @@ namespace quda
               errorQuda("Failed to clear error state %s\n", qudaGetLastErrorString().c_str());
           }
 
-          float elapsed_time = timer.last() / candidate_iterations;
+          float elapsed_time = timer_last() / candidate_iterations;
           param.time = elapsed_time;
           if ((error == QUDA_SUCCESS) && (tunable.launchError() == QUDA_SUCCESS)) tc.pushCandidate(param);
 
@@ -941,7 +1602,7 @@ namespace quda
               printfQuda("    %s gives %s\n", tunable.paramString(param).c_str(), qudaGetLastErrorString().c_str());
             }
           }
-          candidatetuning = tunable.advanceTuneParam(param);
+          candidatetuning = tunable.advanceTuneParam(param) || (host_tune && tunable.advanceHostParam(param));
           tunable.launchError() = QUDA_SUCCESS;
         }
 
@@ -972,11 +1633,11 @@ namespace quda
           }
 
           tunable.apply(stream); // do warm up call, for consistency with the candidate tuning
-          timer.start();
+          timer_start();
           for (int i = 0; i < tuneiterations; i++) {
             tunable.apply(stream); // calls tuneLaunch() again, which simply returns the currently active param
           }
-          timer.stop();
+          timer_stop();
           qudaDeviceSynchronize();
           auto error = qudaGetLastError();
 
@@ -986,7 +1647,7 @@ namespace quda
               errorQuda("Failed to clear error state %s\n", qudaGetLastErrorString().c_str());
           }
 
-          float elapsed_time = timer.last() / tuneiterations;
+          float elapsed_time = timer_last() / tuneiterations;
 
           if ((elapsed_time < best_time) && (error == QUDA_SUCCESS) && (tunable.launchError() == QUDA_SUCCESS)) {
             best_time = elapsed_time;
@@ -1031,12 +1692,15 @@ namespace quda
         tunable.postTune();
         tuning = false;
         param = best_param;
-        tunecache[key] = best_param;
+        insertTuneCache(key, best_param);
+        journal_pending.push_back(key);
+        if (comm_rank_global() == 0) broadcast_pending.push_back(key);
       }
-      if (commGlobalReduction() || policyTuning() || uberTuning()) { broadcastTuneCache(); }
+      if (commGlobalReduction() || policyTuning() || uberTuning()) { broadcastTuneCache(true); }
 
       // check this process is getting the key that is expected
-      if (tunecache.find(key) == tunecache.end()) {
+      auto entry = findTuneCache(key);
+      if (entry == tunecache.end()) {
 
         // if we can't find the key, and debugging, then print out the entire map
         if (verbosity >= QUDA_DEBUG_VERBOSE)
@@ -1044,7 +1708,7 @@ namespace quda
 
         errorQuda("Failed to find key entry (%s:%s:%s)", key.name, key.volume, key.aux);
       }
-      param = tunecache[key]; // read this now for all processes
+      param = entry->second; // read this now for all processes
 
       if (traceEnabled() >= 2) {
         TraceKey trace_entry(key, param.time);
@@ -1064,6 +1728,8 @@ namespace quda
   {
 #ifdef LAUNCH_TIMER
     launchTimer.Print();
+    printfQuda("tuneLaunch: %lu launches served from the last-hit memo, %lu tunecache lookups\n", launch_memo_hits,
+               launch_index_lookups);
 #endif
   }
 } // namespace quda
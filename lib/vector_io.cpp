@@ -1,17 +1,28 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <memory>
+
 #include <color_spinor_field.h>
 #include <qio_field.h>
 #include <vector_io.h>
 #include <blas_quda.h>
+#include <malloc_quda.h>
 
 namespace quda
 {
 
-  VectorIO::VectorIO(const std::string &filename, bool parity_inflate) :
+  VectorIO::VectorIO(const std::string &filename, bool parity_inflate, bool native) :
 #ifdef HAVE_QIO
     filename(filename),
+    native(native),
     parity_inflate(parity_inflate)
 #else
-    filename(filename)
+    filename(filename),
+    native(native)
 #endif
   {
     if (strcmp(filename.c_str(), "") == 0)
@@ -19,7 +30,7 @@ namespace quda
   }
 
 #ifdef HAVE_QIO
-  void VectorIO::load(std::vector<ColorSpinorField *> &vecs)
+  void VectorIO::loadQIO(std::vector<ColorSpinorField *> &vecs)
   {
     const int Nvec = vecs.size();
     auto spinor_parity = vecs[0]->SuggestedParity();
@@ -113,12 +124,10 @@ namespace quda
 
     if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done loading vectors\n");
   }
-#else
-  void VectorIO::load(std::vector<ColorSpinorField *> &) { errorQuda("\nQIO library was not built.\n"); }
 #endif
 
 #ifdef HAVE_QIO
-  void VectorIO::save(const std::vector<ColorSpinorField *> &vecs)
+  void VectorIO::saveQIO(const std::vector<ColorSpinorField *> &vecs)
   {
     const int Nvec = vecs.size();
     std::vector<ColorSpinorField *> tmp;
@@ -209,8 +218,560 @@ namespace quda
       for (int i = 0; i < Nvec; i++) delete tmp[i];
     }
   }
+#endif
+
+  /**
+     Header of the native vector file format.  The file consists of
+     one region per rank, each of which starts with this header,
+     followed by the per-vector checksums and then the vectors
+     themselves.  Single and double precision vectors are stored in
+     the host space-spin-color order of the rank-local field, while
+     half and quarter precision vectors are stored in the native
+     device order, including the per-site norms.
+   */
+  struct vector_file_header_t {
+    char magic[8];          // identifies the file format and version
+    uint32_t byte_order;    // byte_order_marker as seen by the writer
+    uint32_t header_bytes;  // size of this header
+    int32_t n_rank;         // number of ranks that wrote the file
+    int32_t rank;           // rank that wrote this region
+    int32_t comm_dim[4];    // process grid
+    int32_t ndim;           // number of field dimensions
+    int32_t x[QUDA_MAX_DIM]; // rank-local field dimensions (x[0] is checkerboarded for single-parity fields)
+    int32_t site_subset;    // QudaSiteSubset of the stored vectors
+    int32_t parity;         // QudaParity of the stored vectors if single parity
+    int32_t nspin;
+    int32_t ncolor;
+    int32_t precision;      // bytes per real number
+    int32_t field_order;    // QudaFieldOrder of the stored vectors
+    int32_t gamma_basis;    // QudaGammaBasis of the stored vectors
+    int32_t nvec;           // number of vectors
+    uint64_t vector_bytes;  // bytes per vector
+    uint64_t data_offset;   // offset of the first vector from the start of the region
+    uint64_t region_bytes;  // size of each region
+  };
+
+  /**
+     The last character of the magic is the format version, which is
+     bumped whenever the header or the data layout changes.  Version 2
+     added the device encoding of reduced-precision vectors.
+   */
+  static constexpr char vector_file_magic[8] = {'Q', 'U', 'D', 'A', 'V', 'E', 'C', '2'};
+  static constexpr size_t vector_file_version_index = sizeof(vector_file_magic) - 1;
+  static constexpr uint32_t byte_order_marker = 0x01020304;
+
+  /**
+     @brief Check that a header read from a native file can be
+     interpreted by this version of the format
+   */
+  static void check_header(const vector_file_header_t &header, const std::string &filename)
+  {
+    if (memcmp(header.magic, vector_file_magic, sizeof(vector_file_magic)) != 0)
+      errorQuda("%s is version %c of the native vector format, but only version %c is supported", filename.c_str(),
+                header.magic[vector_file_version_index], vector_file_magic[vector_file_version_index]);
+    if (header.byte_order != byte_order_marker) errorQuda("%s was written with a different byte order", filename.c_str());
+    if (header.header_bytes != sizeof(header)) errorQuda("%s has an unexpected header size", filename.c_str());
+  }
+  static constexpr uint64_t region_alignment = 4096;
+
+  static uint64_t round_up(uint64_t bytes, uint64_t granularity)
+  {
+    return ((bytes + granularity - 1) / granularity) * granularity;
+  }
+
+  /**
+     @brief Fletcher-style checksum of a vector, treated as an array of 32-bit words
+   */
+  static uint64_t vector_checksum(const void *data, size_t bytes)
+  {
+    auto word = static_cast<const uint32_t *>(data);
+    uint64_t a = 0, b = 0;
+    for (size_t i = 0; i < bytes / sizeof(uint32_t); i++) {
+      a += word[i];
+      b += a;
+    }
+    return a ^ (b << 32 | b >> 32);
+  }
+
+  /**
+     @brief Write a buffer to a file at a given offset.  This is called
+     from the I/O threads of the pipeline, so rather than raising an
+     error it returns a description of it, which the calling thread
+     reports with check_io.
+     @return Empty on success, else a description of the error
+   */
+  static std::string write_all(int fd, const void *buffer, size_t bytes, off_t offset, const std::string &filename)
+  {
+    auto ptr = static_cast<const char *>(buffer);
+    while (bytes > 0) {
+      ssize_t n = pwrite(fd, ptr, bytes, offset);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        return "Failed to write to " + filename + ": " + strerror(errno);
+      }
+      ptr += n;
+      bytes -= n;
+      offset += n;
+    }
+    return "";
+  }
+
+  /**
+     @brief Read a buffer from a file at a given offset, returning any
+     error as write_all does
+   */
+  static std::string read_all(int fd, void *buffer, size_t bytes, off_t offset, const std::string &filename)
+  {
+    auto ptr = static_cast<char *>(buffer);
+    while (bytes > 0) {
+      ssize_t n = pread(fd, ptr, bytes, offset);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        return "Failed to read from " + filename + ": " + strerror(errno);
+      }
+      if (n == 0) return "Unexpected end of file " + filename;
+      ptr += n;
+      bytes -= n;
+      offset += n;
+    }
+    return "";
+  }
+
+  /**
+     @brief Raise the error returned by write_all, read_all or an I/O
+     task, if any.  This must only be called from the calling thread.
+   */
+  static void check_io(const std::string &error)
+  {
+    if (!error.empty()) errorQuda("%s", error.c_str());
+  }
+
+  /**
+     @brief Return the precision a field is stored with in the native
+     format.  Fields are stored at their own precision, unless a lower
+     precision is requested with QUDA_VECTOR_IO_PRECISION (single,
+     half or quarter).
+   */
+  static QudaPrecision file_precision(const ColorSpinorField &v)
+  {
+    static QudaPrecision requested = QUDA_INVALID_PRECISION;
+    static bool init = false;
+    if (!init) {
+      char *prec_env = getenv("QUDA_VECTOR_IO_PRECISION");
+      if (prec_env) {
+        if (strcmp(prec_env, "single") == 0)
+          requested = QUDA_SINGLE_PRECISION;
+        else if (strcmp(prec_env, "half") == 0)
+          requested = QUDA_HALF_PRECISION;
+        else if (strcmp(prec_env, "quarter") == 0)
+          requested = QUDA_QUARTER_PRECISION;
+        else
+          errorQuda("Invalid QUDA_VECTOR_IO_PRECISION %s", prec_env);
+      }
+      init = true;
+    }
+    return (requested != QUDA_INVALID_PRECISION && requested < v.Precision()) ? requested : v.Precision();
+  }
+
+  /**
+     @brief Return whether a field can be read or written directly as
+     a host field in the file layout, without going through a host
+     staging field
+   */
+  static bool is_file_layout(const ColorSpinorField &v, QudaPrecision precision, QudaGammaBasis basis)
+  {
+    return v.Location() == QUDA_CPU_FIELD_LOCATION && v.FieldOrder() == QUDA_SPACE_SPIN_COLOR_FIELD_ORDER
+      && v.Precision() == precision && v.GammaBasis() == basis;
+  }
+
+  /**
+     @brief Return whether a field can be transferred directly as a
+     device field in the file layout, without going through a device
+     staging field
+   */
+  static bool is_device_layout(const ColorSpinorField &v, QudaPrecision precision, QudaFieldOrder order,
+                               QudaGammaBasis basis)
+  {
+    return v.Location() == QUDA_CUDA_FIELD_LOCATION && v.FieldOrder() == order && v.Precision() == precision
+      && v.GammaBasis() == basis;
+  }
+
+  /**
+     @brief Create a host staging field for a given field in the file layout
+   */
+  static std::unique_ptr<ColorSpinorField> create_staging(const ColorSpinorField &v, QudaPrecision precision,
+                                                          QudaGammaBasis basis)
+  {
+    ColorSpinorParam csParam(v);
+    csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    csParam.setPrecision(precision);
+    csParam.gammaBasis = basis;
+    csParam.location = QUDA_CPU_FIELD_LOCATION;
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    return std::unique_ptr<ColorSpinorField>(ColorSpinorField::Create(csParam));
+  }
+
+  /**
+     @brief Create a device staging field for a given field, in the
+     native order of the given precision unless an order is given
+   */
+  static std::unique_ptr<ColorSpinorField> create_device_staging(const ColorSpinorField &v, QudaPrecision precision,
+                                                                 QudaGammaBasis basis,
+                                                                 QudaFieldOrder order = QUDA_INVALID_FIELD_ORDER)
+  {
+    ColorSpinorParam csParam(v);
+    csParam.location = QUDA_CUDA_FIELD_LOCATION;
+    csParam.setPrecision(precision, QUDA_INVALID_PRECISION, true);
+    if (order != QUDA_INVALID_FIELD_ORDER) csParam.fieldOrder = order;
+    csParam.gammaBasis = basis;
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    return std::unique_ptr<ColorSpinorField>(ColorSpinorField::Create(csParam));
+  }
+
+  /**
+     @brief Return the depth of the pipeline used by the native format,
+     which is the number of vectors that may be in flight between the
+     disk and the fields at once.  Each vector in flight that needs
+     reordering or a host-device transfer occupies a host staging
+     field, so this bounds the host memory used independent of the
+     number of vectors (vectors stored below single precision use a
+     pinned buffer instead).  Set with QUDA_VECTOR_IO_DEPTH (default 2), a
+     depth of one disables the overlap of disk and PCIe transfers.
+
+     The pipeline has two stages: the disk transfer, which runs on an
+     I/O thread, and the host-device transfer and reordering, which
+     run on the calling thread.  The latter two are not separate
+     stages since the field copy fuses the reordering with the
+     transfer; where they are separate (vectors stored below single
+     precision) the next read is issued as soon as the transfer
+     completes, overlapping it with the reordering.  I/O errors are
+     returned by the I/O threads and raised on the calling thread.
+   */
+  static int pipeline_depth()
+  {
+    static int depth = 0;
+    if (depth == 0) {
+      char *depth_env = getenv("QUDA_VECTOR_IO_DEPTH");
+      depth = depth_env ? atoi(depth_env) : 2;
+      if (depth < 1) {
+        warningQuda("Invalid vector I/O pipeline depth %s, using 1", depth_env);
+        depth = 1;
+      }
+    }
+    return depth;
+  }
+
+  bool VectorIO::isNativeFile() const
+  {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    // any version of the format is recognized here, so that a version mismatch is reported rather than read as QIO
+    char magic[sizeof(vector_file_magic)] = {};
+    bool native = pread(fd, magic, sizeof(magic), 0) == sizeof(magic)
+      && memcmp(magic, vector_file_magic, vector_file_version_index) == 0;
+    close(fd);
+    return native;
+  }
+
+  bool VectorIO::useNativeSave() const
+  {
+#ifdef HAVE_QIO
+    if (native) return true;
+    char *native_env = getenv("QUDA_VECTOR_IO_NATIVE");
+    return native_env && strcmp(native_env, "1") == 0;
 #else
-  void VectorIO::save(const std::vector<ColorSpinorField *> &) { errorQuda("\nQIO library was not built.\n"); }
+    return true;
 #endif
+  }
+
+  int VectorIO::numVectors() const
+  {
+    if (!isNativeFile()) errorQuda("%s is not a native QUDA vector file", filename.c_str());
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) errorQuda("Failed to open %s: %s", filename.c_str(), strerror(errno));
+    vector_file_header_t header;
+    check_io(read_all(fd, &header, sizeof(header), 0, filename));
+    close(fd);
+
+    check_header(header, filename);
+    return header.nvec;
+  }
+
+  void VectorIO::load(std::vector<ColorSpinorField *> &vecs)
+  {
+    if (isNativeFile()) {
+      loadNative(vecs);
+    } else {
+#ifdef HAVE_QIO
+      loadQIO(vecs);
+#else
+      errorQuda("%s is not a native QUDA vector file, and QIO library was not built", filename.c_str());
+#endif
+    }
+  }
+
+  void VectorIO::save(const std::vector<ColorSpinorField *> &vecs)
+  {
+    if (useNativeSave()) {
+      saveNative(vecs);
+    } else {
+#ifdef HAVE_QIO
+      saveQIO(vecs);
+#endif
+    }
+  }
+
+  void VectorIO::saveNative(const std::vector<ColorSpinorField *> &vecs)
+  {
+    const int Nvec = vecs.size();
+    const ColorSpinorField &v0 = *vecs[0];
+    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Start saving %d vectors to %s\n", Nvec, filename.c_str());
+
+    // vectors below single precision are stored in the device encoding, which includes the per-site norms
+    const auto precision = file_precision(v0);
+    const bool device_encoding = precision < QUDA_SINGLE_PRECISION;
+    const auto basis = v0.GammaBasis();
+
+    // device field in the file encoding, used for vectors that need converting
+    std::unique_ptr<ColorSpinorField> encoder;
+    if (device_encoding && !is_device_layout(v0, precision, v0.FieldOrder(), basis))
+      encoder = create_device_staging(v0, precision, basis);
+    const ColorSpinorField &layout = encoder ? *encoder : v0;
+
+    vector_file_header_t header = {};
+    memcpy(header.magic, vector_file_magic, sizeof(header.magic));
+    header.byte_order = byte_order_marker;
+    header.header_bytes = sizeof(header);
+    header.n_rank = comm_size();
+    header.rank = comm_rank();
+    for (int d = 0; d < 4; d++) header.comm_dim[d] = comm_dim(d);
+    header.ndim = v0.Ndim();
+    for (int d = 0; d < v0.Ndim(); d++) header.x[d] = v0.X(d);
+    header.site_subset = v0.SiteSubset();
+    header.parity = v0.SiteSubset() == QUDA_PARITY_SITE_SUBSET ? v0.SuggestedParity() : QUDA_INVALID_PARITY;
+    header.nspin = v0.Nspin();
+    header.ncolor = v0.Ncolor();
+    header.precision = precision;
+    header.field_order = device_encoding ? layout.FieldOrder() : QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    header.gamma_basis = basis;
+    header.nvec = Nvec;
+    header.vector_bytes
+      = device_encoding ? layout.Bytes() : v0.Volume() * v0.Nspin() * v0.Ncolor() * 2 * static_cast<size_t>(precision);
+    header.data_offset = round_up(sizeof(header) + Nvec * sizeof(uint64_t), region_alignment);
+    header.region_bytes = round_up(header.data_offset + Nvec * header.vector_bytes, region_alignment);
+
+    if (v0.SiteSubset() == QUDA_PARITY_SITE_SUBSET && header.parity != QUDA_EVEN_PARITY
+        && header.parity != QUDA_ODD_PARITY)
+      errorQuda("When saving single parity vectors, the suggested parity must be set.");
+
+    // rank 0 creates the file at its full size, after which every rank writes its own region
+    if (comm_rank() == 0) {
+      int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0) errorQuda("Failed to create %s: %s", filename.c_str(), strerror(errno));
+      if (ftruncate(fd, header.region_bytes * comm_size()) != 0)
+        errorQuda("Failed to resize %s: %s", filename.c_str(), strerror(errno));
+      close(fd);
+    }
+    comm_barrier();
+
+    int fd = open(filename.c_str(), O_WRONLY);
+    if (fd < 0) errorQuda("Failed to open %s: %s", filename.c_str(), strerror(errno));
+    const off_t region = static_cast<off_t>(header.region_bytes) * comm_rank();
+
+    // device fields at (at least) the original precision, used to measure the error of the reduced-precision encoding
+    std::unique_ptr<ColorSpinorField> original, decoded;
+    std::vector<double> error(Nvec, 0.0);
+    auto encoding_error = [&](const ColorSpinorField &v) {
+      if (!original) {
+        const auto check_precision = std::max(v0.Precision(), QUDA_SINGLE_PRECISION);
+        original = create_device_staging(v0, check_precision, basis);
+        decoded = create_device_staging(v0, check_precision, basis);
+      }
+      *original = v;
+      *decoded = *encoder;
+      const double norm = blas::norm2(*original);
+      return norm > 0.0 ? sqrt(blas::xmyNorm(*original, *decoded) / norm) : 0.0;
+    };
+
+    // vector i is downloaded into staging slot i % depth while the previous vectors are written out
+    const int depth = std::min(pipeline_depth(), Nvec);
+    std::vector<std::unique_ptr<ColorSpinorField>> staging(depth);
+    std::vector<void *> buffer(depth, nullptr);
+    std::vector<std::future<std::string>> pending(depth);
+    std::vector<uint64_t> checksum(Nvec);
+
+    for (int i = 0; i < Nvec; i++) {
+      const int slot = i % depth;
+      if (pending[slot].valid()) check_io(pending[slot].get()); // the slot is free once its previous write has completed
+
+      const void *data;
+      if (device_encoding) {
+        const ColorSpinorField *v = vecs[i];
+        if (encoder) {
+          *encoder = *v;
+          error[i] = encoding_error(*v);
+          if (getVerbosity() >= QUDA_VERBOSE)
+            printfQuda("Vector %d stored with relative error %e\n", i, error[i]);
+          v = encoder.get();
+        }
+        if (!buffer[slot]) buffer[slot] = pool_pinned_malloc(header.vector_bytes);
+        qudaMemcpy(buffer[slot], v->V(), header.vector_bytes, qudaMemcpyDeviceToHost);
+        data = buffer[slot];
+      } else {
+        const ColorSpinorField *v = vecs[i];
+        if (!is_file_layout(*v, precision, basis)) {
+          if (!staging[slot]) staging[slot] = create_staging(v0, precision, basis);
+          *staging[slot] = *v;
+          v = staging[slot].get();
+        }
+        data = v->V();
+      }
+
+      const off_t offset = region + header.data_offset + i * header.vector_bytes;
+      pending[slot] = std::async(std::launch::async, [&, data, i, offset]() {
+        checksum[i] = vector_checksum(data, header.vector_bytes);
+        return write_all(fd, data, header.vector_bytes, offset, filename);
+      });
+    }
+    for (auto &p : pending)
+      if (p.valid()) check_io(p.get());
+    for (auto b : buffer)
+      if (b) pool_pinned_free(b);
+
+    check_io(write_all(fd, &header, sizeof(header), region, filename));
+    check_io(write_all(fd, checksum.data(), Nvec * sizeof(uint64_t), region + sizeof(header), filename));
+    if (close(fd) != 0) errorQuda("Failed to close %s: %s", filename.c_str(), strerror(errno));
+    comm_barrier();
+
+    if (encoder && getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Vectors stored at %d bytes per real, with maximum relative error %e\n", precision,
+                 *std::max_element(error.begin(), error.end()));
+    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done saving vectors\n");
+  }
+
+  void VectorIO::loadNative(std::vector<ColorSpinorField *> &vecs)
+  {
+    const int Nvec = vecs.size();
+    const ColorSpinorField &v0 = *vecs[0];
+    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Start loading %04d vectors from %s\n", Nvec, filename.c_str());
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) errorQuda("Failed to open %s: %s", filename.c_str(), strerror(errno));
+
+    // the region size is read from the first header, since all regions are the same size
+    vector_file_header_t header;
+    check_io(read_all(fd, &header, sizeof(header), 0, filename));
+    check_header(header, filename);
+    if (header.n_rank != static_cast<int>(comm_size()))
+      errorQuda("%s was written by %d ranks, but %lu ranks are present", filename.c_str(), header.n_rank, comm_size());
+
+    const off_t region = static_cast<off_t>(header.region_bytes) * comm_rank();
+    check_io(read_all(fd, &header, sizeof(header), region, filename));
+    check_header(header, filename);
+    if (header.rank != comm_rank()) errorQuda("Region %d of %s has rank %d", comm_rank(), filename.c_str(), header.rank);
+    for (int d = 0; d < 4; d++)
+      if (header.comm_dim[d] != comm_dim(d))
+        errorQuda("Process grid mismatch in dimension %d: file = %d, current = %d", d, header.comm_dim[d], comm_dim(d));
+    if (header.nvec < Nvec) errorQuda("%s contains %d vectors, but %d were requested", filename.c_str(), header.nvec, Nvec);
+    if (header.nspin != v0.Nspin() || header.ncolor != v0.Ncolor())
+      errorQuda("Vector mismatch: file has nSpin = %d, nColor = %d, field has nSpin = %d, nColor = %d", header.nspin,
+                header.ncolor, v0.Nspin(), v0.Ncolor());
+
+    // a single parity may be loaded from a file of full vectors, reading just that parity's half of each vector
+    const bool extract_parity = header.site_subset == QUDA_FULL_SITE_SUBSET && v0.SiteSubset() == QUDA_PARITY_SITE_SUBSET;
+    if (header.site_subset == QUDA_PARITY_SITE_SUBSET && v0.SiteSubset() == QUDA_FULL_SITE_SUBSET)
+      errorQuda("Cannot load full-parity vectors from single-parity vectors in %s", filename.c_str());
+    const QudaParity parity = v0.SuggestedParity();
+    if (v0.SiteSubset() == QUDA_PARITY_SITE_SUBSET) {
+      if (parity != QUDA_EVEN_PARITY && parity != QUDA_ODD_PARITY)
+        errorQuda("When loading single parity vectors, the suggested parity must be set.");
+      if (!extract_parity && header.parity != parity)
+        errorQuda("Parity mismatch: file = %d, field = %d", header.parity, parity);
+    }
+
+    if (header.ndim != v0.Ndim()) errorQuda("Dimension mismatch: file = %d, field = %d", header.ndim, v0.Ndim());
+    for (int d = 0; d < v0.Ndim(); d++) {
+      const int x = (d == 0 && extract_parity) ? header.x[d] / 2 : header.x[d];
+      if (x != v0.X(d)) errorQuda("Local dimension mismatch in dimension %d: file = %d, field = %d", d, x, v0.X(d));
+    }
+
+    // both encodings store each parity in its own half of a vector, including the norms of the device encoding
+    const auto precision = static_cast<QudaPrecision>(header.precision);
+    const auto order = static_cast<QudaFieldOrder>(header.field_order);
+    const auto basis = static_cast<QudaGammaBasis>(header.gamma_basis);
+    const bool device_encoding = order != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+    const size_t bytes = extract_parity ? header.vector_bytes / 2 : header.vector_bytes;
+    const off_t parity_offset = extract_parity && parity == QUDA_ODD_PARITY ? bytes : 0;
+
+    // device field in the file encoding, used for vectors that need converting
+    std::unique_ptr<ColorSpinorField> decoder;
+    if (device_encoding) {
+      if (!is_device_layout(v0, precision, order, basis)) decoder = create_device_staging(v0, precision, basis, order);
+      const ColorSpinorField &layout = decoder ? *decoder : v0;
+      if (layout.Bytes() != bytes)
+        errorQuda("Vector size mismatch: file = %lu, field = %lu", bytes, layout.Bytes());
+    }
+
+    std::vector<uint64_t> checksum(header.nvec);
+    check_io(read_all(fd, checksum.data(), header.nvec * sizeof(uint64_t), region + sizeof(header), filename));
+
+    // vector i is read into staging slot i % depth while the previous vectors are uploaded
+    const int depth = std::min(pipeline_depth(), Nvec);
+    std::vector<std::unique_ptr<ColorSpinorField>> staging(depth);
+    std::vector<void *> buffer(depth, nullptr);
+    std::vector<std::future<std::string>> pending(depth);
+    std::vector<ColorSpinorField *> target(depth);
+
+    auto issue_read = [&](int i) {
+      const int slot = i % depth;
+      void *data;
+      if (device_encoding) {
+        if (!buffer[slot]) buffer[slot] = pool_pinned_malloc(bytes);
+        data = buffer[slot];
+      } else {
+        ColorSpinorField *v = vecs[i];
+        if (!is_file_layout(*v, precision, basis)) {
+          if (!staging[slot]) staging[slot] = create_staging(v0, precision, basis);
+          v = staging[slot].get();
+        }
+        target[slot] = v;
+        data = v->V();
+      }
+
+      const off_t offset = region + header.data_offset + i * header.vector_bytes + parity_offset;
+      pending[slot] = std::async(std::launch::async, [&, data, i, offset]() {
+        auto error = read_all(fd, data, bytes, offset, filename);
+        // the checksum covers the full vector, so it can only be verified when the whole vector is read
+        if (error.empty() && !extract_parity && vector_checksum(data, bytes) != checksum[i])
+          error = "Checksum mismatch for vector " + std::to_string(i) + " in " + filename;
+        return error;
+      });
+    };
+
+    for (int i = 0; i < depth; i++) issue_read(i);
+    for (int i = 0; i < Nvec; i++) {
+      const int slot = i % depth;
+      check_io(pending[slot].get());
+      if (device_encoding) {
+        // upload the encoded vector as is, and only then convert it on the device if needed
+        ColorSpinorField *v = decoder ? decoder.get() : vecs[i];
+        if (v->Bytes() != bytes) errorQuda("Vector size mismatch: file = %lu, field = %lu", bytes, v->Bytes());
+        qudaMemcpy(v->V(), buffer[slot], bytes, qudaMemcpyHostToDevice);
+        // the pinned buffer is free once uploaded, so the next read overlaps the conversion on the device
+        if (i + depth < Nvec) issue_read(i + depth);
+        if (v != vecs[i]) *vecs[i] = *v;
+      } else {
+        if (target[slot] != vecs[i]) *vecs[i] = *target[slot];
+        if (i + depth < Nvec) issue_read(i + depth); // the slot is free once its vector has been uploaded
+      }
+    }
+    for (auto b : buffer)
+      if (b) pool_pinned_free(b);
+
+    close(fd);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done loading vectors\n");
+  }
 
 } // namespace quda
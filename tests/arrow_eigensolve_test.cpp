@@ -0,0 +1,182 @@
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <arrow_eigensolve.h>
+#include <eigen_helper.h>
+
+#include <gtest/gtest.h>
+
+/*
+  Unit tests for the structured arrow matrix eigensolver used by the
+  (block) thick restarted Lanczos methods.  The eigenpairs are checked
+  against the dense matrix, so these tests do not require a device.
+*/
+
+using quda::ArrowEigensolver;
+
+template <typename T> using mat_t = Matrix<T, Dynamic, Dynamic>;
+
+inline double conj_(double x) { return x; }
+inline std::complex<double> conj_(const std::complex<double> &x) { return std::conj(x); }
+
+template <typename T> T random_element(std::mt19937 &rng);
+template <> double random_element<double>(std::mt19937 &rng) { return std::normal_distribution<double>()(rng); }
+template <> std::complex<double> random_element<std::complex<double>>(std::mt19937 &rng)
+{
+  std::normal_distribution<double> normal;
+  return {normal(rng), normal(rng)};
+}
+
+template <typename T> struct arrow_t {
+  int n_arrow;
+  int block;
+  int n_block;
+  std::vector<double> d;
+  std::vector<T> r;
+  std::vector<T> t_diag;
+  std::vector<T> t_sub;
+
+  arrow_t(int n_arrow, int block, int n_block, std::mt19937 &rng) :
+    n_arrow(n_arrow), block(block), n_block(n_block), d(n_arrow), r(block * n_arrow),
+    t_diag(block * block * n_block), t_sub(block * block * (n_block - 1))
+  {
+    for (auto &di : d) di = random_element<double>(rng);
+    for (auto &ri : r) ri = random_element<T>(rng);
+    for (auto &ti : t_sub) ti = random_element<T>(rng);
+    for (int i = 0; i < n_block; i++) {
+      Map<mat_t<T>> a(t_diag.data() + i * block * block, block, block);
+      for (int c = 0; c < block; c++) {
+        for (int b = 0; b < c; b++) {
+          a(b, c) = random_element<T>(rng);
+          a(c, b) = conj_(a(b, c));
+        }
+        a(c, c) = random_element<double>(rng);
+      }
+    }
+  }
+
+  int size() const { return n_arrow + block * n_block; }
+
+  mat_t<T> dense() const
+  {
+    const int b2 = block * block;
+    mat_t<T> a = mat_t<T>::Zero(size(), size());
+    for (int i = 0; i < n_arrow; i++) a(i, i) = d[i];
+    for (int i = 0; i < n_arrow; i++) {
+      for (int c = 0; c < block; c++) {
+        a(n_arrow + c, i) = r[i * block + c];
+        a(i, n_arrow + c) = conj_(r[i * block + c]);
+      }
+    }
+    for (int i = 0; i < n_block; i++) {
+      a.block(n_arrow + i * block, n_arrow + i * block, block, block) = Map<const mat_t<T>>(t_diag.data() + i * b2, block, block);
+      if (i < n_block - 1) {
+        mat_t<T> s = Map<const mat_t<T>>(t_sub.data() + i * b2, block, block);
+        a.block(n_arrow + (i + 1) * block, n_arrow + i * block, block, block) = s;
+        a.block(n_arrow + i * block, n_arrow + (i + 1) * block, block, block) = s.adjoint();
+      }
+    }
+    return a;
+  }
+};
+
+template <typename T> void check(const arrow_t<T> &arrow)
+{
+  const int n = arrow.size();
+  const mat_t<T> a = arrow.dense();
+  const double norm = a.norm();
+  const double tol = 1e-12 * n * norm;
+
+  ArrowEigensolver<T> eig;
+  eig.compute(arrow.n_arrow, arrow.block, arrow.d, arrow.r, arrow.t_diag, arrow.t_sub);
+
+  SelfAdjointEigenSolver<mat_t<T>> dense(a, EigenvaluesOnly);
+  for (int i = 0; i < n; i++) EXPECT_NEAR(eig.eigenvalues()[i], dense.eigenvalues()[i], tol) << "eigenvalue " << i;
+
+  std::vector<T> q_;
+  eig.eigenvectors(q_, n);
+  Map<mat_t<T>> q(q_.data(), n, n);
+
+  mat_t<T> lambda = mat_t<T>::Zero(n, n);
+  for (int i = 0; i < n; i++) lambda(i, i) = eig.eigenvalues()[i];
+  EXPECT_LT((a * q - q * lambda).norm(), tol);
+  EXPECT_LT((q.adjoint() * q - mat_t<T>::Identity(n, n)).norm(), 1e-12 * n);
+
+  double last_row_error = 0.0;
+  for (int l = 0; l < n; l++)
+    for (int i = 0; i < arrow.block; i++)
+      last_row_error = std::max(last_row_error, std::abs(eig.lastRow(i, l) - q(n - arrow.block + i, l)));
+  EXPECT_LT(last_row_error, 1e-12 * n);
+
+  // requesting fewer vectors gives the leading columns
+  const int n_vec = n / 3;
+  std::vector<T> q_keep;
+  eig.eigenvectors(q_keep, n_vec);
+  EXPECT_LT((Map<mat_t<T>>(q_keep.data(), n, n_vec) - q.leftCols(n_vec)).norm(), 1e-12 * n);
+}
+
+TEST(arrow_eigensolve, real)
+{
+  std::mt19937 rng(1234);
+  for (int n_arrow : {0, 1, 17, 150})
+    for (int n_block : {1, 9, 64, 65, 301}) check(arrow_t<double>(n_arrow, 1, n_block, rng));
+}
+
+TEST(arrow_eigensolve, block)
+{
+  std::mt19937 rng(5678);
+  for (int block : {2, 3, 4})
+    for (int n_arrow : {0, 2, 60})
+      for (int n_block : {1, 20, 97}) check(arrow_t<std::complex<double>>(block * n_arrow, block, n_block, rng));
+}
+
+TEST(arrow_eigensolve, deflation)
+{
+  // converged Ritz values have negligible arrow couplings, and
+  // degenerate values are common, so exercise both deflation paths
+  std::mt19937 rng(91011);
+  arrow_t<double> arrow(120, 1, 200, rng);
+  for (int i = 0; i < arrow.n_arrow; i++) {
+    arrow.d[i] = (i % 4) * 0.5;
+    if (i % 3 == 0) arrow.r[i] = 1e-17;
+  }
+  for (int i = 0; i < arrow.n_block; i++) arrow.t_diag[i] = 1.0;
+  for (int i = 0; i < arrow.n_block - 1; i++) arrow.t_sub[i] = (i % 50 == 0) ? 0.0 : 0.5;
+  check(arrow);
+
+  arrow_t<std::complex<double>> block_arrow(2 * 40, 2, 100, rng);
+  for (int i = 0; i < block_arrow.n_arrow; i++) block_arrow.d[i] = (i % 2) * 1.0;
+  for (int i = 0; i < 4 * 99; i += 4 * 10) block_arrow.t_sub[i] = block_arrow.t_sub[i + 1] = 0.0;
+  check(block_arrow);
+}
+
+TEST(arrow_eigensolve, zero_coupling)
+{
+  // with an exactly zero arrow, or a zero coupling at a tear point,
+  // no rank-one update is applied and the children's eigenvalues
+  // must still come back in ascending order
+  std::mt19937 rng(121314);
+  arrow_t<double> arrow(3, 1, 2, rng);
+  arrow.d = {3.0, 1.0, 2.0};
+  arrow.r = {0.0, 0.0, 0.0};
+  arrow.t_diag = {0.5, -1.0};
+  arrow.t_sub = {0.1};
+  check(arrow);
+
+  // tear points of 200 blocks are at 100, 50 and 150
+  arrow_t<double> tear(40, 1, 200, rng);
+  for (auto &ri : tear.r) ri = 0.0;
+  for (int i : {49, 99, 149}) tear.t_sub[i] = 0.0;
+  check(tear);
+
+  arrow_t<std::complex<double>> block_tear(2 * 10, 2, 100, rng);
+  for (int i = 0; i < 4; i++) block_tear.t_sub[4 * 49 + i] = 0.0;
+  check(block_tear);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
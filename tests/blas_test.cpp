@@ -77,6 +77,7 @@ enum class Kernel {
   copyLS,
   axpbyz,
   axpbypczw,
+  axpbypcz,
   ax,
   caxpy,
   caxpby,
@@ -124,6 +125,7 @@ const std::map<Kernel, std::string> kernel_map
      {Kernel::copyLS, "copyLS"},
      {Kernel::axpbyz, "axpbyz"},
      {Kernel::axpbypczw, "axpbypczw"},
+     {Kernel::axpbypcz, "axpbypcz"},
      {Kernel::ax, "ax"},
      {Kernel::caxpy, "caxpy"},
      {Kernel::caxpby, "caxpby"},
@@ -382,6 +384,10 @@ protected:
         for (int i = 0; i < niter; ++i) blas::axpbypczw(a, xD, b, yD, c, zD, wD);
         break;
 
+      case Kernel::axpbypcz:
+        for (int i = 0; i < niter; ++i) blas::axpbypcz(a, xD, b, yD, c, zD);
+        break;
+
       case Kernel::ax:
         for (int i = 0; i < niter; ++i) blas::ax(a, xD);
         break;
@@ -621,6 +627,15 @@ protected:
       error = ERROR(w);
       break;
 
+    case Kernel::axpbypcz:
+      xD = xH;
+      yD = yH;
+      zD = zH;
+      blas::axpbypcz(a, xD, b, yD, c, zD);
+      blas::axpbypcz(a, xH, b, yH, c, zH);
+      error = ERROR(z);
+      break;
+
     case Kernel::ax:
       xD = xH;
       blas::ax(a, xD);
@@ -903,12 +918,18 @@ protected:
       for (int i = 0; i < Msrc; i++) ymoD[i] = ymH[i];
 
       blas::caxpy(A, xmD, ymoD);
-      for (int j = 0; j < Msrc; j++) {
-        for (int i = 0; i < Nsrc; i++) { blas::caxpy(A[Msrc * i + j], xmH[i], ymH[j]); }
-      }
-      error = 0;
-      for (int i = 0; i < Msrc; i++) {
-        error += fabs(blas::norm2((ymoD[i])) - blas::norm2(ymH[i])) / blas::norm2(ymH[i]);
+      {
+        // the host multi-blas must agree with the single-vector host updates
+        std::vector<ColorSpinorField> ymH_multi(ymH);
+        blas::caxpy(A, xmH, ymH_multi);
+        for (int j = 0; j < Msrc; j++) {
+          for (int i = 0; i < Nsrc; i++) { blas::caxpy(A[Msrc * i + j], xmH[i], ymH[j]); }
+        }
+        error = 0;
+        for (int i = 0; i < Msrc; i++) {
+          error += fabs(blas::norm2((ymoD[i])) - blas::norm2(ymH[i])) / blas::norm2(ymH[i]);
+          error += fabs(blas::norm2((ymH_multi[i])) - blas::norm2(ymH[i])) / blas::norm2(ymH[i]);
+        }
       }
       error /= Msrc;
       break;
@@ -1010,11 +1031,14 @@ protected:
       for (int i = 0; i < Msrc; i++) ymoD[i] = ymH[i];
       for (int i = 0; i < Msrc; i++) ymD[i] = ymH[i];
       blas::cDotProduct(A, xmD, ymoD);
+      blas::cDotProduct(C, xmH, ymH); // host multi-reduction
       error = 0.0;
       for (int i = 0; i < Nsrc; i++) {
         for (int j = 0; j < Msrc; j++) {
           B[i * Msrc + j] = blas::cDotProduct(xmD[i], ymD[j]);
           error += std::abs(A[i * Msrc + j] - B[i * Msrc + j]) / std::abs(B[i * Msrc + j]);
+          const auto ref = blas::cDotProduct(xmH[i], ymH[j]);
+          error += std::abs(C[i * Msrc + j] - ref) / std::abs(ref);
         }
       }
       error /= Nsrc * Msrc;
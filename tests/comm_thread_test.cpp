@@ -0,0 +1,203 @@
+#include <cstdint>
+#include <vector>
+
+#include <quda.h>
+#include <comm_quda.h>
+#include <communicator_quda.h>
+#include <reproducible_sum.h>
+
+#include <gtest/gtest.h>
+
+/*
+  Tests for the threaded communications backend, where each rank is a
+  thread of this process.  These exercise the halo exchange and
+  collectives on a 2^4 process grid without requiring MPI.  Only the
+  comms layer is exercised, since the backend does not make the rest
+  of QUDA per-rank.
+*/
+
+using namespace quda;
+
+constexpr int grid[4] = {2, 2, 2, 2};
+constexpr int n_rank = 16;
+
+/**
+   @brief Launch n_rank ranks, each of which initializes the
+   communicator, runs the test body and then finalizes the communicator
+ */
+template <typename F> void run_ranks(F &&f)
+{
+  auto body = [](int, void *arg) {
+    initCommsGridQuda(4, grid, nullptr, nullptr);
+    (*static_cast<F *>(arg))();
+    comm_finalize();
+  };
+  comm_thread_launch(n_rank, body, &f);
+}
+
+TEST(comm_thread, topology)
+{
+  std::vector<int> seen(n_rank, 0);
+  run_ranks([&]() {
+    EXPECT_EQ(comm_size(), static_cast<size_t>(n_rank));
+    EXPECT_EQ(comm_rank(), comm_rank_global());
+    seen[comm_rank()]++;
+    for (int d = 0; d < 4; d++) {
+      EXPECT_EQ(comm_dim(d), grid[d]);
+      EXPECT_TRUE(comm_dim_partitioned(d));
+    }
+  });
+  for (auto s : seen) EXPECT_EQ(s, 1);
+}
+
+TEST(comm_thread, halo_exchange)
+{
+  run_ranks([]() {
+    for (int d = 0; d < 4; d++) {
+      for (int dir = -1; dir <= 1; dir += 2) {
+        // send our rank to the neighbor in direction dir, and receive from the opposite neighbor
+        int send = comm_rank();
+        int recv = -1;
+        MsgHandle *mh_send = comm_declare_send_relative(&send, d, dir, sizeof(int));
+        MsgHandle *mh_recv = comm_declare_receive_relative(&recv, d, -dir, sizeof(int));
+
+        for (int iter = 0; iter < 3; iter++) {
+          recv = -1;
+          comm_start(mh_recv);
+          comm_start(mh_send);
+          comm_wait(mh_recv);
+          comm_wait(mh_send);
+          EXPECT_EQ(recv, comm_neighbor_rank(dir > 0 ? 0 : 1, d));
+        }
+
+        comm_free(mh_send);
+        comm_free(mh_recv);
+      }
+    }
+  });
+}
+
+TEST(comm_thread, strided_exchange)
+{
+  run_ranks([]() {
+    // send every other element of a strided array into a contiguous buffer
+    constexpr int n = 8;
+    std::vector<double> send(2 * n);
+    std::vector<double> recv(n, -1.0);
+    for (int i = 0; i < 2 * n; i++) send[i] = i % 2 == 0 ? 100 * comm_rank() + i / 2 : -1.0;
+
+    MsgHandle *mh_send = comm_declare_strided_send_relative(send.data(), 3, +1, sizeof(double), n, 2 * sizeof(double));
+    MsgHandle *mh_recv = comm_declare_receive_relative(recv.data(), 3, -1, n * sizeof(double));
+    comm_start(mh_recv);
+    comm_start(mh_send);
+    comm_wait(mh_recv);
+    comm_wait(mh_send);
+    comm_free(mh_send);
+    comm_free(mh_recv);
+
+    const int neighbor = comm_neighbor_rank(0, 3);
+    for (int i = 0; i < n; i++) EXPECT_EQ(recv[i], 100 * neighbor + i);
+  });
+}
+
+TEST(comm_thread, collectives)
+{
+  run_ranks([]() {
+    const int rank = comm_rank();
+
+    double sum = rank;
+    comm_allreduce_sum(sum);
+    EXPECT_EQ(sum, n_rank * (n_rank - 1) / 2);
+
+    double max = rank;
+    comm_allreduce_max(max);
+    EXPECT_EQ(max, n_rank - 1);
+
+    std::vector<double> min = {1.0 * rank, -1.0 * rank};
+    comm_allreduce_min(min);
+    EXPECT_EQ(min[0], 0);
+    EXPECT_EQ(min[1], 1 - n_rank);
+
+    int count = 1;
+    comm_allreduce_int(count);
+    EXPECT_EQ(count, n_rank);
+
+    uint64_t bits = uint64_t(1) << rank;
+    comm_allreduce_xor(bits);
+    EXPECT_EQ(bits, (uint64_t(1) << n_rank) - 1);
+
+    int value = rank == 0 ? 42 : rank;
+    comm_broadcast(&value, sizeof(value));
+    EXPECT_EQ(value, 42);
+
+    comm_barrier();
+  });
+}
+
+TEST(comm_thread, deterministic_sum)
+{
+  // contributions whose naive sum depends on the order in which they are combined
+  auto contribution = [](int rank) { return (rank % 2 == 0 ? 1.0 : -1.0) * (1e16 + rank) + 1.0 / (rank + 1); };
+
+  reproducible::accumulator_t reference;
+  for (int r = n_rank - 1; r >= 0; r--) reference.merge(contribution(r));
+
+  setenv("QUDA_DETERMINISTIC_REDUCE", "1", 1);
+  std::vector<double> result(n_rank);
+  run_ranks([&]() {
+    double sum = contribution(comm_rank());
+    comm_allreduce_sum(sum);
+    result[comm_rank()] = sum;
+  });
+  unsetenv("QUDA_DETERMINISTIC_REDUCE");
+
+  for (auto r : result) EXPECT_EQ(r, reference.value());
+}
+
+TEST(comm_thread, split_grid)
+{
+  run_ranks([]() {
+    // the sub-grids are labelled by the z and t coordinates of their ranks in the full grid
+    double color = comm_coord(2) + grid[2] * comm_coord(3);
+
+    push_communicator({1, 1, 2, 2});
+    EXPECT_EQ(comm_size(), static_cast<size_t>(n_rank / 4));
+    EXPECT_EQ(comm_size_global(), static_cast<size_t>(n_rank));
+    const int split_grid[4] = {2, 2, 1, 1};
+    for (int d = 0; d < 4; d++) EXPECT_EQ(comm_dim(d), split_grid[d]);
+
+    // collectives are confined to the sub-grid
+    std::vector<double> min = {color};
+    double max = color;
+    comm_allreduce_min(min);
+    comm_allreduce_max(max);
+    EXPECT_EQ(min[0], color);
+    EXPECT_EQ(max, color);
+
+    // as are neighbors
+    for (int d = 0; d < 2; d++) {
+      double recv = -1.0;
+      MsgHandle *mh_send = comm_declare_send_relative(&color, d, +1, sizeof(double));
+      MsgHandle *mh_recv = comm_declare_receive_relative(&recv, d, -1, sizeof(double));
+      comm_start(mh_recv);
+      comm_start(mh_send);
+      comm_wait(mh_recv);
+      comm_wait(mh_send);
+      comm_free(mh_send);
+      comm_free(mh_recv);
+      EXPECT_EQ(recv, color);
+    }
+
+    push_communicator(default_comm_key);
+    EXPECT_EQ(comm_size(), static_cast<size_t>(n_rank));
+    double sum = 1.0;
+    comm_allreduce_sum(sum);
+    EXPECT_EQ(sum, n_rank);
+  });
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
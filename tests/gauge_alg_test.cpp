@@ -108,6 +108,30 @@ protected:
     return ((a0 < prec_val) && (a1 < prec_val) && (a2 < prec_val));
   }
 
+  bool compareHost(double host, double device)
+  {
+    double prec_val = U->Precision() == QUDA_DOUBLE_PRECISION ? 1e-10 : 1e-4;
+    return std::abs(host - device) < prec_val * std::max(1.0, std::abs(device));
+  }
+
+  /**
+     @brief L2 norm of the difference of two host gauge fields that
+     share the same native layout, where each parity holds
+     geometry * volumeCB links contiguously
+  */
+  template <typename Float> double hostDifference(const cpuGaugeField &a, const cpuGaugeField &b)
+  {
+    size_t length = static_cast<size_t>(a.Geometry()) * a.VolumeCB() * a.Reconstruct();
+    double diff2 = 0.0;
+    for (int parity = 0; parity < 2; parity++) {
+      auto a_p = reinterpret_cast<const Float *>(static_cast<const char *>(a.Gauge_p()) + parity * (a.Bytes() / 2));
+      auto b_p = reinterpret_cast<const Float *>(static_cast<const char *>(b.Gauge_p()) + parity * (b.Bytes() / 2));
+      for (size_t i = 0; i < length; i++) diff2 += (a_p[i] - b_p[i]) * (a_p[i] - b_p[i]);
+    }
+    comm_allreduce_sum(diff2);
+    return sqrt(diff2);
+  }
+
   bool CheckDeterminant(double2 detu)
   {
     double prec_val = 5e-8;
@@ -287,14 +311,13 @@ protected:
     }
   }
 
-  virtual void save_gauge()
+  /**
+     @brief Copy the interior of the extended field U into host arrays
+     @param[out] cpu_gauge Host arrays of the four link directions, allocated here
+     @param[in] gauge_param Parameters of the host gauge field
+  */
+  void copy_gauge_to_host(void *cpu_gauge[4], QudaGaugeParam &gauge_param)
   {
-    printfQuda("Saving the gauge field to file %s\n", gauge_outfile.c_str());
-
-    QudaGaugeParam gauge_param = newQudaGaugeParam();
-    setWilsonGaugeParam(gauge_param);
-
-    void *cpu_gauge[4];
     for (int dir = 0; dir < 4; dir++) { cpu_gauge[dir] = safe_malloc(V * gauge_site_size * gauge_param.cpu_prec); }
 
     GaugeFieldParam gParam(param);
@@ -310,12 +333,23 @@ protected:
     // copy into regular field
     copyExtendedGauge(*gauge, *U, QUDA_CUDA_FIELD_LOCATION);
     saveGaugeFieldQuda((void *)cpu_gauge, (void *)gauge, &gauge_param);
+    delete gauge;
+  }
+
+  virtual void save_gauge()
+  {
+    printfQuda("Saving the gauge field to file %s\n", gauge_outfile.c_str());
+
+    QudaGaugeParam gauge_param = newQudaGaugeParam();
+    setWilsonGaugeParam(gauge_param);
+
+    void *cpu_gauge[4];
+    copy_gauge_to_host(cpu_gauge, gauge_param);
 
     // Write to disk
     write_gauge_field(gauge_outfile.c_str(), cpu_gauge, gauge_param.cpu_prec, gauge_param.X, 0, (char **)0);
 
     for (int dir = 0; dir < 4; dir++) host_free(cpu_gauge[dir]);
-    delete gauge;
   }
 };
 
@@ -387,6 +421,174 @@ TEST_F(GaugeAlgTest, Coulomb_FFT)
   }
 }
 
+TEST_F(GaugeAlgTest, Adaptive_Wilson_Flow)
+{
+  if (execute) {
+    QudaGaugeParam gauge_param = newQudaGaugeParam();
+    setWilsonGaugeParam(gauge_param);
+    gauge_param.t_boundary = QUDA_PERIODIC_T;
+    void *cpu_gauge[4];
+    copy_gauge_to_host(cpu_gauge, gauge_param);
+    loadGaugeQuda(cpu_gauge, &gauge_param);
+
+    // an odd number of steps, so the fixed step flow ends in the auxiliary field
+    const unsigned int n_steps = 99;
+    unsigned int adaptive_n_steps = 0;
+    auto flow = [&](double tol, unsigned int meas_interval) {
+      std::vector<QudaGaugeObservableParam> obs(n_steps / meas_interval + 1);
+      for (auto &o : obs) {
+        o = newQudaGaugeObservableParam();
+        o.compute_plaquette = QUDA_BOOLEAN_TRUE;
+        o.compute_qcharge = QUDA_BOOLEAN_TRUE;
+      }
+      QudaGaugeSmearParam smear_param = newQudaGaugeSmearParam();
+      smear_param.smear_type = QUDA_GAUGE_SMEAR_WILSON_FLOW;
+      smear_param.n_steps = n_steps;
+      smear_param.epsilon = 0.01;
+      smear_param.meas_interval = meas_interval;
+      smear_param.adaptive_tol = tol;
+      performWFlowQuda(&smear_param, obs.data());
+      adaptive_n_steps = smear_param.adaptive_n_steps;
+      return obs;
+    };
+    auto plaquette_smeared = []() {
+      QudaGaugeObservableParam obs = newQudaGaugeObservableParam();
+      obs.compute_plaquette = QUDA_BOOLEAN_TRUE;
+      gaugeObservablesQuda(&obs);
+      return obs.plaquette[0];
+    };
+
+    // the fixed step flow leaves the flowed field in the smeared field
+    auto fixed = flow(0.0, 1);
+    EXPECT_NEAR(plaquette_smeared(), fixed[n_steps].plaquette[0], 1e-12);
+
+    // measurements of the adaptive flow agree with the fixed step integration, with fewer steps
+    const double tol = 1e-5;
+    const unsigned int meas_interval = 33;
+    auto adaptive = flow(tol, meas_interval);
+    for (auto k = 1u; k <= n_steps / meas_interval; k++) {
+      EXPECT_NEAR(adaptive[k].energy[0], fixed[k * meas_interval].energy[0],
+                  1e-3 * std::abs(fixed[k * meas_interval].energy[0]))
+        << "step " << k * meas_interval;
+      EXPECT_NEAR(adaptive[k].plaquette[0], fixed[k * meas_interval].plaquette[0], 1e-5) << "step " << k * meas_interval;
+    }
+    EXPECT_LT(adaptive_n_steps, n_steps);
+    EXPECT_NEAR(plaquette_smeared(), fixed[n_steps].plaquette[0], 1e-5);
+
+    // without any measurement the flow still runs to t = n_steps * epsilon
+    flow(tol, n_steps + 1);
+    EXPECT_LT(adaptive_n_steps, n_steps);
+    EXPECT_NEAR(plaquette_smeared(), fixed[n_steps].plaquette[0], 1e-5);
+
+    freeGaugeQuda();
+    for (int dir = 0; dir < 4; dir++) host_free(cpu_gauge[dir]);
+  }
+}
+
+TEST_F(GaugeAlgTest, Host_Smearing_Observables)
+{
+  if (execute) {
+    if (U->Precision() < QUDA_SINGLE_PRECISION) GTEST_SKIP();
+
+    // device reference field without reconstruction and its native-ordered host mirror
+    GaugeFieldParam param_d(*U);
+    param_d.create = QUDA_NULL_FIELD_CREATE;
+    param_d.ghostExchange = QUDA_GHOST_EXCHANGE_EXTENDED;
+    param_d.reconstruct = QUDA_RECONSTRUCT_NO;
+    param_d.setPrecision(param_d.Precision(), true);
+    cudaGaugeField src_d(param_d), in_d(param_d), out_d(param_d), tmp_d(param_d);
+    src_d.copy(*U);
+    src_d.exchangeExtendedGhost(src_d.R());
+
+    GaugeFieldParam param_h(param_d);
+    param_h.location = QUDA_CPU_FIELD_LOCATION;
+    param_h.pad = 0;
+    cpuGaugeField in_h(param_h), out_h(param_h), tmp_h(param_h), ref_h(param_h);
+
+    // the smearing routines act in place on their first argument and the flow overwrites its input with the
+    // intermediate stages, so every routine starts from fresh copies of both
+    auto reset = [&]() {
+      in_d.copy(src_d);
+      in_h.copy(src_d);
+      out_d.copy(src_d);
+      out_h.copy(src_d);
+    };
+
+    lat_dim_t x;
+    for (int d = 0; d < 4; d++) x[d] = in_d.X()[d] - 2 * in_d.R()[d];
+    GaugeFieldParam tensor_param(x, in_d.Precision(), QUDA_RECONSTRUCT_NO, 0, QUDA_TENSOR_GEOMETRY);
+    tensor_param.siteSubset = QUDA_FULL_SITE_SUBSET;
+    tensor_param.order = QUDA_FLOAT2_GAUGE_ORDER;
+    tensor_param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+    tensor_param.location = QUDA_CUDA_FIELD_LOCATION;
+    cudaGaugeField fmunu_d(tensor_param);
+    tensor_param.location = QUDA_CPU_FIELD_LOCATION;
+    cpuGaugeField fmunu_h(tensor_param);
+
+    Timer<false> t_d, t_h;
+    auto run = [&](const char *name, auto &&device_op, auto &&host_op) {
+      t_d.start();
+      device_op();
+      qudaDeviceSynchronize();
+      t_d.stop();
+      t_h.start();
+      host_op();
+      t_h.stop();
+      printfQuda("%-12s device %.6e s, host %.6e s\n", name, t_d.last(), t_h.last());
+    };
+
+    auto check_smeared = [&](const char *name) {
+      auto plaq_d = plaquette(out_d);
+      auto plaq_h = plaquette(out_h);
+      printfQuda("%-12s plaq device %.16e host %.16e\n", name, plaq_d.x, plaq_h.x);
+      EXPECT_TRUE(compareHost(plaq_h.x, plaq_d.x) && compareHost(plaq_h.y, plaq_d.y) && compareHost(plaq_h.z, plaq_d.z));
+
+      // element-wise comparison against the device result brought back to the host
+      ref_h.copy(out_d);
+      double diff = out_h.Precision() == QUDA_DOUBLE_PRECISION ? hostDifference<double>(out_h, ref_h) :
+                                                                 hostDifference<float>(out_h, ref_h);
+      double rel = diff / sqrt(out_d.norm2());
+      printfQuda("%-12s |host - device| / |device| = %e\n", name, rel);
+      EXPECT_TRUE(compareHost(rel, 0.0));
+    };
+
+    double3 plaq_d, plaq_h;
+    reset();
+    run("Plaquette", [&]() { plaq_d = plaquette(in_d); }, [&]() { plaq_h = plaquette(in_h); });
+    EXPECT_TRUE(compareHost(plaq_h.x, plaq_d.x) && compareHost(plaq_h.y, plaq_d.y) && compareHost(plaq_h.z, plaq_d.z));
+
+    reset();
+    run("APE", [&]() { APEStep(out_d, in_d, 0.6); }, [&]() { APEStep(out_h, in_h, 0.6); });
+    check_smeared("APE");
+
+    reset();
+    run("STOUT", [&]() { STOUTStep(out_d, in_d, 0.1); }, [&]() { STOUTStep(out_h, in_h, 0.1); });
+    check_smeared("STOUT");
+
+    reset();
+    run("OvrImpSTOUT", [&]() { OvrImpSTOUTStep(out_d, in_d, 0.06, -0.25); },
+        [&]() { OvrImpSTOUTStep(out_h, in_h, 0.06, -0.25); });
+    check_smeared("OvrImpSTOUT");
+
+    for (auto type : {QUDA_GAUGE_SMEAR_WILSON_FLOW, QUDA_GAUGE_SMEAR_SYMANZIK_FLOW}) {
+      const char *name = type == QUDA_GAUGE_SMEAR_WILSON_FLOW ? "WFlow" : "SymanzikFlow";
+      reset();
+      run(name, [&]() { WFlowStep(out_d, tmp_d, in_d, 0.01, type); },
+          [&]() { WFlowStep(out_h, tmp_h, in_h, 0.01, type); });
+      check_smeared(name);
+    }
+
+    double energy_d[3], energy_h[3], qcharge_d, qcharge_h;
+    reset();
+    run("Fmunu", [&]() { computeFmunu(fmunu_d, in_d); }, [&]() { computeFmunu(fmunu_h, in_h); });
+    run("QCharge", [&]() { computeQCharge(energy_d, qcharge_d, fmunu_d); },
+        [&]() { computeQCharge(energy_h, qcharge_h, fmunu_h); });
+    printfQuda("QCharge      device %.16e host %.16e\n", qcharge_d, qcharge_h);
+    for (int i = 0; i < 3; i++) EXPECT_TRUE(compareHost(energy_h[i], energy_d[i]));
+    EXPECT_TRUE(compareHost(qcharge_h, qcharge_d));
+  }
+}
+
 void add_gaugefix_option_group(std::shared_ptr<QUDAApp> quda_app)
 {
   // Option group for gauge fixing related options
@@ -6,6 +6,7 @@
 #include <util_quda.h>
 #include <host_utils.h>
 #include <wilson_dslash_reference.h>
+#include <thread_pool.h>
 
 /**
    @brief Apply the clover matrix field
@@ -21,40 +22,42 @@ template <typename sFloat, typename cFloat> void cloverReference(sFloat *out, cF
   int N = nColor * nSpin / 2;
   int chiralBlock = N + 2 * (N - 1) * N / 2;
 
-  for (int i = 0; i < Vh; i++) {
-    std::complex<sFloat> *In = reinterpret_cast<std::complex<sFloat> *>(&in[i * nSpin * nColor * 2]);
-    std::complex<sFloat> *Out = reinterpret_cast<std::complex<sFloat> *>(&out[i * nSpin * nColor * 2]);
-
-    for (int chi = 0; chi < nSpin / 2; chi++) {
-      cFloat *D = &clover[((parity * Vh + i) * 2 + chi) * chiralBlock];
-      std::complex<cFloat> *L = reinterpret_cast<std::complex<cFloat> *>(&D[N]);
-
-      for (int s_col = 0; s_col < nSpin / 2; s_col++) { // 2 spins per chiral block
-        for (int c_col = 0; c_col < nColor; c_col++) {
-          const int col = s_col * nColor + c_col;
-          const int Col = chi * N + col;
-          Out[Col] = 0.0;
-
-          for (int s_row = 0; s_row < nSpin / 2; s_row++) { // 2 spins per chiral block
-            for (int c_row = 0; c_row < nColor; c_row++) {
-              const int row = s_row * nColor + c_row;
-              const int Row = chi * N + row;
-
-              if (row == col) {
-                Out[Col] += D[row] * In[Row];
-              } else if (col < row) {
-                int k = N * (N - 1) / 2 - (N - col) * (N - col - 1) / 2 + row - col - 1;
-                Out[Col] += conj(L[k]) * In[Row];
-              } else if (row < col) {
-                int k = N * (N - 1) / 2 - (N - row) * (N - row - 1) / 2 + col - row - 1;
-                Out[Col] += L[k] * In[Row];
+  quda::host::parallel_for(Vh, {}, [&](int64_t begin, int64_t end) {
+    for (auto i = begin; i < end; i++) {
+      std::complex<sFloat> *In = reinterpret_cast<std::complex<sFloat> *>(&in[i * nSpin * nColor * 2]);
+      std::complex<sFloat> *Out = reinterpret_cast<std::complex<sFloat> *>(&out[i * nSpin * nColor * 2]);
+
+      for (int chi = 0; chi < nSpin / 2; chi++) {
+        cFloat *D = &clover[((parity * Vh + i) * 2 + chi) * chiralBlock];
+        std::complex<cFloat> *L = reinterpret_cast<std::complex<cFloat> *>(&D[N]);
+
+        for (int s_col = 0; s_col < nSpin / 2; s_col++) { // 2 spins per chiral block
+          for (int c_col = 0; c_col < nColor; c_col++) {
+            const int col = s_col * nColor + c_col;
+            const int Col = chi * N + col;
+            Out[Col] = 0.0;
+
+            for (int s_row = 0; s_row < nSpin / 2; s_row++) { // 2 spins per chiral block
+              for (int c_row = 0; c_row < nColor; c_row++) {
+                const int row = s_row * nColor + c_row;
+                const int Row = chi * N + row;
+
+                if (row == col) {
+                  Out[Col] += D[row] * In[Row];
+                } else if (col < row) {
+                  int k = N * (N - 1) / 2 - (N - col) * (N - col - 1) / 2 + row - col - 1;
+                  Out[Col] += conj(L[k]) * In[Row];
+                } else if (row < col) {
+                  int k = N * (N - 1) / 2 - (N - row) * (N - row - 1) / 2 + col - row - 1;
+                  Out[Col] += L[k] * In[Row];
+                }
               }
             }
           }
         }
       }
     }
-  }
+  });
 }
 
 void apply_clover(void *out, void *clover, void *in, int parity, QudaPrecision precision)
@@ -12,82 +12,106 @@
 
 #include <dslash_reference.h>
 #include <string.h>
+#include <thread_pool.h>
 
 using namespace quda;
 
+// The spin projectors P^{projIdx} = (1 -/+ gamma_mu) in the DeGrand-Rossi basis, with projIdx = 2 * mu + sign.  The lower two spin components of P^{projIdx} in are multiples of the upper two, so we need only
+// transport the two-component half spinor and reconstruct the lower components afterwards.  Phases are encoded as
+// 0 -> +1, 1 -> -1, 2 -> +i, 3 -> -i.
+
+// projection: half spinor component h = in[h] + proj_phase * in[proj_spin]
 // clang-format off
-static const double projector[8][4][4][2] = {
-  {
-    {{1,0}, {0,0}, {0,0}, {0,-1}},
-    {{0,0}, {1,0}, {0,-1}, {0,0}},
-    {{0,0}, {0,1}, {1,0}, {0,0}},
-    {{0,1}, {0,0}, {0,0}, {1,0}}
-  },
-  {
-    {{1,0}, {0,0}, {0,0}, {0,1}},
-    {{0,0}, {1,0}, {0,1}, {0,0}},
-    {{0,0}, {0,-1}, {1,0}, {0,0}},
-    {{0,-1}, {0,0}, {0,0}, {1,0}}
-  },
-  {
-    {{1,0}, {0,0}, {0,0}, {1,0}},
-    {{0,0}, {1,0}, {-1,0}, {0,0}},
-    {{0,0}, {-1,0}, {1,0}, {0,0}},
-    {{1,0}, {0,0}, {0,0}, {1,0}}
-  },
-  {
-    {{1,0}, {0,0}, {0,0}, {-1,0}},
-    {{0,0}, {1,0}, {1,0}, {0,0}},
-    {{0,0}, {1,0}, {1,0}, {0,0}},
-    {{-1,0}, {0,0}, {0,0}, {1,0}}
-  },
-  {
-    {{1,0}, {0,0}, {0,-1}, {0,0}},
-    {{0,0}, {1,0}, {0,0}, {0,1}},
-    {{0,1}, {0,0}, {1,0}, {0,0}},
-    {{0,0}, {0,-1}, {0,0}, {1,0}}
-  },
-  {
-    {{1,0}, {0,0}, {0,1}, {0,0}},
-    {{0,0}, {1,0}, {0,0}, {0,-1}},
-    {{0,-1}, {0,0}, {1,0}, {0,0}},
-    {{0,0}, {0,1}, {0,0}, {1,0}}
-  },
-  {
-    {{1,0}, {0,0}, {-1,0}, {0,0}},
-    {{0,0}, {1,0}, {0,0}, {-1,0}},
-    {{-1,0}, {0,0}, {1,0}, {0,0}},
-    {{0,0}, {-1,0}, {0,0}, {1,0}}
-  },
-  {
-    {{1,0}, {0,0}, {1,0}, {0,0}},
-    {{0,0}, {1,0}, {0,0}, {1,0}},
-    {{1,0}, {0,0}, {1,0}, {0,0}},
-    {{0,0}, {1,0}, {0,0}, {1,0}}
-  }
-};
+static constexpr int proj_spin[8][2] = {{3, 2}, {3, 2}, {3, 2}, {3, 2}, {2, 3}, {2, 3}, {2, 3}, {2, 3}};
+static constexpr int proj_phase[8][2] = {{3, 3}, {2, 2}, {0, 1}, {1, 0}, {3, 2}, {2, 3}, {1, 1}, {0, 0}};
+
+// reconstruction: out[2 + s] = recon_phase * h[recon_spin]
+static constexpr int recon_spin[8][2] = {{1, 0}, {1, 0}, {1, 0}, {1, 0}, {0, 1}, {0, 1}, {0, 1}, {0, 1}};
+static constexpr int recon_phase[8][2] = {{2, 2}, {3, 3}, {1, 0}, {0, 1}, {2, 3}, {3, 2}, {1, 1}, {0, 0}};
 // clang-format on
 
-// todo pass projector
-template <typename Float> void multiplySpinorByDiracProjector(Float *res, int projIdx, const Float *spinorIn)
+/**
+   @brief Compute y = a + phase * b for a color vector
+   @param[out] y Output color vector
+   @param[in] a Input color vector
+   @param[in] b Input color vector multiplied by the phase
+ */
+template <int phase, typename Float> static inline void phaseAdd(Float *y, const Float *a, const Float *b)
 {
-  for (int i = 0; i < 4 * 3 * 2; i++) res[i] = 0.0;
-
-  for (int s = 0; s < 4; s++) {
-    for (int t = 0; t < 4; t++) {
-      Float projRe = projector[projIdx][s][t][0];
-      Float projIm = projector[projIdx][s][t][1];
-
-      for (int m = 0; m < 3; m++) {
-        Float spinorRe = spinorIn[t * (3 * 2) + m * (2) + 0];
-        Float spinorIm = spinorIn[t * (3 * 2) + m * (2) + 1];
-        res[s * (3 * 2) + m * (2) + 0] += projRe * spinorRe - projIm * spinorIm;
-        res[s * (3 * 2) + m * (2) + 1] += projRe * spinorIm + projIm * spinorRe;
-      }
+  for (int c = 0; c < 3; c++) {
+    const Float re = b[2 * c + 0];
+    const Float im = b[2 * c + 1];
+    switch (phase) {
+    case 0:
+      y[2 * c + 0] = a[2 * c + 0] + re;
+      y[2 * c + 1] = a[2 * c + 1] + im;
+      break;
+    case 1:
+      y[2 * c + 0] = a[2 * c + 0] - re;
+      y[2 * c + 1] = a[2 * c + 1] - im;
+      break;
+    case 2:
+      y[2 * c + 0] = a[2 * c + 0] - im;
+      y[2 * c + 1] = a[2 * c + 1] + re;
+      break;
+    case 3:
+      y[2 * c + 0] = a[2 * c + 0] + im;
+      y[2 * c + 1] = a[2 * c + 1] - re;
+      break;
     }
   }
 }
 
+/**
+   @brief Apply the hopping term in a given direction to a site:
+   project the neighboring spinor onto a half spinor, transport it
+   with the link and accumulate the reconstructed spinor into res.
+   @param[in,out] res Output spinor we are accumulating into
+   @param[in] dir Direction of hop (0-7)
+   @param[in] gauge Link for this hop
+   @param[in] spinor Neighboring spinor
+ */
+template <int projIdx, typename sFloat, typename gFloat>
+static inline void hop(sFloat *res, int dir, const gFloat *gauge, const sFloat *spinor)
+{
+  constexpr int color = 3 * 2;
+  sFloat projected[2 * color], gauged[2 * color];
+
+  phaseAdd<proj_phase[projIdx][0]>(&projected[0 * color], &spinor[0 * color], &spinor[proj_spin[projIdx][0] * color]);
+  phaseAdd<proj_phase[projIdx][1]>(&projected[1 * color], &spinor[1 * color], &spinor[proj_spin[projIdx][1] * color]);
+
+  for (int s = 0; s < 2; s++) {
+    if (dir % 2 == 0)
+      su3Mul(&gauged[s * color], gauge, &projected[s * color]);
+    else
+      su3Tmul(&gauged[s * color], gauge, &projected[s * color]);
+  }
+
+  phaseAdd<0>(&res[0 * color], &res[0 * color], &gauged[0 * color]);
+  phaseAdd<0>(&res[1 * color], &res[1 * color], &gauged[1 * color]);
+  phaseAdd<recon_phase[projIdx][0]>(&res[2 * color], &res[2 * color], &gauged[recon_spin[projIdx][0] * color]);
+  phaseAdd<recon_phase[projIdx][1]>(&res[3 * color], &res[3 * color], &gauged[recon_spin[projIdx][1] * color]);
+}
+
+/**
+   @brief Dispatch the hopping term to the instantiation with the
+   projector for this direction hard coded
+ */
+template <typename sFloat, typename gFloat>
+static inline void hop(sFloat *res, int dir, int daggerBit, const gFloat *gauge, const sFloat *spinor)
+{
+  switch (2 * (dir / 2) + (dir + daggerBit) % 2) {
+  case 0: hop<0>(res, dir, gauge, spinor); break;
+  case 1: hop<1>(res, dir, gauge, spinor); break;
+  case 2: hop<2>(res, dir, gauge, spinor); break;
+  case 3: hop<3>(res, dir, gauge, spinor); break;
+  case 4: hop<4>(res, dir, gauge, spinor); break;
+  case 5: hop<5>(res, dir, gauge, spinor); break;
+  case 6: hop<6>(res, dir, gauge, spinor); break;
+  case 7: hop<7>(res, dir, gauge, spinor); break;
+  }
+}
+
 //
 // dslashReference()
 //
@@ -103,33 +127,24 @@ template <typename Float> void multiplySpinorByDiracProjector(Float *res, int pr
 template <typename sFloat, typename gFloat>
 void dslashReference(sFloat *res, gFloat **gaugeFull, sFloat *spinorField, int oddBit, int daggerBit)
 {
-  for (auto i = 0lu; i < Vh * spinor_site_size; i++) res[i] = 0.0;
-
   gFloat *gaugeEven[4], *gaugeOdd[4];
   for (int dir = 0; dir < 4; dir++) {
     gaugeEven[dir] = gaugeFull[dir];
     gaugeOdd[dir] = gaugeFull[dir] + Vh * gauge_site_size;
   }
 
-  for (int i = 0; i < Vh; i++) {
-    for (int dir = 0; dir < 8; dir++) {
-      gFloat *gauge = gaugeLink(i, dir, oddBit, gaugeEven, gaugeOdd, 1);
-      const sFloat *spinor = spinorNeighbor(i, dir, oddBit, spinorField, 1);
+  host::parallel_for(Vh, {}, [&](int64_t begin, int64_t end) {
+    for (auto i = begin; i < end; i++) {
+      sFloat *out = &res[i * spinor_site_size];
+      for (auto j = 0lu; j < spinor_site_size; j++) out[j] = 0.0;
 
-      sFloat projectedSpinor[spinor_site_size], gaugedSpinor[spinor_site_size];
-      int projIdx = 2 * (dir / 2) + (dir + daggerBit) % 2;
-      multiplySpinorByDiracProjector(projectedSpinor, projIdx, spinor);
-
-      for (int s = 0; s < 4; s++) {
-        if (dir % 2 == 0)
-          su3Mul(&gaugedSpinor[s * (3 * 2)], gauge, &projectedSpinor[s * (3 * 2)]);
-        else
-          su3Tmul(&gaugedSpinor[s * (3 * 2)], gauge, &projectedSpinor[s * (3 * 2)]);
+      for (int dir = 0; dir < 8; dir++) {
+        const gFloat *gauge = gaugeLink(i, dir, oddBit, gaugeEven, gaugeOdd, 1);
+        const sFloat *spinor = spinorNeighbor(i, dir, oddBit, spinorField, 1);
+        hop(out, dir, daggerBit, gauge, spinor);
       }
-
-      sum(&res[i * spinor_site_size], &res[i * spinor_site_size], gaugedSpinor, spinor_site_size);
     }
-  }
+  });
 }
 
 #else
@@ -138,8 +153,6 @@ template <typename sFloat, typename gFloat>
 void dslashReference(sFloat *res, gFloat **gaugeFull, gFloat **ghostGauge, sFloat *spinorField, sFloat **fwdSpinor,
                      sFloat **backSpinor, int oddBit, int daggerBit)
 {
-  for (auto i = 0lu; i < Vh * spinor_site_size; i++) res[i] = 0.0;
-
   gFloat *gaugeEven[4], *gaugeOdd[4];
   gFloat *ghostGaugeEven[4], *ghostGaugeOdd[4];
   for (int dir = 0; dir < 4; dir++) {
@@ -150,26 +163,19 @@ void dslashReference(sFloat *res, gFloat **gaugeFull, gFloat **ghostGauge, sFloa
     ghostGaugeOdd[dir] = ghostGauge[dir] + (faceVolume[dir] / 2) * gauge_site_size;
   }
 
-  for (int i = 0; i < Vh; i++) {
+  host::parallel_for(Vh, {}, [&](int64_t begin, int64_t end) {
+    for (auto i = begin; i < end; i++) {
+      sFloat *out = &res[i * spinor_site_size];
+      for (auto j = 0lu; j < spinor_site_size; j++) out[j] = 0.0;
 
-    for (int dir = 0; dir < 8; dir++) {
-      gFloat *gauge = gaugeLink_mg4dir(i, dir, oddBit, gaugeEven, gaugeOdd, ghostGaugeEven, ghostGaugeOdd, 1, 1);
-      const sFloat *spinor = spinorNeighbor_mg4dir(i, dir, oddBit, spinorField, fwdSpinor, backSpinor, 1, 1);
-
-      sFloat projectedSpinor[spinor_site_size], gaugedSpinor[spinor_site_size];
-      int projIdx = 2 * (dir / 2) + (dir + daggerBit) % 2;
-      multiplySpinorByDiracProjector(projectedSpinor, projIdx, spinor);
-
-      for (int s = 0; s < 4; s++) {
-        if (dir % 2 == 0)
-          su3Mul(&gaugedSpinor[s * (3 * 2)], gauge, &projectedSpinor[s * (3 * 2)]);
-        else
-          su3Tmul(&gaugedSpinor[s * (3 * 2)], gauge, &projectedSpinor[s * (3 * 2)]);
+      for (int dir = 0; dir < 8; dir++) {
+        const gFloat *gauge
+          = gaugeLink_mg4dir(i, dir, oddBit, gaugeEven, gaugeOdd, ghostGaugeEven, ghostGaugeOdd, 1, 1);
+        const sFloat *spinor = spinorNeighbor_mg4dir(i, dir, oddBit, spinorField, fwdSpinor, backSpinor, 1, 1);
+        hop(out, dir, daggerBit, gauge, spinor);
       }
-
-      sum(&res[i * spinor_site_size], &res[i * spinor_site_size], gaugedSpinor, spinor_site_size);
     }
-  }
+  });
 }
 
 #endif
@@ -40,7 +40,7 @@ void display_test_info()
              dimPartitioned(3));
 }
 
-void initFields(QudaPrecision prec)
+void initFields(QudaPrecision prec, int n_src)
 {
   ColorSpinorParam param;
   param.nColor = Ncolor;
@@ -53,7 +53,7 @@ void initFields(QudaPrecision prec)
   param.x[1] = ydim;
   param.x[2] = zdim;
   param.x[3] = tdim;
-  param.x[4] = Nsrc;
+  param.x[4] = n_src;
   param.pc_type = QUDA_4D_PC;
 
   param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
@@ -109,6 +109,18 @@ void initFields(QudaPrecision prec)
   X_h = new cpuGaugeField(gParam);
   Xinv_h = new cpuGaugeField(gParam);
 
+  // random links, so that the host and device operators can be compared: each coarse link is a complex
+  // nColor x nColor matrix, which Reconstruct() (the QUDA_RECONSTRUCT_NO value) does not describe
+  for (auto U : {Y_h, Yhat_h, X_h, Xinv_h}) {
+    auto gauge = static_cast<void **>(U->Gauge_p());
+    const size_t link_reals = 2 * U->Ncolor() * U->Ncolor();
+    for (int d = 0; d < U->Geometry(); d++)
+      for (size_t i = 0; i < U->Volume() * link_reals; i++)
+        static_cast<double *>(gauge[d])[i] = rand() / (double)RAND_MAX - 0.5;
+  }
+  Y_h->exchangeGhost();
+  Yhat_h->exchangeGhost();
+
   gParam.order = QUDA_FLOAT2_GAUGE_ORDER;
   gParam.geometry = QUDA_COARSE_GEOMETRY;
   gParam.nFace = 1;
@@ -129,6 +141,8 @@ void initFields(QudaPrecision prec)
   Yhat_d = new cudaGaugeField(gParam);
   Y_d->copy(*Y_h);
   Yhat_d->copy(*Yhat_h);
+  Y_d->exchangeGhost();
+  Yhat_d->exchangeGhost();
 
   gParam.geometry = QUDA_SCALAR_GEOMETRY;
   gParam.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
@@ -159,26 +173,60 @@ void freeFields()
 
 DiracCoarse *dirac;
 
-double benchmark(int test, const int niter)
-{
-  device_timer_t device_timer;
-  device_timer.start();
+// location of the fields the benchmark is run on
+QudaFieldLocation bench_location = QUDA_CUDA_FIELD_LOCATION;
 
+/**
+   @brief Apply the operator of a given test, x = D y
+ */
+void apply(int test, ColorSpinorField &x, ColorSpinorField &y)
+{
   switch (test) {
-  case 0:
-    for (int i = 0; i < niter; ++i) dirac->Dslash(xD->Even(), yD->Odd(), QUDA_EVEN_PARITY);
-    break;
-  case 1:
-    for (int i = 0; i < niter; ++i) dirac->M(*xD, *yD);
-    break;
-  case 2:
-    for (int i = 0; i < niter; ++i) dirac->Clover(xD->Even(), yD->Even(), QUDA_EVEN_PARITY);
-    break;
+  case 0: dirac->Dslash(x.Even(), y.Odd(), QUDA_EVEN_PARITY); break;
+  case 1: dirac->M(x, y); break;
+  case 2: dirac->Clover(x.Even(), y.Even(), QUDA_EVEN_PARITY); break;
   default: errorQuda("Undefined test %d", test);
   }
+}
+
+double benchmark(int test, const int niter)
+{
+  // host-resident levels are run on the CPU fields and timed on the host
+  const bool host = bench_location == QUDA_CPU_FIELD_LOCATION;
+  ColorSpinorField &x = host ? *xH : *xD;
+  ColorSpinorField &y = host ? *yH : *yD;
 
-  device_timer.stop();
-  return device_timer.last();
+  device_timer_t device_timer;
+  host_timer_t host_timer;
+  host ? host_timer.start() : device_timer.start();
+
+  for (int i = 0; i < niter; ++i) apply(test, x, y);
+
+  host ? host_timer.stop() : device_timer.stop();
+  return host ? host_timer.last() : device_timer.last();
+}
+
+/**
+   @brief Apply the operator with the host engine and on the device
+   to the same random source, and return the norm of the difference
+   relative to the host result
+ */
+double verify(int test)
+{
+  double *v = static_cast<double *>(yH->V());
+  for (size_t i = 0; i < yH->Length(); i++) v[i] = rand() / (double)RAND_MAX - 0.5;
+  yD->copy(*yH);
+
+  blas::zero(*xH);
+  blas::zero(*xD);
+  apply(test, *xH, *yH);
+  apply(test, *xD, *yD);
+
+  ColorSpinorField x_device(*xH);
+  x_device.copy(*xD);
+  double norm = blas::norm2(*xH);
+  double residual = blas::xmyNorm(*xH, x_device);
+  return norm > 0.0 ? sqrt(residual / norm) : sqrt(residual);
 }
 
 const char *names[] = {"Dslash", "Mat", "Clover"};
@@ -196,6 +244,10 @@ int main(int argc, char **argv)
   add_multigrid_option_group(app);
   CLI::TransformPairs<int> test_type_map {{"Dslash", 0}, {"Mat", 1}, {"Clover", 2}};
   app->add_option("--test", test_type, "Test method")->transform(CLI::CheckedTransformer(test_type_map));
+  CLI::TransformPairs<QudaFieldLocation> location_map {{"cpu", QUDA_CPU_FIELD_LOCATION},
+                                                      {"cuda", QUDA_CUDA_FIELD_LOCATION}};
+  app->add_option("--location", bench_location, "Location of the coarse operator being benchmarked (default cuda)")
+    ->transform(CLI::CheckedTransformer(location_map));
 
   try {
     app->parse(argc, argv);
@@ -212,14 +264,37 @@ int main(int argc, char **argv)
 
   Nspin = 2;
 
-  printfQuda("\nBenchmarking %s precision with %d iterations...\n\n", get_prec_str(prec), niter);
+  printfQuda("\nBenchmarking %s precision on the %s with %d iterations...\n\n",
+             get_prec_str(bench_location == QUDA_CPU_FIELD_LOCATION ? QUDA_DOUBLE_PRECISION : prec),
+             bench_location == QUDA_CPU_FIELD_LOCATION ? "host" : "device", niter);
+  int failures = 0;
   for (int c = 24; c <= 32; c += 8) {
     Ncolor = c;
 
-    initFields(prec);
-
     DiracParam param;
     param.halo_precision = smoother_halo_prec;
+
+    // check the host engine against the device operator, with a single and with multiple right-hand sides
+    for (int n_src : {1, 3}) {
+      initFields(prec, n_src);
+      dirac = new DiracCoarse(param, Y_h, X_h, Xinv_h, Yhat_h, Y_d, X_d, Xinv_d, Yhat_d);
+
+      double residual = verify(test_type);
+      double tol = std::min(prec, prec_sloppy) == QUDA_DOUBLE_PRECISION ?
+        1e-10 :
+        (std::min(prec, prec_sloppy) == QUDA_SINGLE_PRECISION ? 1e-5 : 1e-2);
+      printfQuda("Ncolor = %2d, Nsrc = %d, %-23s: host vs device residual = %e (tolerance %e)\n", Ncolor, n_src,
+                 names[test_type], residual, tol);
+      if (!(residual < tol)) {
+        warningQuda("Host and device %s differ for Ncolor = %d, Nsrc = %d", names[test_type], Ncolor, n_src);
+        failures++;
+      }
+
+      delete dirac;
+      freeFields();
+    }
+
+    initFields(prec, Nsrc);
     dirac = new DiracCoarse(param, Y_h, X_h, Xinv_h, Yhat_h, Y_d, X_d, Xinv_d, Yhat_d);
 
     // do the initial tune
@@ -240,4 +315,6 @@ int main(int argc, char **argv)
   endQuda();
 
   finalizeComms();
+
+  return failures > 0 ? 1 : 0;
 }
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include <pool_allocator.h>
+
+#include <gtest/gtest.h>
+
+/*
+  Unit tests for the pool allocator that sits behind the device and
+  pinned memory pools.  The pool is backed here by plain host memory,
+  so these tests do not require a device.
+*/
+
+using quda::PoolAllocator;
+
+constexpr size_t MiB = 1 << 20;
+
+static void *host_malloc(const char *, const char *, int, size_t bytes)
+{
+  return aligned_alloc(PoolAllocator::alignment, bytes);
+}
+
+static void host_free(const char *, const char *, int, void *ptr) { free(ptr); }
+
+#define pool_malloc(pool, bytes) pool.allocate(__func__, __FILE__, __LINE__, bytes)
+#define pool_free(pool, ptr) pool.deallocate(__func__, __FILE__, __LINE__, ptr)
+
+TEST(pool_allocator, size_class)
+{
+  EXPECT_EQ(PoolAllocator::size_class(1), 256u);
+  EXPECT_EQ(PoolAllocator::size_class(256), 256u);
+  EXPECT_EQ(PoolAllocator::size_class(1000), 1024u);
+  EXPECT_EQ(PoolAllocator::size_class(1025), 1280u);
+  EXPECT_EQ(PoolAllocator::size_class(5000), 5120u);
+  EXPECT_EQ(PoolAllocator::size_class(MiB), MiB);
+  EXPECT_EQ(PoolAllocator::size_class(3 * MiB + 1), 3 * MiB + 256);
+}
+
+TEST(pool_allocator, small_reuse)
+{
+  PoolAllocator pool(host_malloc, host_free);
+
+  void *a = pool_malloc(pool, 1000);
+  EXPECT_EQ(pool.stats().live, 1000u);
+  EXPECT_EQ(pool.stats().wasted, 24u);
+  pool_free(pool, a);
+  EXPECT_EQ(pool.stats().live, 0u);
+  EXPECT_EQ(pool.stats().cached, 1024u);
+
+  // a request in the same size class reuses the cached block
+  void *b = pool_malloc(pool, 900);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(pool.stats().backend_allocs, 1u);
+  pool_free(pool, b);
+
+  pool.flush();
+  EXPECT_EQ(pool.stats().reserved, 0u);
+  EXPECT_EQ(pool.stats().backend_frees, 1u);
+}
+
+TEST(pool_allocator, split_and_coalesce)
+{
+  PoolAllocator pool(host_malloc, host_free);
+
+  char *arena = static_cast<char *>(pool_malloc(pool, 64 * MiB));
+  pool_free(pool, arena);
+  EXPECT_EQ(pool.stats().cached, 64 * MiB);
+
+  // smaller requests are carved from the cached arena
+  char *p[4];
+  for (int i = 0; i < 4; i++) {
+    p[i] = static_cast<char *>(pool_malloc(pool, 16 * MiB));
+    EXPECT_GE(p[i], arena);
+    EXPECT_LE(p[i] + 16 * MiB, arena + 64 * MiB);
+  }
+  EXPECT_EQ(pool.stats().backend_allocs, 1u);
+  EXPECT_EQ(pool.stats().cached, 0u);
+  EXPECT_EQ(pool.stats().wasted, 0u);
+
+  // neighboring free blocks are coalesced
+  pool_free(pool, p[1]);
+  pool_free(pool, p[2]);
+  char *q = static_cast<char *>(pool_malloc(pool, 32 * MiB));
+  EXPECT_EQ(q, std::min(p[1], p[2]));
+  EXPECT_EQ(pool.stats().backend_allocs, 1u);
+
+  pool_free(pool, q);
+  pool_free(pool, p[0]);
+  pool_free(pool, p[3]);
+  EXPECT_EQ(pool_malloc(pool, 64 * MiB), arena);
+  EXPECT_EQ(pool.stats().backend_allocs, 1u);
+  EXPECT_EQ(pool.stats().peak_reserved, 64 * MiB);
+  pool_free(pool, arena);
+}
+
+TEST(pool_allocator, unsplit_remainder)
+{
+  PoolAllocator pool(host_malloc, host_free);
+
+  // a remainder too small to be reused is handed out and counted as wasted
+  void *a = pool_malloc(pool, 4 * MiB);
+  pool_free(pool, a);
+  void *b = pool_malloc(pool, 3 * MiB + MiB / 2);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(pool.stats().wasted, MiB / 2);
+  EXPECT_EQ(pool.stats().live + pool.stats().wasted + pool.stats().cached, pool.stats().reserved);
+  pool_free(pool, b);
+}
+
+TEST(pool_allocator, grow)
+{
+  PoolAllocator pool(host_malloc, host_free);
+
+  // a free arena too small for the request is released before growing
+  void *a = pool_malloc(pool, 8 * MiB);
+  pool_free(pool, a);
+  void *b = pool_malloc(pool, 16 * MiB);
+  EXPECT_EQ(pool.stats().backend_allocs, 2u);
+  EXPECT_EQ(pool.stats().backend_frees, 1u);
+  EXPECT_EQ(pool.stats().reserved, 16 * MiB);
+  pool_free(pool, b);
+}
+
+TEST(pool_allocator, high_water)
+{
+  PoolAllocator pool(host_malloc, host_free, 24 * MiB);
+
+  void *a = pool_malloc(pool, 16 * MiB);
+  void *b = pool_malloc(pool, 16 * MiB);
+  EXPECT_EQ(pool.stats().reserved, 32 * MiB);
+
+  // cached memory above the high-water mark is released
+  pool_free(pool, a);
+  EXPECT_EQ(pool.stats().reserved, 16 * MiB);
+  EXPECT_EQ(pool.stats().cached, 0u);
+
+  pool_free(pool, b);
+  EXPECT_EQ(pool.stats().cached, 16 * MiB);
+
+  pool.set_high_water(0);
+  EXPECT_EQ(pool.stats().reserved, 0u);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <externals/json.hpp>
+
+/*
+  Compare two kernel profiles written by QUDA (profile_N.json in
+  QUDA_RESOURCE_PATH) and flag the kernels whose time per call
+  regressed by more than a threshold.  Kernels are matched by name,
+  volume and aux string.  The exit status is 1 if any regression was
+  found, so this can be used to gate upgrades on production workloads.
+
+  Usage: profile_diff [options] baseline.json current.json
+    --threshold <percent>  relative slowdown flagged as a regression (default 5)
+    --min-share <percent>  ignore kernels below this share of the baseline kernel time (default 0.1)
+    --all                  print every matched kernel, not only the regressions
+*/
+
+using json = nlohmann::json;
+
+using kernel_key_t = std::tuple<std::string, std::string, std::string>;
+
+struct kernel_t {
+  double time_per_call = 0.0;
+  double total_time = 0.0;
+  double gflops = 0.0;
+  double gbytes = 0.0;
+  long long calls = 0;
+  bool policy = false;
+};
+
+struct profile_t {
+  std::string label;
+  double total_time = 0.0;
+  std::map<kernel_key_t, kernel_t> kernels;
+};
+
+static profile_t load(const char *filename)
+{
+  std::ifstream in(filename);
+  if (!in) {
+    fprintf(stderr, "Unable to open %s\n", filename);
+    exit(2);
+  }
+
+  json j;
+  try {
+    in >> j;
+  } catch (const json::exception &e) {
+    fprintf(stderr, "Unable to parse %s: %s\n", filename, e.what());
+    exit(2);
+  }
+  if (j.value("schema", "") != "quda-kernel-profile") {
+    fprintf(stderr, "%s is not a QUDA kernel profile\n", filename);
+    exit(2);
+  }
+  if (j.value("version", 0) != 1) {
+    fprintf(stderr, "%s has unsupported profile version %d\n", filename, j.value("version", 0));
+    exit(2);
+  }
+
+  profile_t profile;
+  profile.label = j.value("label", "");
+  profile.total_time = j.value("total_kernel_time", 0.0);
+  for (auto &k : j["kernels"]) {
+    kernel_t kernel;
+    kernel.time_per_call = k.value("time_per_call", 0.0);
+    kernel.total_time = k.value("total_time", 0.0);
+    kernel.gflops = k.value("gflops", 0.0);
+    kernel.gbytes = k.value("gbytes", 0.0);
+    kernel.calls = k.value("calls", 0ll);
+    kernel.policy = k.value("policy", false);
+    profile.kernels[{k.value("name", ""), k.value("volume", ""), k.value("aux", "")}] = kernel;
+  }
+  return profile;
+}
+
+static void usage(const char *argv0)
+{
+  fprintf(stderr, "Usage: %s [--threshold percent] [--min-share percent] [--all] baseline.json current.json\n", argv0);
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  double threshold = 5.0;
+  double min_share = 0.1;
+  bool print_all = false;
+  std::vector<const char *> files;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+      threshold = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--min-share") == 0 && i + 1 < argc) {
+      min_share = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--all") == 0) {
+      print_all = true;
+    } else if (argv[i][0] == '-') {
+      usage(argv[0]);
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+  if (files.size() != 2) usage(argv[0]);
+
+  const profile_t base = load(files[0]);
+  const profile_t curr = load(files[1]);
+
+  struct row_t {
+    const kernel_key_t *key;
+    const kernel_t *base;
+    const kernel_t *curr;
+    double change; // relative change in time per call (percent)
+  };
+  std::vector<row_t> rows;
+  int n_missing = 0;
+
+  for (auto &b : base.kernels) {
+    if (b.second.policy) continue; // policies overlap the kernels they launch
+    if (base.total_time > 0 && 100 * b.second.total_time / base.total_time < min_share) continue;
+    auto c = curr.kernels.find(b.first);
+    if (c == curr.kernels.end()) {
+      n_missing++;
+      continue;
+    }
+    const double change = b.second.time_per_call > 0 ?
+      100 * (c->second.time_per_call - b.second.time_per_call) / b.second.time_per_call :
+      0.0;
+    rows.push_back({&b.first, &b.second, &c->second, change});
+  }
+
+  // order by the time lost (or gained) over the baseline number of calls
+  std::sort(rows.begin(), rows.end(), [](const row_t &a, const row_t &b) {
+    return (a.curr->time_per_call - a.base->time_per_call) * a.base->calls
+      > (b.curr->time_per_call - b.base->time_per_call) * b.base->calls;
+  });
+
+  int n_regressed = 0;
+  printf("%-10s %12s %12s %10s %10s  %s\n", "status", "base s/call", "curr s/call", "change %", "GFLOP/s",
+         "kernel (volume, aux)");
+  for (auto &r : rows) {
+    const bool regressed = r.change > threshold;
+    if (regressed) n_regressed++;
+    if (!regressed && !print_all) continue;
+    const char *status = regressed ? "REGRESSED" : (r.change < -threshold ? "improved" : "ok");
+    printf("%-10s %12.4e %12.4e %10.2f %10.2f  %s (%s, %s)\n", status, r.base->time_per_call, r.curr->time_per_call,
+           r.change, r.curr->gflops, std::get<0>(*r.key).c_str(), std::get<1>(*r.key).c_str(),
+           std::get<2>(*r.key).c_str());
+  }
+
+  int n_new = 0;
+  for (auto &c : curr.kernels)
+    if (!c.second.policy && base.kernels.find(c.first) == base.kernels.end()) n_new++;
+
+  printf("\n%lu kernels compared, %d regressed by more than %g%%, %d only in baseline, %d only in current\n",
+         rows.size(), n_regressed, threshold, n_missing, n_new);
+  printf("Total kernel time: baseline %.4e s, current %.4e s\n", base.total_time, curr.total_time);
+
+  return n_regressed > 0 ? 1 : 0;
+}
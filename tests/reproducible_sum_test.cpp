@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <reproducible_sum.h>
+
+#include <gtest/gtest.h>
+
+/*
+  Unit tests for the binned accumulator used for reproducible global
+  sums.  These run on the host only.  The exact reference sums are
+  formed from values on a fixed grid k * 2^-grid_exp, which can be
+  summed exactly as 128-bit integers and then rounded once.
+*/
+
+using quda::reproducible::accumulator_t;
+
+constexpr int grid_exp = 60;
+
+/**
+   @brief Return the correctly rounded double of an exact sum k * 2^-grid_exp
+ */
+static double exact_value(__int128 k) { return std::ldexp(static_cast<double>(k), -grid_exp); }
+
+/**
+   @brief Return a compensated (Neumaier) sum in long double, rounded to double
+ */
+static double compensated_sum(const std::vector<double> &x)
+{
+  long double sum = 0.0, c = 0.0;
+  for (auto v : x) {
+    long double t = sum + v;
+    c += std::fabs(sum) >= std::fabs(static_cast<long double>(v)) ? (sum - t) + v : (v - t) + sum;
+    sum = t;
+  }
+  return static_cast<double>(sum + c);
+}
+
+static double accumulate(const std::vector<double> &x)
+{
+  accumulator_t a;
+  for (auto v : x) a.add(v);
+  return a.value();
+}
+
+/**
+   @brief Return grid values of widely varying magnitude, together with their exact sum
+ */
+static std::vector<double> grid_values(size_t n, int max_bits, std::mt19937_64 &rng, __int128 &sum)
+{
+  std::uniform_int_distribution<int> bits(1, max_bits);
+  std::vector<double> x(n);
+  sum = 0;
+  for (auto &v : x) {
+    // at most 53 significant bits so that the value is a double on the grid
+    const int b = bits(rng);
+    __int128 k = static_cast<int64_t>(rng() >> 11) >> std::max(0, 53 - b);
+    if (b > 53) k <<= (b - 53);
+    if (rng() & 1) k = -k;
+    v = exact_value(k);
+    sum += k;
+  }
+  return x;
+}
+
+TEST(reproducible_sum, order_independence)
+{
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+  std::uniform_int_distribution<int> exponent(-200, 200);
+  std::vector<double> x(10000);
+  for (auto &v : x) v = std::ldexp(mantissa(rng), exponent(rng));
+
+  const double reference = accumulate(x);
+  for (int trial = 0; trial < 10; trial++) {
+    std::shuffle(x.begin(), x.end(), rng);
+    EXPECT_EQ(accumulate(x), reference);
+
+    // a reduction tree of random fan-in and grouping
+    std::vector<accumulator_t> partial;
+    for (size_t i = 0; i < x.size();) {
+      accumulator_t a;
+      for (size_t j = 0; j < 1 + rng() % 64 && i < x.size(); j++) a.add(x[i++]);
+      partial.push_back(a);
+    }
+    while (partial.size() > 1) {
+      std::shuffle(partial.begin(), partial.end(), rng);
+      partial[0].merge(partial.back());
+      partial.pop_back();
+    }
+    EXPECT_EQ(partial[0].value(), reference);
+  }
+}
+
+TEST(reproducible_sum, exact)
+{
+  std::mt19937_64 rng(5678);
+  for (int trial = 0; trial < 100; trial++) {
+    __int128 sum;
+    auto x = grid_values(1000, 64, rng, sum);
+    EXPECT_EQ(accumulate(x), exact_value(sum));
+    EXPECT_EQ(accumulate(x), compensated_sum(x));
+  }
+}
+
+TEST(reproducible_sum, cancellation)
+{
+  std::mt19937_64 rng(9012);
+  for (int trial = 0; trial < 100; trial++) {
+    // large values that cancel exactly, leaving only the small ones
+    __int128 small_sum, large_sum;
+    auto small = grid_values(100, 20, rng, small_sum);
+    auto large = grid_values(100, 64, rng, large_sum);
+    std::vector<double> x(small);
+    for (auto v : large) {
+      x.push_back(v);
+      x.push_back(-v);
+    }
+    std::shuffle(x.begin(), x.end(), rng);
+    EXPECT_EQ(accumulate(x), exact_value(small_sum));
+  }
+
+  // catastrophic cancellation that a naive sum gets wrong
+  std::vector<double> x = {0x1p90, 1.0, -0x1p90, 0x1p-20};
+  EXPECT_EQ(accumulate(x), 1.0 + 0x1p-20);
+  x = {0x1p60, 1.0, -0x1p60, -0x1p-40};
+  EXPECT_EQ(accumulate(x), 1.0 - 0x1p-40);
+
+  // the sum of digits of opposite sign is rounded once, from the normalized magnitude
+  x = {0x1p52, -0x1p-60};
+  EXPECT_EQ(accumulate(x), compensated_sum(x));
+  x = {-0x1p52, 0x1p-60, 0x1p-100};
+  EXPECT_EQ(accumulate(x), compensated_sum(x));
+}
+
+TEST(reproducible_sum, many_bins)
+{
+  // contributions spanning more bins than are retained: the window follows the largest
+  // contribution, so the sum is exact down to 2^-(32 * n_bin) relative to it
+  std::mt19937_64 rng(3456);
+  for (int trial = 0; trial < 100; trial++) {
+    __int128 sum;
+    auto x = grid_values(1000, 72, rng, sum);
+    // increasing magnitude, so the window shifts up repeatedly as the sum progresses
+    std::sort(x.begin(), x.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
+    EXPECT_EQ(accumulate(x), exact_value(sum));
+  }
+
+  // many additions of the same value into the same bins
+  const int n = 1 << 20;
+  accumulator_t a;
+  for (int i = 0; i < n; i++) a.add(0.1);
+  EXPECT_EQ(a.value(), 0.1 * n); // exact, since n is a power of two
+
+  // values far below the window of the largest contribution are dropped, consistently
+  accumulator_t b;
+  b.add(0x1p200);
+  b.add(0x1p-200);
+  accumulator_t c;
+  c.add(0x1p-200);
+  c.add(0x1p200);
+  EXPECT_EQ(b.value(), 0x1p200);
+  EXPECT_EQ(c.value(), b.value());
+}
+
+TEST(reproducible_sum, special)
+{
+  EXPECT_EQ(accumulator_t().value(), 0.0);
+  EXPECT_EQ(accumulate({1.0, INFINITY, 2.0}), INFINITY);
+  EXPECT_TRUE(std::isnan(accumulate({INFINITY, -INFINITY})));
+  EXPECT_EQ(accumulate({0x1p-1074, 0x1p-1074}), 0x1p-1073); // subnormals
+  EXPECT_EQ(accumulate({DBL_MAX, -DBL_MAX, DBL_MAX}), DBL_MAX);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
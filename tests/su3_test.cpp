@@ -22,6 +22,7 @@
 double gauge_smear_rho = 0.1;
 double gauge_smear_epsilon = 0.1;
 double gauge_smear_alpha = 0.6;
+double gauge_flow_tol = 0.0;
 int gauge_smear_steps = 50;
 QudaGaugeSmearType gauge_smear_type = QUDA_GAUGE_SMEAR_STOUT;
 int measurement_interval = 5;
@@ -46,7 +47,10 @@ void display_test_info()
     printfQuda(" - epsilon %f\n", gauge_smear_epsilon);
     break;
   case QUDA_GAUGE_SMEAR_WILSON_FLOW:
-  case QUDA_GAUGE_SMEAR_SYMANZIK_FLOW: printfQuda(" - epsilon %f\n", gauge_smear_epsilon); break;
+  case QUDA_GAUGE_SMEAR_SYMANZIK_FLOW:
+    printfQuda(" - epsilon %f\n", gauge_smear_epsilon);
+    if (gauge_flow_tol > 0.0) printfQuda(" - adaptive step size tolerance %e\n", gauge_flow_tol);
+    break;
   default: errorQuda("Undefined test type %d given", test_type);
   }
   printfQuda(" - smearing steps %d\n", gauge_smear_steps);
@@ -85,6 +89,10 @@ void add_su3_option_group(std::shared_ptr<QUDAApp> quda_app)
 
   opgroup->add_option("--su3-smear-steps", gauge_smear_steps, "The number of smearing steps to perform (default 50)");
 
+  opgroup->add_option("--su3-flow-tol", gauge_flow_tol,
+                      "Integrate the Wilson/Symanzik flow with an adaptive step size at this local error tolerance, "
+                      "starting from epsilon (default 0 = fixed step size)");
+
   opgroup->add_option("--su3-measurement-interval", measurement_interval,
                       "Measure the field energy and/or topological charge every Nth step (default 5) ");
 
@@ -251,6 +259,7 @@ int main(int argc, char **argv)
   smear_param.alpha = gauge_smear_alpha;
   smear_param.rho = gauge_smear_rho;
   smear_param.epsilon = gauge_smear_epsilon;
+  smear_param.adaptive_tol = gauge_flow_tol;
 
   host_timer.start(); // start the timer
   switch (smear_param.smear_type) {
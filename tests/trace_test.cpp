@@ -0,0 +1,157 @@
+#include <cstdlib>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include <quda.h>
+#include <timer.h>
+#include <comm_quda.h>
+#include <host_utils.h>
+
+#include <gtest/gtest.h>
+
+/*
+  Tests for the hierarchical profile trace.  The trace is enabled in
+  both summary and event mode, and written to a temporary directory,
+  from which the files are read back and checked.
+*/
+
+using namespace quda;
+
+static std::string trace_dir;
+
+static std::string trace_path(const std::string &prefix)
+{
+  return trace_dir + "/" + prefix + "_rank" + std::to_string(comm_rank()) + ".json";
+}
+
+static std::string read_file(const std::string &prefix)
+{
+  std::ifstream in(trace_path(prefix));
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+/**
+   @brief Return the count recorded in the summary for a given scope path, or -1 if absent
+ */
+static long scope_count(const std::string &summary, const std::string &path)
+{
+  std::smatch match;
+  std::regex re("\\{\"path\": \"" + path + "\", \"count\": ([0-9]+),");
+  return std::regex_search(summary, match, re) ? std::stol(match[1]) : -1;
+}
+
+/**
+   @brief Start each test from an empty trace, with no files left by a
+   previous test, so that the tests do not depend on their order
+ */
+class TraceTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    trace::reset();
+    for (auto prefix : {"trace", "trace_summary"}) remove(trace_path(prefix).c_str());
+  }
+};
+
+TEST_F(TraceTest, nesting)
+{
+  ASSERT_TRUE(trace::enabled());
+
+  const int outer = 0, inner = 0;
+  for (int i = 0; i < 3; i++) {
+    trace::push(&outer, "outer");
+    trace::push(&inner, "inner");
+    trace::pop(&inner);
+    trace::pop(&outer);
+  }
+  {
+    trace_scope_t scope("scoped");
+  }
+  trace::save();
+
+  auto summary = read_file("trace_summary");
+  EXPECT_EQ(scope_count(summary, "outer"), 3);
+  EXPECT_EQ(scope_count(summary, "outer/inner"), 3);
+  EXPECT_EQ(scope_count(summary, "scoped"), 1);
+  EXPECT_EQ(scope_count(summary, "inner"), -1); // inner is only ever nested
+}
+
+TEST_F(TraceTest, fixed_precision)
+{
+  const int key = 0;
+  for (int i = 0; i < 4; i++) {
+    trace::push(&key, "event");
+    trace::pop(&key);
+  }
+  trace::save();
+
+  // every timestamp and duration is written in fixed notation with 3 decimals (ns resolution)
+  auto events = read_file("trace");
+  std::regex ts_re("\"ts\": ([^,]+), \"dur\": ([^}]+)\\}");
+  std::regex fixed_re("[0-9]+\\.[0-9]{3}");
+  int n_event = 0;
+  for (auto it = std::sregex_iterator(events.begin(), events.end(), ts_re); it != std::sregex_iterator(); it++) {
+    EXPECT_TRUE(std::regex_match((*it)[1].str(), fixed_re)) << (*it)[1].str();
+    EXPECT_TRUE(std::regex_match((*it)[2].str(), fixed_re)) << (*it)[2].str();
+    n_event++;
+  }
+  EXPECT_EQ(n_event, 4);
+
+  auto summary = read_file("trace_summary");
+  EXPECT_NE(summary.find("\"time_unit\": \"us\""), std::string::npos);
+  std::regex total_re("\"total\": ([^,]+),");
+  std::smatch match;
+  ASSERT_TRUE(std::regex_search(summary, match, total_re));
+  EXPECT_TRUE(std::regex_match(match[1].str(), fixed_re)) << match[1].str();
+}
+
+TEST_F(TraceTest, reset)
+{
+  const int key = 0;
+  trace::push(&key, "discarded");
+  trace::pop(&key);
+  trace::reset();
+
+  // a scope that is open across a reset is not recorded
+  trace::push(&key, "open");
+  trace::reset();
+  trace::pop(&key);
+
+  trace::push(&key, "kept");
+  trace::pop(&key);
+  trace::save();
+
+  auto summary = read_file("trace_summary");
+  EXPECT_EQ(scope_count(summary, "discarded"), -1);
+  EXPECT_EQ(scope_count(summary, "open"), -1);
+  EXPECT_EQ(scope_count(summary, "kept"), 1);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // the trace mode is read once, so must be set before any tracing
+  char dir_template[] = "/tmp/quda_trace_test.XXXXXX";
+  if (!mkdtemp(dir_template)) {
+    fprintf(stderr, "Unable to create temporary directory\n");
+    return 1;
+  }
+  trace_dir = dir_template;
+  setenv("QUDA_PROFILE_TRACE", "all", 1);
+  setenv("QUDA_PROFILE_TRACE_PATH", trace_dir.c_str(), 1);
+
+  int grid[4] = {1, 1, 1, 1};
+  initComms(argc, argv, grid);
+  int result = RUN_ALL_TESTS();
+  for (auto prefix : {"trace", "trace_summary"}) remove(trace_path(prefix).c_str());
+  rmdir(trace_dir.c_str());
+  finalizeComms();
+  return result;
+}
@@ -655,7 +655,10 @@ void add_eigen_option_group(std::shared_ptr<QUDAApp> quda_app)
   auto opgroup = quda_app->add_option_group("Eigensolver", "Options controlling eigensolver");
 
   opgroup->add_option("--eig-amax", eig_amax, "The maximum in the polynomial acceleration")->check(CLI::PositiveNumber);
-  opgroup->add_option("--eig-amin", eig_amin, "The minimum in the polynomial acceleration")->check(CLI::PositiveNumber);
+  opgroup
+    ->add_option("--eig-amin", eig_amin,
+                 "The minimum in the polynomial acceleration (0 = estimate the point below which n_ev eigenvalues lie)")
+    ->check(CLI::Range(0.0, std::numeric_limits<double>::max()));
 
   opgroup->add_option("--eig-ARPACK-logfile", eig_arpack_logfile, "The filename storing the log from arpack");
   opgroup->add_option("--eig-arpack-check", eig_arpack_check,